@@ -0,0 +1,72 @@
+// Spawns a burst of short-lived actors from a single actor, i.e., all new
+// jobs land on one worker and the others must steal them. Measures the time
+// until all actors reported back to the main thread.
+// Run with --caf#work-stealing.steal-half=true to enable batch stealing.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using hrc = std::chrono::high_resolution_clock;
+
+class config : public actor_system_config {
+public:
+  size_t jobs = 1000000;
+  size_t work = 1000;
+  size_t iterations = 5;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(jobs, "jobs,j", "set number of spawned actors per run")
+    .add(work, "work,w", "set number of loop iterations per actor")
+    .add(iterations, "iterations,i", "set number of runs");
+  }
+};
+
+// burns some CPU cycles before reporting to `sink`
+void job(event_based_actor* self, size_t work, actor sink) {
+  volatile uint64_t x = 0;
+  for (size_t i = 0; i < work; ++i)
+    x = x + i;
+  self->send(sink, uint64_t{x});
+}
+
+void spawner(event_based_actor* self, size_t jobs, size_t work, actor sink) {
+  for (size_t i = 0; i < jobs; ++i)
+    self->spawn(job, work, sink);
+}
+
+void caf_main(actor_system& system, const config& cfg) {
+  cout << "policy: " << to_string(cfg.scheduler_policy)
+       << ", workers: " << cfg.scheduler_max_threads
+       << ", steal-half: " << cfg.work_stealing_steal_half
+       << ", jobs: " << cfg.jobs
+       << ", work: " << cfg.work << endl;
+  scoped_actor self{system};
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    auto t0 = hrc::now();
+    self->spawn(spawner, cfg.jobs, cfg.work, self);
+    size_t received = 0;
+    self->receive_for(received, cfg.jobs)(
+      [](uint64_t) {
+        // nop
+      }
+    );
+    auto t1 = hrc::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+    cout << "run " << i << ": " << ms.count() << " ms" << endl;
+  }
+}
+
+} // namespace <anonymous>
+
+CAF_MAIN()
@@ -0,0 +1,89 @@
+// Spawns a tree of actors with configurable fan-out and depth. Each leaf
+// replies to its parent, each inner node aggregates the replies of its
+// children. Measures the time until the root received all replies.
+// Run with --caf#scheduler.policy=lf-steal to compare the scheduling policies.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using hrc = std::chrono::high_resolution_clock;
+
+using spread_atom = atom_constant<atom("spread")>;
+
+class config : public actor_system_config {
+public:
+  size_t fanout = 10;
+  size_t depth = 5;
+  size_t iterations = 5;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(fanout, "fanout,f", "set number of children per node")
+    .add(depth, "depth,d", "set depth of the actor tree")
+    .add(iterations, "iterations,i", "set number of runs");
+  }
+};
+
+behavior node(event_based_actor* self, size_t fanout) {
+  return {
+    [=](spread_atom, size_t depth) -> result<uint64_t> {
+      if (depth == 0) {
+        self->quit();
+        return uint64_t{1};
+      }
+      auto rp = self->make_response_promise<uint64_t>();
+      auto pending = std::make_shared<size_t>(fanout);
+      auto sum = std::make_shared<uint64_t>(1);
+      for (size_t i = 0; i < fanout; ++i) {
+        auto child = self->spawn(node, fanout);
+        self->request(child, infinite, spread_atom::value, depth - 1).then(
+          [=](uint64_t x) mutable {
+            *sum += x;
+            if (--*pending == 0) {
+              rp.deliver(*sum);
+              self->quit();
+            }
+          }
+        );
+      }
+      return rp;
+    }
+  };
+}
+
+void caf_main(actor_system& system, const config& cfg) {
+  cout << "policy: " << to_string(cfg.scheduler_policy)
+       << ", workers: " << cfg.scheduler_max_threads
+       << ", fanout: " << cfg.fanout
+       << ", depth: " << cfg.depth << endl;
+  scoped_actor self{system};
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    auto t0 = hrc::now();
+    auto root = self->spawn(node, cfg.fanout);
+    self->request(root, infinite, spread_atom::value, cfg.depth).receive(
+      [&](uint64_t num_actors) {
+        auto t1 = hrc::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+        cout << "run " << i << ": " << num_actors << " actors in "
+             << ms.count() << " ms" << endl;
+      },
+      [&](error& err) {
+        cout << "error: " << system.render(err) << endl;
+      }
+    );
+  }
+}
+
+} // namespace <anonymous>
+
+CAF_MAIN()
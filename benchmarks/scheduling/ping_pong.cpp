@@ -0,0 +1,93 @@
+// Lets pairs of actors exchange a message back and forth and measures the
+// average round-trip time. Each round trip wakes up the idle partner twice,
+// i.e., this benchmark stresses the latency of internal_enqueue/dequeue.
+// Run with --caf#work-stealing.run-next-limit=0 to disable the run-next slot.
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using hrc = std::chrono::high_resolution_clock;
+
+using ping_atom = atom_constant<atom("ping")>;
+using pong_atom = atom_constant<atom("pong")>;
+
+class config : public actor_system_config {
+public:
+  size_t pairs = 1;
+  size_t rounds = 100000;
+  size_t iterations = 5;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(pairs, "pairs,p", "set number of concurrent ping-pong pairs")
+    .add(rounds, "rounds,r", "set number of round trips per pair")
+    .add(iterations, "iterations,i", "set number of runs");
+  }
+};
+
+behavior pong(event_based_actor* self) {
+  return {
+    [=](ping_atom, uint64_t x) {
+      return std::make_tuple(pong_atom::value, x);
+    }
+  };
+}
+
+// sends `rounds` pings to `buddy` one after another, then reports to `sink`
+behavior ping(event_based_actor* self, actor buddy, uint64_t rounds,
+              actor sink) {
+  self->send(buddy, ping_atom::value, uint64_t{1});
+  return {
+    [=](pong_atom, uint64_t x) {
+      if (x == rounds) {
+        self->send(sink, x);
+        self->send_exit(buddy, exit_reason::user_shutdown);
+        self->quit();
+        return;
+      }
+      self->send(buddy, ping_atom::value, x + 1);
+    }
+  };
+}
+
+void caf_main(actor_system& system, const config& cfg) {
+  cout << "policy: " << to_string(cfg.scheduler_policy)
+       << ", workers: " << cfg.scheduler_max_threads
+       << ", run-next-limit: " << cfg.work_stealing_run_next_limit
+       << ", pairs: " << cfg.pairs
+       << ", rounds: " << cfg.rounds << endl;
+  scoped_actor self{system};
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    auto t0 = hrc::now();
+    for (size_t j = 0; j < cfg.pairs; ++j)
+      self->spawn(ping, self->spawn(pong), uint64_t{cfg.rounds}, self);
+    size_t received = 0;
+    self->receive_for(received, cfg.pairs)(
+      [](uint64_t) {
+        // nop
+      }
+    );
+    auto t1 = hrc::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+    cout << "run " << i << ": "
+         << ns.count() / static_cast<int64_t>(cfg.pairs * cfg.rounds)
+         << " ns per round trip, "
+         << std::chrono::duration_cast<std::chrono::milliseconds>(ns).count()
+         << " ms total" << endl;
+  }
+}
+
+} // namespace <anonymous>
+
+CAF_MAIN()
@@ -0,0 +1,120 @@
+// Stashes a large number of messages in the cache of an actor while the
+// actor awaits a single reply and keeps processing other messages. Each
+// processed message makes the actor check its cache for messages it can
+// process now. Measures the time until the actor processed all messages.
+
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using steady = std::chrono::steady_clock;
+
+using ping_atom = atom_constant<atom("ping")>;
+using pong_atom = atom_constant<atom("pong")>;
+using tick_atom = atom_constant<atom("tick")>;
+using stash_atom = atom_constant<atom("stash")>;
+using go_atom = atom_constant<atom("go")>;
+
+class config : public actor_system_config {
+public:
+  size_t stashed = 100000;
+  size_t ticks = 10000;
+  size_t iterations = 3;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(stashed, "stashed,s", "set number of stashed messages per run")
+    .add(ticks, "ticks,t", "set number of messages processed while waiting")
+    .add(iterations, "iterations,i", "set number of runs");
+  }
+};
+
+// replies to the first ping only after receiving `go_atom`
+behavior server(event_based_actor* self) {
+  struct state {
+    response_promise rp;
+    bool pending = false;
+    bool go = false;
+  };
+  auto st = std::make_shared<state>();
+  auto try_reply = [=] {
+    if (st->pending && st->go)
+      st->rp.deliver(pong_atom::value);
+  };
+  return {
+    [=](ping_atom) {
+      st->rp = self->make_response_promise();
+      st->pending = true;
+      try_reply();
+    },
+    [=](go_atom) {
+      st->go = true;
+      try_reply();
+    }
+  };
+}
+
+// processes ticks while waiting for the server and handles all stashed
+// messages only after receiving its reply, note that the cache index
+// distinguishes messages by type rather than by atom value
+behavior worker(event_based_actor* self, actor srv, actor sink, size_t n) {
+  self->set_default_handler(skip);
+  auto remaining = std::make_shared<size_t>(n);
+  self->request(srv, infinite, ping_atom::value).then(
+    [=](pong_atom) {
+      self->become(
+        [=](stash_atom, size_t) {
+          if (--*remaining == 0) {
+            self->send(sink, ok_atom::value);
+            self->quit();
+          }
+        }
+      );
+    }
+  );
+  return {
+    [=](tick_atom) {
+      // nop
+    }
+  };
+}
+
+void caf_main(actor_system& system, const config& cfg) {
+  cout << "stashed: " << cfg.stashed << ", ticks: " << cfg.ticks << endl;
+  scoped_actor self{system};
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    auto t0 = steady::now();
+    auto srv = system.spawn(server);
+    auto w = system.spawn(worker, srv, self, cfg.stashed);
+    for (size_t j = 0; j < cfg.stashed; ++j)
+      self->send(w, stash_atom::value, j);
+    for (size_t j = 0; j < cfg.ticks; ++j)
+      self->send(w, tick_atom::value);
+    self->send(srv, go_atom::value);
+    self->receive(
+      [](ok_atom) {
+        // nop
+      }
+    );
+    auto t1 = steady::now();
+    self->send_exit(srv, exit_reason::user_shutdown);
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    cout << "run " << i << ": " << duration_cast<milliseconds>(t1 - t0).count()
+         << " ms" << endl;
+  }
+}
+
+} // namespace <anonymous>
+
+CAF_MAIN()
@@ -0,0 +1,110 @@
+// Schedules a large number of concurrent timeouts via `delayed_send` from
+// several actors, with delays spread evenly over an interval. Measures how
+// long scheduling all timeouts takes, the time until all timeouts fired and
+// how late messages arrive compared to their deadline.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using steady = std::chrono::steady_clock;
+
+using fire_atom = atom_constant<atom("fire")>;
+
+class config : public actor_system_config {
+public:
+  size_t timeouts = 1000000;
+  size_t senders = 10;
+  size_t max_delay = 1000;
+  size_t iterations = 3;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(timeouts, "timeouts,t", "set number of concurrent timeouts per run")
+    .add(senders, "senders,s", "set number of actors scheduling timeouts")
+    .add(max_delay, "max-delay,d", "set the maximum delay in ms")
+    .add(iterations, "iterations,i", "set number of runs");
+  }
+};
+
+int64_t now_us() {
+  auto t = steady::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(t).count();
+}
+
+// schedules `n` timeouts to itself and reports the max. and total lateness
+behavior sender(event_based_actor* self, size_t n, size_t max_delay,
+                actor sink) {
+  for (size_t i = 0; i < n; ++i) {
+    auto delay = std::chrono::microseconds((max_delay * 1000 * i) / n);
+    self->delayed_send(self, delay, fire_atom::value, now_us() + delay.count());
+  }
+  self->send(sink, ok_atom::value);
+  struct state {
+    size_t remaining;
+    int64_t max_late;
+    int64_t total_late;
+  };
+  auto st = std::make_shared<state>(state{n, 0, 0});
+  return {
+    [=](fire_atom, int64_t deadline) {
+      auto late = now_us() - deadline;
+      st->max_late = std::max(st->max_late, late);
+      st->total_late += late;
+      if (--st->remaining == 0) {
+        self->send(sink, st->max_late, st->total_late);
+        self->quit();
+      }
+    }
+  };
+}
+
+void caf_main(actor_system& system, const config& cfg) {
+  cout << "timeouts: " << cfg.timeouts << ", senders: " << cfg.senders
+       << ", max-delay: " << cfg.max_delay << " ms" << endl;
+  scoped_actor self{system};
+  auto n = cfg.timeouts / cfg.senders;
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    auto t0 = steady::now();
+    for (size_t j = 0; j < cfg.senders; ++j)
+      self->spawn(sender, n, cfg.max_delay, self);
+    size_t received = 0;
+    self->receive_for(received, cfg.senders)(
+      [](ok_atom) {
+        // nop
+      }
+    );
+    auto t1 = steady::now();
+    int64_t max_late = 0;
+    int64_t total_late = 0;
+    received = 0;
+    self->receive_for(received, cfg.senders)(
+      [&](int64_t x, int64_t y) {
+        max_late = std::max(max_late, x);
+        total_late += y;
+      }
+    );
+    auto t2 = steady::now();
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    cout << "run " << i << ": schedule "
+         << duration_cast<milliseconds>(t1 - t0).count() << " ms, total "
+         << duration_cast<milliseconds>(t2 - t0).count() << " ms, lateness avg "
+         << (total_late / static_cast<int64_t>(n * cfg.senders)) / 1000
+         << " ms, max " << max_late / 1000 << " ms" << endl;
+  }
+}
+
+} // namespace <anonymous>
+
+CAF_MAIN()
@@ -0,0 +1,80 @@
+// Spawns short-lived actors that terminate after receiving a single message
+// and measures spawn and teardown throughput. Run with --bulk to spawn all
+// actors of a run via `spawn_n`.
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using hrc = std::chrono::high_resolution_clock;
+
+using close_atom = atom_constant<atom("close")>;
+
+class config : public actor_system_config {
+public:
+  size_t actors = 200000;
+  size_t iterations = 5;
+  bool bulk = false;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(actors, "actors,a", "set number of spawned actors per run")
+    .add(iterations, "iterations,i", "set number of runs")
+    .add(bulk, "bulk,b", "spawn all actors of a run via spawn_n");
+  }
+};
+
+// emulates a session actor that lives for a single request
+class session : public event_based_actor {
+public:
+  session(actor_config& cfg) : event_based_actor(cfg) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return {
+      [=](close_atom) {
+        quit();
+      }
+    };
+  }
+};
+
+void caf_main(actor_system& system, const config& cfg) {
+  cout << "actors: " << cfg.actors << ", bulk: " << cfg.bulk << endl;
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    auto t0 = hrc::now();
+    { // lifetime scope of sessions
+      std::vector<actor> sessions;
+      if (cfg.bulk) {
+        sessions = system.spawn_n<session>(cfg.actors);
+      } else {
+        sessions.reserve(cfg.actors);
+        for (size_t j = 0; j < cfg.actors; ++j)
+          sessions.push_back(system.spawn<session>());
+      }
+      for (auto& x : sessions)
+        anon_send(x, close_atom::value);
+    }
+    system.await_all_actors_done();
+    auto t1 = hrc::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+    cout << "run " << i << ": " << us.count() / 1000 << " ms, "
+         << (cfg.actors * 1000000 / static_cast<size_t>(us.count() + 1))
+         << " actors/s" << endl;
+  }
+}
+
+} // namespace <anonymous>
+
+CAF_MAIN()
@@ -77,6 +77,27 @@ public:
   /// This `enqueue` variant allows to define forwarding chains.
   virtual void enqueue(mailbox_element_ptr what, execution_unit* host) = 0;
 
+  /// Enqueues `what` to the actor like `enqueue`. An actor that `what`
+  /// unblocks appends itself to `wakeups` instead of scheduling itself if
+  /// it runs in the default scheduler, whereas the caller adds all actors in
+  /// `wakeups` to the scheduler at once. The default implementation calls
+  /// `enqueue`.
+  virtual void enqueue_deferred(mailbox_element_ptr what,
+                                execution_unit* host,
+                                std::vector<resumable*>& wakeups);
+
+  /// Enqueues all elements in `xs` to the actor in order. Actors with a
+  /// local mailbox deliver the batch with a single atomic operation and get
+  /// scheduled at most once. The default implementation calls `enqueue`
+  /// for each element.
+  virtual void enqueue_batch(std::vector<mailbox_element_ptr> xs,
+                             execution_unit* host);
+
+  /// Enqueues all messages in `xs` to the actor in order, using `sender`
+  /// and `mid` for each message.
+  void enqueue_batch(strong_actor_ptr sender, message_id mid,
+                     std::vector<message> xs, execution_unit* host);
+
   /// Attaches `ptr` to this actor. The actor will call `ptr->detach(...)` on
   /// exit, or immediately if it already finished execution.
   virtual void attach(attachable_ptr ptr) = 0;
@@ -152,6 +173,8 @@ public:
   static constexpr int has_used_aout_flag     = 0x0400; // local_actor
   static constexpr int is_terminated_flag     = 0x0800; // local_actor
   static constexpr int is_cleaned_up_flag     = 0x1000; // monitorable_actor
+  static constexpr int is_pooled_flag         = 0x2000; // scheduled_actor
+  static constexpr int has_arena_flag         = 0x4000; // stateful_actor
 
   inline void setf(int flag) {
     auto x = flags();
@@ -24,11 +24,19 @@
 #include <functional>
 
 #include "caf/fwd.hpp"
+#include "caf/optional.hpp"
 #include "caf/input_range.hpp"
+#include "caf/overflow_policy.hpp"
 #include "caf/abstract_channel.hpp"
 
 namespace caf {
 
+/// Maps message content to a conflation key. Messages with the same key
+/// replace each other while waiting in the mailbox, whereas returning
+/// `none` exempts a message from conflation.
+using conflation_key_fun =
+  std::function<optional<uint64_t> (const type_erased_tuple&)>;
+
 /// Stores spawn-time flags and groups.
 class actor_config {
 public:
@@ -36,6 +44,18 @@ public:
   int flags;
   input_range<const group>* groups;
   std::function<behavior (local_actor*)> init_fun;
+  /// Scheduler partition for running the actor, `nullptr` selects the
+  /// default scheduler. Ignored for detached and blocking actors.
+  scheduler::abstract_coordinator* partition;
+  /// Maximum number of messages in the mailbox, 0 means unbounded.
+  size_t mailbox_capacity;
+  /// Selects how a bounded mailbox handles messages beyond its capacity.
+  overflow_policy mailbox_overflow;
+  /// Selects the conflation key for incoming messages, an empty function
+  /// disables conflation.
+  conflation_key_fun conflation_key;
+  /// Maximum number of distinct conflation keys.
+  size_t conflation_slots;
 
   explicit actor_config(execution_unit* ptr = nullptr);
 
@@ -139,6 +139,9 @@ public:
 
   void enqueue(mailbox_element_ptr what, execution_unit* host);
 
+  void enqueue_batch(strong_actor_ptr sender, message_id mid,
+                     std::vector<message> xs, execution_unit* host);
+
   /// @endcond
 };
 
@@ -29,6 +29,8 @@
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_control_block.hpp"
 
+#include "caf/detail/storage_pool.hpp"
+
 #ifdef CAF_GCC
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Winvalid-offsetof"
@@ -75,6 +77,29 @@ public:
   actor_storage(const actor_storage&) = delete;
   actor_storage& operator=(const actor_storage&) = delete;
 
+  /// Returns the pool for recycling the memory of actors of type `T`.
+  static detail::storage_pool& pool() {
+    // never destroyed, since actors may outlive static destruction
+    static auto instance = new detail::storage_pool(sizeof(actor_storage));
+    return *instance;
+  }
+
+  static void* operator new(size_t) {
+    return pool().allocate();
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    pool().deallocate(ptr);
+  }
+
+  static void* operator new(size_t, void* ptr) noexcept {
+    return ptr;
+  }
+
+  static void operator delete(void*, void*) noexcept {
+    // nop
+  }
+
   static_assert(sizeof(actor_control_block) < CAF_CACHE_LINE_SIZE,
                 "actor_control_block exceeds 64 bytes");
 
@@ -24,18 +24,22 @@
 #include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
 #include <cstddef>
 #include <functional>
 #include <condition_variable>
 
 #include "caf/fwd.hpp"
 #include "caf/logger.hpp"
+#include "caf/optional.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/make_actor.hpp"
 #include "caf/infer_handle.hpp"
 #include "caf/actor_config.hpp"
 #include "caf/spawn_options.hpp"
 #include "caf/group_manager.hpp"
+#include "caf/memory_account.hpp"
+#include "caf/mailbox_metrics.hpp"
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_registry.hpp"
 #include "caf/string_algorithms.hpp"
@@ -238,6 +242,10 @@ public:
   /// Returns the scheduler instance.
   scheduler::abstract_coordinator& scheduler();
 
+  /// Returns the scheduler partition `name` or `nullptr` if the
+  /// configuration defines no such partition.
+  scheduler::abstract_coordinator* scheduler_partition(atom_value name);
+
   /// Returns the system-wide event logger.
   caf::logger& logger();
 
@@ -271,6 +279,38 @@ public:
   /// everything to the scheduler.
   scoped_execution_unit* dummy_execution_unit();
 
+  /// Returns the elastic thread pool for actors spawned with `pooled`.
+  /// @private
+  detail::blocking_pool& blocking_pool();
+
+  /// Returns the registry for mailbox metrics of all running actors.
+  /// @private
+  detail::mailbox_metrics_registry& mailbox_metrics();
+
+  /// Returns the mailbox metrics of all running actors. Returns an empty
+  /// vector unless CAF was built with `CAF_ENABLE_MAILBOX_METRICS`.
+  std::vector<mailbox_stats> mailbox_snapshot();
+
+  /// Returns the mailbox metrics of the running actor `aid` or `none` if no
+  /// such actor exists or CAF was built without `CAF_ENABLE_MAILBOX_METRICS`.
+  optional<mailbox_stats> mailbox_snapshot(actor_id aid);
+
+  /// Returns the memory accounts of all running actors.
+  /// @private
+  detail::memory_accounting& memory_accounting();
+
+  /// Returns the memory attributed to the `n` running actors that hold the
+  /// most memory, in descending order. Returns an empty vector unless the
+  /// configuration enables memory accounting.
+  std::vector<memory_stats> memory_top(size_t n);
+
+  /// Returns the memory attributed to the running actor `aid` or `none` if no
+  /// such actor exists or memory accounting is disabled.
+  optional<memory_stats> memory_snapshot(actor_id aid);
+
+  /// Returns the number of bytes attributed to all running actors.
+  size_t memory_in_use();
+
   /// Returns a new actor ID.
   actor_id next_actor_id();
 
@@ -302,6 +342,17 @@ public:
     return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
   }
 
+  /// Returns `n` new actors of type `C`, each using copies of `xs...` as
+  /// constructor arguments. Acquires the memory for all actors at once and
+  /// initializes them in a single pass.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  std::vector<infer_handle_from_class_t<C>> spawn_n(size_t n,
+                                                    const Ts&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    return spawn_n_impl<C, Os>(n, cfg, xs...);
+  }
+
   template <class S, spawn_options Os = no_spawn_options>
   infer_handle_from_state_t<S> spawn() {
     return spawn<composable_behavior_based_actor<S>, Os>();
@@ -345,6 +396,80 @@ public:
     return spawn_functor<Os>(cfg, fun, std::forward<Ts>(xs)...);
   }
 
+  /// Returns a new class-based actor running in the scheduler partition
+  /// `partition`. Falls back to the default scheduler if the configuration
+  /// defines no such partition.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  infer_handle_from_class_t<C> spawn_in_partition(atom_value partition,
+                                                  Ts&&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    cfg.partition = scheduler_partition(partition);
+    return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
+  }
+
+  /// Returns a new functor-based actor running in the scheduler partition
+  /// `partition`. Falls back to the default scheduler if the configuration
+  /// defines no such partition.
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  infer_handle_from_fun_t<F>
+  spawn_in_partition(atom_value partition, F fun, Ts&&... xs) {
+    check_invariants<infer_impl_from_fun_t<F>>();
+    actor_config cfg;
+    cfg.partition = scheduler_partition(partition);
+    return spawn_functor<Os>(cfg, fun, std::forward<Ts>(xs)...);
+  }
+
+  /// Returns a new class-based actor with a mailbox that holds at most
+  /// `capacity` messages and applies `policy` to all further messages.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  infer_handle_from_class_t<C> spawn_bounded(size_t capacity,
+                                             overflow_policy policy,
+                                             Ts&&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    cfg.mailbox_capacity = capacity;
+    cfg.mailbox_overflow = policy;
+    return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
+  }
+
+  /// Returns a new functor-based actor with a mailbox that holds at most
+  /// `capacity` messages and applies `policy` to all further messages.
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  infer_handle_from_fun_t<F>
+  spawn_bounded(size_t capacity, overflow_policy policy, F fun, Ts&&... xs) {
+    check_invariants<infer_impl_from_fun_t<F>>();
+    actor_config cfg;
+    cfg.mailbox_capacity = capacity;
+    cfg.mailbox_overflow = policy;
+    return spawn_functor<Os>(cfg, fun, std::forward<Ts>(xs)...);
+  }
+
+  /// Returns a new class-based actor with a conflating mailbox that holds
+  /// only the newest message per key for up to `slots` distinct keys.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  infer_handle_from_class_t<C> spawn_conflating(size_t slots,
+                                                conflation_key_fun key,
+                                                Ts&&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    cfg.conflation_key = std::move(key);
+    cfg.conflation_slots = slots;
+    return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
+  }
+
+  /// Returns a new functor-based actor with a conflating mailbox that holds
+  /// only the newest message per key for up to `slots` distinct keys.
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  infer_handle_from_fun_t<F>
+  spawn_conflating(size_t slots, conflation_key_fun key, F fun, Ts&&... xs) {
+    check_invariants<infer_impl_from_fun_t<F>>();
+    actor_config cfg;
+    cfg.conflation_key = std::move(key);
+    cfg.conflation_slots = slots;
+    return spawn_functor<Os>(cfg, fun, std::forward<Ts>(xs)...);
+  }
+
   /// Returns a new actor with run-time type `name`, constructed
   /// with the arguments stored in `args`.
   /// @experimental
@@ -490,9 +615,8 @@ private:
                                             bool check_interface,
                                             optional<const mpi&> expected_ifs);
 
-  template <class C, spawn_options Os, class... Ts>
-  infer_handle_from_class_t<C>
-  spawn_impl(actor_config& cfg, Ts&&... xs) {
+  template <class C, spawn_options Os>
+  void prepare_spawn(actor_config& cfg) {
     static_assert(is_unbound(Os),
                   "top-level spawns cannot have monitor or link flag");
     cfg.flags = has_priority_aware_flag(Os)
@@ -500,9 +624,17 @@ private:
                 : 0;
     if (has_detach_flag(Os) || std::is_base_of<blocking_actor, C>::value)
       cfg.flags |= abstract_actor::is_detached_flag;
+    else if (has_pooled_flag(Os))
+      cfg.flags |= abstract_actor::is_pooled_flag;
     if (!cfg.host)
       cfg.host = dummy_execution_unit();
     CAF_SET_LOGGER_SYS(this);
+  }
+
+  template <class C, spawn_options Os, class... Ts>
+  infer_handle_from_class_t<C>
+  spawn_impl(actor_config& cfg, Ts&&... xs) {
+    prepare_spawn<C, Os>(cfg);
     auto res = make_actor<C>(next_actor_id(), node(), this,
                              cfg, std::forward<Ts>(xs)...);
     auto ptr = static_cast<C*>(actor_cast<abstract_actor*>(res));
@@ -510,6 +642,21 @@ private:
     return res;
   }
 
+  template <class C, spawn_options Os, class... Ts>
+  std::vector<infer_handle_from_class_t<C>>
+  spawn_n_impl(size_t n, actor_config& cfg, const Ts&... xs) {
+    prepare_spawn<C, Os>(cfg);
+    // reserve IDs for all actors at once
+    auto first_id = static_cast<actor_id>(ids_.fetch_add(n) + 1);
+    auto res = make_actors<C>(n, first_id, node(), this, cfg,
+                              detail::spawn_fwd<const Ts&>(xs)...);
+    for (auto& x : res) {
+      auto ptr = static_cast<C*>(actor_cast<abstract_actor*>(x));
+      ptr->launch(cfg.host, has_lazy_init_flag(Os), has_hide_flag(Os));
+    }
+    return res;
+  }
+
   std::atomic<size_t> ids_;
   uniform_type_info_map types_;
   node_id node_;
@@ -517,6 +664,10 @@ private:
   actor_registry registry_;
   group_manager groups_;
   module_array modules_;
+  std::vector<std::unique_ptr<scheduler::abstract_coordinator>> partitions_;
+  std::unique_ptr<detail::blocking_pool> blocking_pool_;
+  std::unique_ptr<detail::mailbox_metrics_registry> mailbox_metrics_;
+  std::unique_ptr<detail::memory_accounting> memory_accounting_;
   io::middleman* middleman_;
   scoped_execution_unit dummy_execution_unit_;
   opencl::manager* opencl_manager_;
@@ -23,6 +23,8 @@
 #include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
+#include <limits>
 #include <typeindex>
 #include <functional>
 #include <type_traits>
@@ -92,6 +94,20 @@ public:
     const char* cat_;
   };
 
+  /// Describes a dedicated pool of scheduler workers. Actors spawned into a
+  /// partition never share worker threads with actors of other partitions or
+  /// of the default scheduler.
+  struct scheduler_partition {
+    /// Identifies the partition when spawning actors.
+    atom_value name;
+    /// Scheduling policy: 'stealing', 'sharing', 'lf-steal', or 'lf-share'.
+    atom_value policy;
+    /// Number of worker threads of the partition.
+    size_t max_threads;
+    /// Number of messages an actor consumes before yielding.
+    size_t max_throughput;
+  };
+
   // -- constructors, destructors, and assignment operators --------------------
 
   virtual ~actor_system_config();
@@ -120,6 +136,15 @@ public:
   actor_system_config& parse(int argc, char** argv,
                              const char* ini_file_cstr = nullptr);
 
+  /// Adds a scheduler partition named `name` with `max_threads` workers that
+  /// schedule actors according to `policy`. Actors are assigned to the
+  /// partition via `actor_system::spawn_in_partition`.
+  actor_system_config&
+  add_scheduler_partition(atom_value name, size_t max_threads,
+                          atom_value policy = atom("stealing"),
+                          size_t max_throughput
+                          = std::numeric_limits<size_t>::max());
+
   /// Allows other nodes to spawn actors created by `fun`
   /// dynamically by using `name` as identifier.
   /// @experimental
@@ -241,6 +266,9 @@ public:
   bool scheduler_enable_profiling;
   size_t scheduler_profiling_ms_resolution;
   std::string scheduler_profiling_output_file;
+  std::string scheduler_worker_cpus;
+  std::string scheduler_utility_cpus;
+  std::vector<scheduler_partition> scheduler_partitions;
 
   // -- config parameters for work-stealing ------------------------------------
 
@@ -251,6 +279,28 @@ public:
   size_t work_stealing_moderate_sleep_duration_us;
   size_t work_stealing_relaxed_steal_interval;
   size_t work_stealing_relaxed_sleep_duration_us;
+  atom_value work_stealing_idle_strategy;
+  atom_value work_stealing_victim_selection;
+  size_t work_stealing_run_next_limit;
+  bool work_stealing_steal_half;
+
+  // -- config parameters for work-sharing -------------------------------------
+
+  size_t work_sharing_queue_capacity;
+
+  // -- config parameters for the blocking pool --------------------------------
+
+  size_t blocking_pool_max_threads;
+  size_t blocking_pool_idle_timeout_ms;
+
+  // -- config parameters for mailboxes ----------------------------------------
+
+  size_t mailbox_max_priority_streak;
+  size_t mailbox_metrics_ms_interval;
+  std::string mailbox_metrics_output_file;
+  bool mailbox_memory_accounting;
+  size_t mailbox_memory_budget;
+  atom_value mailbox_budget_policy;
 
   // -- config parameters for the logger ---------------------------------------
 
@@ -266,6 +316,8 @@ public:
   bool middleman_enable_automatic_connections;
   size_t middleman_max_consecutive_reads;
   size_t middleman_heartbeat_interval;
+  std::string middleman_multiplexer_cpus;
+  size_t middleman_zero_copy_threshold;
 
   // -- config parameters of the OpenCL module ---------------------------------
 
@@ -24,6 +24,7 @@
 
 #include "caf/sec.hpp"
 #include "caf/atom.hpp"
+#include "caf/batch.hpp"
 #include "caf/send.hpp"
 #include "caf/skip.hpp"
 #include "caf/unit.hpp"
@@ -43,6 +44,7 @@
 #include "caf/expected.hpp"
 #include "caf/exec_main.hpp"
 #include "caf/resumable.hpp"
+#include "caf/byte_chunk.hpp"
 #include "caf/streambuf.hpp"
 #include "caf/to_string.hpp"
 #include "caf/actor_addr.hpp"
@@ -75,6 +77,11 @@
 #include "caf/behavior_policy.hpp"
 #include "caf/continue_helper.hpp"
 #include "caf/mailbox_element.hpp"
+#include "caf/mailbox_metrics.hpp"
+#include "caf/memory_account.hpp"
+#include "caf/memory_resource.hpp"
+#include "caf/monotonic_buffer_resource.hpp"
+#include "caf/overflow_policy.hpp"
 #include "caf/message_builder.hpp"
 #include "caf/message_handler.hpp"
 #include "caf/response_handle.hpp"
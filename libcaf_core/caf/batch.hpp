@@ -0,0 +1,202 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_BATCH_HPP
+#define CAF_BATCH_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "caf/fwd.hpp"
+#include "caf/message.hpp"
+#include "caf/make_message.hpp"
+#include "caf/type_erased_tuple.hpp"
+
+#include "caf/detail/type_list.hpp"
+
+namespace caf {
+
+/// A contiguous sequence of messages that consist of a single `T` each.
+/// Message handlers for `batch<T>` receive consecutive `T` messages from the
+/// mailbox of a scheduled actor at once, up to the maximum throughput of
+/// the scheduler. Such handlers take precedence over handlers for `T`.
+template <class T>
+class batch {
+public:
+  using container_type = std::vector<T>;
+
+  using value_type = T;
+
+  using size_type = typename container_type::size_type;
+
+  using iterator = typename container_type::iterator;
+
+  using const_iterator = typename container_type::const_iterator;
+
+  batch() = default;
+
+  batch(batch&&) = default;
+  batch(const batch&) = default;
+  batch& operator=(batch&&) = default;
+  batch& operator=(const batch&) = default;
+
+  batch(std::initializer_list<T> xs) : xs_(xs) {
+    // nop
+  }
+
+  inline iterator begin() {
+    return xs_.begin();
+  }
+
+  inline iterator end() {
+    return xs_.end();
+  }
+
+  inline const_iterator begin() const {
+    return xs_.begin();
+  }
+
+  inline const_iterator end() const {
+    return xs_.end();
+  }
+
+  inline size_type size() const {
+    return xs_.size();
+  }
+
+  inline bool empty() const {
+    return xs_.empty();
+  }
+
+  inline T* data() {
+    return xs_.data();
+  }
+
+  inline const T* data() const {
+    return xs_.data();
+  }
+
+  inline T& operator[](size_type pos) {
+    return xs_[pos];
+  }
+
+  inline const T& operator[](size_type pos) const {
+    return xs_[pos];
+  }
+
+  inline void reserve(size_type n) {
+    xs_.reserve(n);
+  }
+
+  inline void clear() {
+    xs_.clear();
+  }
+
+  inline void push_back(T x) {
+    xs_.push_back(std::move(x));
+  }
+
+  inline iterator insert(const_iterator pos, T x) {
+    return xs_.insert(pos, std::move(x));
+  }
+
+  /// Returns the underlying container.
+  inline container_type& values() {
+    return xs_;
+  }
+
+  /// Returns the underlying container.
+  inline const container_type& values() const {
+    return xs_;
+  }
+
+private:
+  container_type xs_;
+};
+
+/// @relates batch
+template <class T>
+bool operator==(const batch<T>& x, const batch<T>& y) {
+  return x.values() == y.values();
+}
+
+/// @relates batch
+template <class T>
+bool operator!=(const batch<T>& x, const batch<T>& y) {
+  return !(x == y);
+}
+
+namespace detail {
+
+/// Combines consecutive messages into a single `batch<T>` on behalf of a
+/// match case for `batch<T>`.
+class batch_factory {
+public:
+  virtual ~batch_factory();
+
+  /// Returns whether `x` consists of a single `T`.
+  virtual bool accepts(const type_erased_tuple& x) const = 0;
+
+  /// Returns a message with a single `batch<T>` that holds the values of
+  /// all tuples in `xs`, moving values out of unshared tuples.
+  /// @pre `accepts(*x)` for all `x` in `xs`
+  virtual message make(const std::vector<type_erased_tuple*>& xs) const = 0;
+};
+
+template <class T>
+class batch_factory_impl final : public batch_factory {
+public:
+  bool accepts(const type_erased_tuple& x) const override {
+    return x.size() == 1 && x.match_element<T>(0);
+  }
+
+  message make(const std::vector<type_erased_tuple*>& xs) const override {
+    batch<T> result;
+    result.reserve(xs.size());
+    for (auto x : xs)
+      result.push_back(x->move_if_unshared<T>(0));
+    return make_message(std::move(result));
+  }
+
+  static const batch_factory* instance() {
+    static batch_factory_impl singleton;
+    return &singleton;
+  }
+};
+
+/// Returns the batch factory for match cases with the argument types `Ts`,
+/// i.e., `nullptr` unless `Ts` consists of a single `batch<T>`.
+template <class Ts>
+struct batch_factory_of {
+  static const batch_factory* get() {
+    return nullptr;
+  }
+};
+
+template <class T>
+struct batch_factory_of<type_list<batch<T>>> {
+  static const batch_factory* get() {
+    return batch_factory_impl<T>::instance();
+  }
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_BATCH_HPP
@@ -117,6 +117,19 @@ public:
     return impl_ ? impl_->invoke(f, xs) : match_case::no_match;
   }
 
+  /// Returns whether this behavior has at least one match case for
+  /// messages with type token `tt`.
+  inline bool may_match(uint32_t tt) const {
+    return impl_ ? impl_->may_match(tt) : false;
+  }
+
+  /// Returns the factory for combining `xs` with subsequent messages of the
+  /// same type if this behavior handles `batch<T>` and `xs` is a single `T`.
+  inline const detail::batch_factory*
+  batch_for(const type_erased_tuple& xs) const {
+    return impl_ ? impl_->batch_for(xs) : nullptr;
+  }
+
   /// Checks whether this behavior is not empty.
   inline operator bool() const {
     return static_cast<bool>(impl_);
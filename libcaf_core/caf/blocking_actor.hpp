@@ -185,6 +185,11 @@ public:
 
   void enqueue(mailbox_element_ptr, execution_unit*) override;
 
+  using abstract_actor::enqueue_batch;
+
+  void enqueue_batch(std::vector<mailbox_element_ptr>,
+                     execution_unit*) override;
+
   // -- overridden functions of local_actor ------------------------------------
 
   const char* name() const override;
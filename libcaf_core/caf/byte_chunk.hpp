@@ -0,0 +1,177 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_BYTE_CHUNK_HPP
+#define CAF_BYTE_CHUNK_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "caf/fwd.hpp"
+#include "caf/error.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/intrusive_ptr.hpp"
+
+#include "caf/meta/type_name.hpp"
+
+#include "caf/detail/comparable.hpp"
+#include "caf/detail/type_traits.hpp"
+
+namespace caf {
+
+/// An immutable, reference counted sequence of bytes. Copying or slicing a
+/// chunk never copies its content, which allows actors to pass large
+/// payloads to each other and to the network layer without intermediate
+/// buffers. Serializers that support scatter/gather output (see
+/// `serializer::apply_chunk`) write chunks without copying them either.
+class byte_chunk : detail::comparable<byte_chunk> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = char;
+
+  using const_iterator = const char*;
+
+  using iterator = const_iterator;
+
+  /// Owns the bytes shared by all chunks that refer to it.
+  class storage : public ref_counted {
+  public:
+    explicit storage(std::vector<char> buf);
+
+    ~storage() override;
+
+    inline const std::vector<char>& buf() const noexcept {
+      return buf_;
+    }
+
+  private:
+    std::vector<char> buf_;
+  };
+
+  using storage_ptr = intrusive_ptr<storage>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  byte_chunk() noexcept;
+
+  byte_chunk(byte_chunk&&) noexcept = default;
+
+  byte_chunk(const byte_chunk&) = default;
+
+  byte_chunk& operator=(byte_chunk&&) noexcept = default;
+
+  byte_chunk& operator=(const byte_chunk&) = default;
+
+  /// Takes ownership of `buf` without copying its content.
+  explicit byte_chunk(std::vector<char> buf);
+
+  /// Creates a new chunk by copying `num_bytes` bytes from `buf`.
+  static byte_chunk copy(const void* buf, size_t num_bytes);
+
+  // -- properties -------------------------------------------------------------
+
+  inline const char* data() const noexcept {
+    return data_;
+  }
+
+  inline size_t size() const noexcept {
+    return size_;
+  }
+
+  inline bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  inline const_iterator begin() const noexcept {
+    return data_;
+  }
+
+  inline const_iterator end() const noexcept {
+    return data_ + size_;
+  }
+
+  inline char operator[](size_t pos) const noexcept {
+    return data_[pos];
+  }
+
+  /// Returns the storage shared by this chunk.
+  inline const storage_ptr& get_storage() const noexcept {
+    return storage_;
+  }
+
+  /// Returns whether this chunk and `other` share the same storage.
+  inline bool shares_storage_with(const byte_chunk& other) const noexcept {
+    return storage_ != nullptr && storage_ == other.storage_;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Returns a chunk referring to the `len` bytes starting at `offset`. The
+  /// result shares the storage of this chunk. Both arguments are clamped to
+  /// the bounds of this chunk.
+  byte_chunk slice(size_t offset, size_t len = static_cast<size_t>(-1)) const;
+
+  /// Releases the reference to the shared storage.
+  void reset() noexcept;
+
+  /// Returns a copy of the content as vector.
+  std::vector<char> to_vector() const;
+
+  // -- comparison -------------------------------------------------------------
+
+  int compare(const byte_chunk& other) const noexcept;
+
+  // -- inspection -------------------------------------------------------------
+
+  template <class Inspector>
+  friend detail::enable_if_t<Inspector::reads_state,
+                             typename Inspector::result_type>
+  inspect(Inspector& f, byte_chunk& x) {
+    auto tmp = x.to_vector();
+    return f(meta::type_name("byte_chunk"), tmp);
+  }
+
+  template <class Inspector>
+  friend detail::enable_if_t<Inspector::writes_state,
+                             typename Inspector::result_type>
+  inspect(Inspector& f, byte_chunk& x) {
+    std::vector<char> tmp;
+    auto res = f(meta::type_name("byte_chunk"), tmp);
+    x = byte_chunk{std::move(tmp)};
+    return res;
+  }
+
+  /// Writes `x` via `serializer::apply_chunk`.
+  friend error inspect(serializer& f, byte_chunk& x);
+
+  /// Reads the content of `x` into a fresh buffer with a single copy.
+  friend error inspect(deserializer& f, byte_chunk& x);
+
+private:
+  byte_chunk(storage_ptr ptr, const char* data, size_t size) noexcept;
+
+  storage_ptr storage_;
+  const char* data_;
+  size_t size_;
+};
+
+} // namespace caf
+
+#endif // CAF_BYTE_CHUNK_HPP
@@ -39,6 +39,7 @@
 #include "caf/timeout_definition.hpp"
 #include "caf/typed_response_promise.hpp"
 
+#include "caf/detail/memory.hpp"
 #include "caf/detail/int_list.hpp"
 #include "caf/detail/apply_args.hpp"
 #include "caf/detail/type_traits.hpp"
@@ -54,7 +55,7 @@ class message_handler;
 namespace caf {
 namespace detail {
 
-class behavior_impl : public ref_counted {
+class behavior_impl : public ref_counted, public slab_allocated {
 public:
   using pointer = intrusive_ptr<behavior_impl>;
 
@@ -73,6 +74,15 @@ public:
 
   optional<message> invoke(type_erased_tuple&);
 
+  /// Returns whether this behavior has at least one match case for messages
+  /// with type token `tt`, i.e., whether `invoke` can return anything but
+  /// `match_case::no_match` for such messages.
+  virtual bool may_match(uint32_t tt) const;
+
+  /// Returns the factory of the first match case for `batch<T>` that
+  /// accepts `xs`, i.e., if `xs` consists of a single `T`, or `nullptr`.
+  virtual const batch_factory* batch_for(const type_erased_tuple& xs) const;
+
   virtual void handle_timeout();
 
   inline const duration& timeout() const {
@@ -84,9 +94,13 @@ public:
   pointer or_else(const pointer& other);
 
 protected:
+  /// Checks whether any match case in `[begin_, end_)` handles batches.
+  void init_batches();
+
   duration timeout_;
   match_case_info* begin_;
   match_case_info* end_;
+  bool has_batches_;
 };
 
 template <class Tuple>
@@ -180,6 +194,7 @@ private:
             std::integral_constant<size_t, Last>) {
     this->begin_ = arr_.data();
     this->end_ = arr_.data() + arr_.size();
+    this->init_batches();
     std::integral_constant<bool, has_timeout> token;
     set_timeout(token);
   }
@@ -0,0 +1,78 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_BLOCKING_POOL_HPP
+#define CAF_DETAIL_BLOCKING_POOL_HPP
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <cstddef>
+#include <condition_variable>
+
+#include "caf/fwd.hpp"
+
+namespace caf {
+namespace detail {
+
+/// An elastic thread pool for actors that call blocking functions. The pool
+/// starts a new thread whenever a job arrives while all of its threads are
+/// busy, up to a configured maximum. Threads terminate after being idle for a
+/// configured amount of time. Each thread resumes jobs like a scheduler worker
+/// would, i.e., the pool merely replaces the one-thread-per-actor model of
+/// `detached` actors.
+class blocking_pool {
+public:
+  explicit blocking_pool(actor_system& sys);
+
+  blocking_pool(const blocking_pool&) = delete;
+  blocking_pool& operator=(const blocking_pool&) = delete;
+
+  /// Schedules `job` for execution on one of the pool's threads.
+  void enqueue(resumable* job);
+
+  /// Causes all threads to terminate as soon as no more jobs are pending.
+  /// The actor system awaits the threads as part of its detached threads.
+  void stop();
+
+  /// Returns the number of running threads.
+  size_t num_threads();
+
+  /// Returns the number of threads waiting for jobs.
+  size_t num_idle_threads();
+
+private:
+  void run();
+
+  actor_system& system_;
+  size_t max_threads_;
+  size_t max_throughput_;
+  std::chrono::milliseconds idle_timeout_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<resumable*> jobs_;
+  size_t num_threads_;
+  size_t num_idle_;
+  bool stopped_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_BLOCKING_POOL_HPP
@@ -0,0 +1,49 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_BUILD_CONFIG_HPP
+#define CAF_DETAIL_BUILD_CONFIG_HPP
+
+// this header is auto-generated by CMake
+
+#if -1 != -1
+#define CAF_LOG_LEVEL 
+#endif
+
+#if -1 != -1
+#define CAF_NO_MEM_MANAGEMENT
+#endif
+
+#if -1 != -1
+#define CAF_ENABLE_RUNTIME_CHECKS
+#endif
+
+#if -1 != -1
+#define CAF_ENABLE_MAILBOX_METRICS
+#endif
+
+#if -1 != -1
+#define CAF_USE_ASIO
+#endif
+
+#if -1 != -1
+#define CAF_NO_EXCEPTIONS
+#endif
+
+#endif //CAF_DETAIL_BUILD_CONFIG_HPP
@@ -0,0 +1,121 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_CACHE_INDEX_HPP
+#define CAF_DETAIL_CACHE_INDEX_HPP
+
+#include <map>
+#include <limits>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+
+#include "caf/fwd.hpp"
+#include "caf/message_id.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Indexes the skipped messages in the cache of an actor by type token and
+/// identifies cached responses by their message ID. Actors use the index to
+/// visit only cached messages that can match their current behavior instead
+/// of re-scanning the whole cache after each processed message.
+///
+/// The index only stores pointers and assigns each element a position that
+/// reflects its order in the cache, i.e., high-priority elements of
+/// priority-aware actors precede all normal elements.
+class cache_index {
+public:
+  /// Orders elements of the cache.
+  using position = uint64_t;
+
+  /// Key for indexing elements, either a type token or `response_key`.
+  using key_type = uint64_t;
+
+  /// Key for all responses, which are indexed by message ID instead of type.
+  static constexpr key_type response_key = key_type{1} << 32;
+
+  cache_index();
+
+  cache_index(const cache_index&) = delete;
+  cache_index& operator=(const cache_index&) = delete;
+
+  /// Adds `x` after the cache stored it, either at the end of all elements or
+  /// at the end of all high-priority elements if `high_priority == true`.
+  void add(mailbox_element* x, bool high_priority = false);
+
+  /// Removes `x` before the cache erases it.
+  void erase(mailbox_element* x);
+
+  /// Removes all elements.
+  void clear();
+
+  /// Returns whether the index contains no element.
+  inline bool empty() const {
+    return entries_.empty();
+  }
+
+  /// Returns the cached response with ID `mid` or `nullptr`.
+  mailbox_element* response(message_id mid) const;
+
+  /// Returns the first element after `pos` with a key that satisfies `pred`
+  /// together with its position or `nullptr` if no such element exists.
+  /// Passing 0 as `pos` starts at the first element.
+  template <class Predicate>
+  std::pair<position, mailbox_element*> next(position pos, Predicate pred) {
+    std::pair<position, mailbox_element*> result{
+      std::numeric_limits<position>::max(), nullptr};
+    for (auto& kvp : by_key_) {
+      if (!pred(kvp.first))
+        continue;
+      auto i = kvp.second.upper_bound(pos);
+      if (i != kvp.second.end() && i->first < result.first)
+        result = *i;
+    }
+    return result;
+  }
+
+private:
+  struct entry {
+    key_type key;
+    position pos;
+  };
+
+  static key_type key_of(mailbox_element& x);
+
+  // maps keys to all elements with that key, sorted by position
+  std::unordered_map<key_type, std::map<position, mailbox_element*>> by_key_;
+
+  // allows erasing elements in O(1) on average
+  std::unordered_map<mailbox_element*, entry> entries_;
+
+  // maps response IDs to cached responses
+  std::unordered_map<uint64_t, mailbox_element*> responses_;
+
+  // next position for high-priority elements
+  position next_high_;
+
+  // next position for normal elements
+  position next_normal_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_CACHE_INDEX_HPP
@@ -0,0 +1,99 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_CONFLATION_TABLE_HPP
+#define CAF_DETAIL_CONFLATION_TABLE_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/fwd.hpp"
+#include "caf/actor_config.hpp"
+#include "caf/mailbox_element.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A fixed-size, lock-free hash table that maps conflation keys to slots.
+/// Each slot stores the newest unprocessed message for its key and serves
+/// as placeholder in the mailbox. Writers swap new messages into the slot
+/// and enqueue the slot itself only if the slot was empty. Hence, the
+/// mailbox contains each key at most once and the reader always receives
+/// the newest message for a key when dequeueing its slot.
+class conflation_table {
+public:
+  /// Stores the newest message for a key. Slots belong to the table, i.e.,
+  /// deletion requests from the mailbox only dispose the stored message.
+  class slot : public mailbox_element {
+  public:
+    slot();
+
+    ~slot() override;
+
+    void request_deletion(bool decremented_rc) noexcept override;
+
+    /// Either `free`, `claimed` or `used`.
+    std::atomic<int> state;
+
+    /// Conflation key, valid once `state == used`.
+    uint64_t key;
+
+    /// Newest unprocessed message for `key` or `nullptr`.
+    std::atomic<mailbox_element*> latest;
+  };
+
+  /// Creates a table for at least `capacity` keys, rounded up to the next
+  /// power of two.
+  conflation_table(conflation_key_fun fun, size_t capacity);
+
+  ~conflation_table();
+
+  conflation_table(const conflation_table&) = delete;
+  conflation_table& operator=(const conflation_table&) = delete;
+
+  /// Returns the slot for the key of `x` or `nullptr` if `x` bypasses
+  /// conflation, i.e., if `x` is not an asynchronous message, is an
+  /// `exit_msg` or `down_msg`, has no key or the table is full.
+  /// @threadsafe
+  slot* slot_for(mailbox_element& x);
+
+  /// Returns whether `x` is a slot of this table.
+  inline bool owns(const mailbox_element* x) const {
+    auto ptr = reinterpret_cast<const char*>(x);
+    return ptr >= first_ && ptr < last_;
+  }
+
+  /// Takes the newest message out of `x`, which must be a slot of this
+  /// table, after the reader dequeued `x`.
+  static mailbox_element* take(mailbox_element* x);
+
+private:
+  conflation_key_fun fun_;
+  size_t mask_;
+  std::unique_ptr<slot[]> slots_;
+  const char* first_;
+  const char* last_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_CONFLATION_TABLE_HPP
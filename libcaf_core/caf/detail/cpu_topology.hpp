@@ -0,0 +1,89 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_CPU_TOPOLOGY_HPP
+#define CAF_DETAIL_CPU_TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace caf {
+namespace detail {
+
+/// Describes which of the online CPUs share a cache or a NUMA node.
+class cpu_topology {
+public:
+  /// Distance between two CPUs, ordered from near to far.
+  enum locality : size_t {
+    /// Both CPUs share their last-level cache.
+    shared_cache,
+    /// Both CPUs belong to the same NUMA node.
+    same_node,
+    /// The CPUs belong to different NUMA nodes.
+    remote_node
+  };
+
+  /// Number of distinct `locality` values.
+  static constexpr size_t num_localities = 3;
+
+  /// Location of a single CPU.
+  struct cpu {
+    /// ID of the CPU as used by the operating system.
+    int id;
+    /// Smallest CPU ID sharing the last-level cache with this CPU.
+    int cache;
+    /// ID of the NUMA node this CPU belongs to.
+    int node;
+  };
+
+  /// Reads the layout of all online CPUs from `root`, which is the path
+  /// to `/sys/devices/system` on Linux. Returns an empty topology if
+  /// `root` provides no information about online CPUs.
+  static cpu_topology read(const std::string& root = "/sys/devices/system");
+
+  /// Parses a list of CPU IDs in the format used by the Linux kernel,
+  /// e.g., `0-3,8,10-11`. Stops at the first invalid character.
+  static std::vector<int> parse_cpu_list(const std::string& str);
+
+  /// Returns all online CPUs, sorted by node, cache and ID. Hence, CPUs
+  /// that are near each other are also next to each other in this list.
+  inline const std::vector<cpu>& cpus() const {
+    return cpus_;
+  }
+
+  /// Returns whether no information about the CPU layout is available.
+  inline bool empty() const {
+    return cpus_.empty();
+  }
+
+  /// Removes all CPUs with an ID not in `ids`.
+  void retain(const std::vector<int>& ids);
+
+  /// Returns the distance between `x` and `y`.
+  static locality distance(const cpu& x, const cpu& y);
+
+private:
+  std::vector<cpu> cpus_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_CPU_TOPOLOGY_HPP
@@ -25,6 +25,7 @@
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <vector>
 #include <cassert>
 
 // GCC hack
@@ -199,6 +200,36 @@ public:
     return result;
   }
 
+  // acquires both locks, moves up to half of all elements (but at least one)
+  // from the end of the queue to `result` and returns the number of elements
+  size_type take_tail_half(std::vector<pointer>& result) {
+    node* first;
+    { // lifetime scope of guards
+      lock_guard guard1(head_lock_);
+      lock_guard guard2(tail_lock_);
+      size_type n = 0;
+      for (auto i = head_.load()->next.load(); i != nullptr; i = i->next)
+        ++n;
+      if (n == 0)
+        return 0;
+      // skip the first n - ceil(n / 2) elements
+      auto pred = head_.load();
+      for (auto i = n - (n + 1) / 2; i > 0; --i)
+        pred = pred->next;
+      first = pred->next;
+      pred->next = nullptr;
+      tail_ = pred;
+    }
+    size_type result_size = 0;
+    while (first != nullptr) {
+      unique_node_ptr tmp{first};
+      first = tmp->next;
+      result.push_back(tmp->value);
+      ++result_size;
+    }
+    return result_size;
+  }
+
   // does not lock
   bool empty() const {
     // atomically compares first and last pointer without locks
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_EVENT_COUNT_HPP
+#define CAF_DETAIL_EVENT_COUNT_HPP
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef CAF_LINUX
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace caf {
+namespace detail {
+
+/// An event count allows threads to block until some condition becomes
+/// true without missing wakeups and without burdening notifiers with a
+/// system call unless at least one thread is actually waiting. Waiters call
+/// `prepare_wait`, re-check their condition, and then either call
+/// `cancel_wait` or `wait`. Notifiers change the condition first and then
+/// call `notify_one` or `notify_all`. Uses a futex on Linux and a mutex with
+/// condition variable elsewhere.
+class event_count {
+public:
+  using key_type = uint32_t;
+
+  event_count();
+
+  event_count(const event_count&) = delete;
+  event_count& operator=(const event_count&) = delete;
+
+  /// Registers the calling thread as waiter and returns a key for `wait`.
+  key_type prepare_wait() {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    // make sure the caller re-checks its condition after registering
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_acquire);
+  }
+
+  /// Unregisters the calling thread after a successful re-check.
+  void cancel_wait() {
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /// Blocks until a notification arrived after `prepare_wait` returned `key`.
+  void wait(key_type key);
+
+  /// Wakes up one waiting thread if at least one thread waits.
+  void notify_one() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) != 0)
+      notify(false);
+  }
+
+  /// Wakes up all waiting threads.
+  void notify_all() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) != 0)
+      notify(true);
+  }
+
+  /// Returns the number of threads that are currently (about to) wait.
+  size_t waiters() const {
+    return waiters_.load(std::memory_order_relaxed);
+  }
+
+private:
+  void notify(bool all);
+
+  // incremented on each notification, waiters block while it is unchanged
+  std::atomic<key_type> epoch_;
+  // number of threads in between prepare_wait and wait/cancel_wait
+  std::atomic<key_type> waiters_;
+# ifndef CAF_LINUX
+  std::mutex mtx_;
+  std::condition_variable cv_;
+# endif
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_EVENT_COUNT_HPP
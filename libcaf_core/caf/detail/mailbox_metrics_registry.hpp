@@ -0,0 +1,81 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_MAILBOX_METRICS_REGISTRY_HPP
+#define CAF_DETAIL_MAILBOX_METRICS_REGISTRY_HPP
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "caf/fwd.hpp"
+#include "caf/optional.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/mailbox_metrics.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Keeps track of the mailbox metrics of all running actors and optionally
+/// writes a snapshot of all metrics to a file in a configured interval.
+class mailbox_metrics_registry {
+public:
+  explicit mailbox_metrics_registry(actor_system& sys);
+
+  ~mailbox_metrics_registry();
+
+  mailbox_metrics_registry(const mailbox_metrics_registry&) = delete;
+  mailbox_metrics_registry& operator=(const mailbox_metrics_registry&) = delete;
+
+  /// Adds the metrics of a new actor.
+  void add(intrusive_ptr<mailbox_metrics> x);
+
+  /// Removes the metrics of a terminated actor.
+  void erase(actor_id aid);
+
+  /// Returns snapshots for all running actors.
+  std::vector<mailbox_stats> snapshot();
+
+  /// Returns a snapshot for the actor `aid` if it is still running.
+  optional<mailbox_stats> snapshot(actor_id aid);
+
+  /// Starts a thread for writing snapshots periodically if the configured
+  /// interval is not zero.
+  void start();
+
+  /// Stops the thread for writing snapshots.
+  void stop();
+
+private:
+  void run();
+
+  actor_system& system_;
+  std::mutex mtx_;
+  std::unordered_map<actor_id, intrusive_ptr<mailbox_metrics>> entries_;
+  std::condition_variable cv_;
+  bool stopped_;
+  std::thread thread_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_MAILBOX_METRICS_REGISTRY_HPP
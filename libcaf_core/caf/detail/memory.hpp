@@ -22,172 +22,90 @@
 
 #include <new>
 #include <vector>
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
-#include <typeinfo>
 
 #include "caf/config.hpp"
-#include "caf/ref_counted.hpp"
-
-#include "caf/detail/embedded.hpp"
-
-namespace caf {
-class mailbox_element;
-} // namespace caf
 
 namespace caf {
 namespace detail {
 
-namespace {
+/// Allocation counters for a single size class of the slab allocator.
+struct slab_stats {
+  /// Size of objects in this class in bytes.
+  size_t size;
+  /// Number of objects allocated from this class.
+  uint64_t allocations;
+  /// Number of objects returned to this class.
+  uint64_t deallocations;
+  /// Number of bytes reserved from the global heap for this class.
+  uint64_t reserved;
+  /// Number of free lists passed between threads for this class.
+  uint64_t transfers;
+};
 
-constexpr size_t s_alloc_size = 1024 * 1024;    // allocate ~1mb chunks
-constexpr size_t s_cache_size = 10 * 1024 * 1024; // cache about 10mb per thread
-constexpr size_t s_min_elements = 5;        // don't create < 5 elements
-constexpr size_t s_max_elements = 20;       // don't create > 20 elements
+/// Size-class slab allocator for small, frequently allocated objects such
+/// as mailbox elements and message data. Each thread keeps a free list per
+/// size class. A thread that frees more objects than it allocates (e.g. the
+/// consumer in a pipeline) hands a magazine of free objects over to a global
+/// depot from where other threads pick it up. Slabs are never returned to
+/// the global heap, i.e., memory usage is bounded by the peak number of live
+/// objects.
+class memory {
+public:
+  memory() = delete;
 
-} // namespace <anonymous>
+  /// Objects larger than this size use the global heap.
+  static constexpr size_t max_slab_size = 512;
 
-using embedded_storage = std::pair<intrusive_ptr<ref_counted>, void*>;
+  /// Number of free objects a thread passes to the depot at once.
+  static constexpr size_t magazine_size = 64;
 
-class memory_cache {
-public:
-  virtual ~memory_cache();
-  virtual embedded_storage new_embedded_storage() = 0;
-};
+  /// Size of a single slab in bytes.
+  static constexpr size_t slab_size = 64 * 1024;
 
-template <class T>
-class basic_memory_cache;
+  /// Returns storage for an object of `size` bytes.
+  static void* allocate(size_t size);
 
-#ifdef CAF_NO_MEM_MANAGEMENT
+  /// Releases storage acquired with `allocate(size)`.
+  static void deallocate(void* ptr, size_t size) noexcept;
 
-class memory {
-public:
-  memory() = delete;
+  /// Returns the counters for all size classes. Threads update the counters
+  /// in steps of up to `magazine_size` operations, only the counters of the
+  /// calling thread are always accurate.
+  static std::vector<slab_stats> stats();
 
-  // Allocates storage, initializes a new object, and returns the new instance.
+  /// Allocates storage, initializes a new object, and returns the new
+  /// instance. `T` must inherit from `slab_allocated` to use the slab.
   template <class T, class... Ts>
   static T* create(Ts&&... xs) {
     return new T(std::forward<Ts>(xs)...);
   }
-
-  static inline memory_cache* get_cache_map_entry(const std::type_info*) {
-    return nullptr;
-  }
 };
 
-#else // CAF_NO_MEM_MANAGEMENT
-
-template <class T>
-class basic_memory_cache : public memory_cache {
+/// Base for types that allocate their instances via `memory`. Deleting an
+/// instance requires a virtual destructor in order to pass the size of the
+/// dynamic type to `operator delete`.
+class slab_allocated {
 public:
-  static constexpr size_t ne = s_alloc_size / sizeof(T);
-  static constexpr size_t ms = ne < s_min_elements ? s_min_elements : ne;
-  static constexpr size_t dsize = ms > s_max_elements ? s_max_elements : ms;
-
-  static_assert(dsize > 0, "dsize == 0");
-
-  using embedded_t = embedded<T>;
-
-  struct wrapper {
-    union {
-      embedded_t instance;
-    };
-
-    wrapper() {
-      // nop
-    }
-
-    ~wrapper() {
-      // nop
-    }
-  };
-
-  class storage : public ref_counted {
-  public:
-    storage() : pos_(0) {
-      // nop
-    }
-
-    ~storage() override {
-      // nop
-    }
-
-    bool has_next() {
-      return pos_ < dsize;
-    }
-
-    embedded_t* next() {
-      return &(data_[pos_++].instance);
-    }
-
-  private:
-    size_t pos_;
-    wrapper data_[dsize];
-  };
-
-  embedded_storage new_embedded_storage() override {
-    // allocate cache on-the-fly
-    if (!cache_) {
-      cache_.reset(new storage, false); // starts with ref count of 1
-      CAF_ASSERT(cache_->unique());
-    }
-    auto res = cache_->next();
-    if (cache_->has_next()) {
-      return {cache_, res};
-    }
-    // we got the last element out of the cache; pass the reference to the
-    // client to avoid pointless increase/decrease ops on the reference count
-    embedded_storage result;
-    result.first.reset(cache_.detach(), false);
-    result.second = res;
-    return result;
+  static void* operator new(size_t size) {
+    return memory::allocate(size);
   }
 
-private:
-  intrusive_ptr<storage> cache_;
-};
-
-class memory {
-
-  memory() = delete;
-
-  template <class>
-  friend class basic_memory_cache;
-
-public:
+  static void operator delete(void* ptr, size_t size) noexcept {
+    memory::deallocate(ptr, size);
+  }
 
-  // Allocates storage, initializes a new object, and returns the new instance.
-  template <class T, class... Ts>
-  static T* create(Ts&&... xs) {
-    using embedded_t = embedded<T>;
-    auto mc = get_or_set_cache_map_entry<T>();
-    auto es = mc->new_embedded_storage();
-    auto ptr = reinterpret_cast<embedded_t*>(es.second);
-    new (ptr) embedded_t(std::move(es.first), std::forward<Ts>(xs)...);
+  static void* operator new(size_t, void* ptr) noexcept {
     return ptr;
   }
 
-  static memory_cache* get_cache_map_entry(const std::type_info* tinf);
-
-private:
-
-  static void add_cache_map_entry(const std::type_info* tinf,
-                                  memory_cache* instance);
-
-  template <class T>
-  static inline memory_cache* get_or_set_cache_map_entry() {
-    auto mc = get_cache_map_entry(&typeid(T));
-    if (!mc) {
-      mc = new basic_memory_cache<T>;
-      add_cache_map_entry(&typeid(T), mc);
-    }
-    return mc;
+  static void operator delete(void*, void*) noexcept {
+    // nop
   }
-
 };
 
-#endif // CAF_NO_MEM_MANAGEMENT
-
 } // namespace detail
 } // namespace caf
 
@@ -0,0 +1,104 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_MEMORY_ACCOUNTING_HPP
+#define CAF_DETAIL_MEMORY_ACCOUNTING_HPP
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+
+#include "caf/fwd.hpp"
+#include "caf/optional.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/memory_account.hpp"
+#include "caf/overflow_policy.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Keeps track of the memory accounts of all running actors and of the
+/// system-wide total. Mailboxes switch to the configured budget policy for
+/// new messages while the total exceeds the configured budget.
+class memory_accounting {
+public:
+  explicit memory_accounting(actor_system& sys);
+
+  ~memory_accounting();
+
+  memory_accounting(const memory_accounting&) = delete;
+  memory_accounting& operator=(const memory_accounting&) = delete;
+
+  /// Returns whether actors charge messages to memory accounts.
+  inline bool enabled() const {
+    return enabled_;
+  }
+
+  /// Returns the system-wide budget in bytes or 0 if unlimited.
+  inline size_t budget() const {
+    return budget_;
+  }
+
+  /// Returns the policy for messages that arrive while the system exceeds
+  /// its budget.
+  inline overflow_policy budget_policy() const {
+    return budget_policy_;
+  }
+
+  /// Returns the number of bytes attributed to all running actors.
+  inline size_t total() const {
+    return total_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns whether the system currently exceeds its budget.
+  inline bool over_budget() const {
+    return budget_ > 0 && total() > budget_;
+  }
+
+  /// Blocks the calling thread until the system no longer exceeds its budget.
+  void await_budget() const;
+
+  /// Creates and registers a new account for the actor `aid`. Returns
+  /// `nullptr` if memory accounting is disabled.
+  intrusive_ptr<memory_account> make_account(actor_id aid);
+
+  /// Removes the account of a terminated actor and releases its state.
+  void erase(actor_id aid);
+
+  /// Returns snapshots for the `n` actors with the largest totals in
+  /// descending order.
+  std::vector<memory_stats> top(size_t n);
+
+  /// Returns a snapshot for the actor `aid` if it is still running.
+  optional<memory_stats> snapshot(actor_id aid);
+
+private:
+  bool enabled_;
+  size_t budget_;
+  overflow_policy budget_policy_;
+  std::atomic<size_t> total_;
+  std::mutex mtx_;
+  std::unordered_map<actor_id, intrusive_ptr<memory_account>> entries_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_MEMORY_ACCOUNTING_HPP
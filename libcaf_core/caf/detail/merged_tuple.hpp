@@ -50,6 +50,8 @@ public:
 
   cow_ptr copy() const override;
 
+  size_t memory_footprint() const noexcept override;
+
   // -- overridden modifiers of type_erased_tuple ------------------------------
 
   void* get_mutable(size_t pos) override;
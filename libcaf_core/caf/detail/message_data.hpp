@@ -20,9 +20,13 @@
 #ifndef CAF_DETAIL_MESSAGE_DATA_HPP
 #define CAF_DETAIL_MESSAGE_DATA_HPP
 
+#include <new>
 #include <string>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <typeinfo>
+#include <type_traits>
 
 
 #include "caf/fwd.hpp"
@@ -31,12 +35,14 @@
 #include "caf/intrusive_ptr.hpp"
 #include "caf/type_erased_tuple.hpp"
 
+#include "caf/detail/memory.hpp"
 #include "caf/detail/type_list.hpp"
 
 namespace caf {
 namespace detail {
 
-class message_data : public ref_counted, public type_erased_tuple {
+class message_data : public ref_counted, public type_erased_tuple,
+                     public slab_allocated {
 public:
   // -- nested types -----------------------------------------------------------
 
@@ -53,46 +59,124 @@ public:
 
   virtual cow_ptr copy() const = 0;
 
+  /// Returns the number of bytes this object occupies, not counting memory
+  /// owned by the stored values. Used for memory accounting.
+  virtual size_t memory_footprint() const noexcept = 0;
+
   // -- observers --------------------------------------------------------------
 
   using type_erased_tuple::copy;
 
+  /// Copies this object into `storage`, which provides enough space for the
+  /// dynamic type. Only types that `cow_ptr` stores inline implement this
+  /// member function, the default implementation returns `nullptr`.
+  virtual message_data* copy_to(void* storage) const noexcept;
+
   bool shared() const noexcept override;
 };
 
+/// A copy-on-write pointer to message data. Small message data is stored
+/// inline instead of on the heap. Copies of inline data are deep copies,
+/// i.e., inline data is never shared.
 class message_data::cow_ptr {
 public:
-  // -- constructors, destructors, and assignment operators ------------------
+  // -- constants ------------------------------------------------------------
 
-  cow_ptr() noexcept = default;
-  cow_ptr(cow_ptr&&) noexcept = default;
-  cow_ptr(const cow_ptr&) noexcept = default;
-  cow_ptr& operator=(cow_ptr&&) noexcept = default;
-  cow_ptr& operator=(const cow_ptr&) noexcept = default;
+  /// Maximum size of message data that is stored inline.
+  static constexpr size_t inline_size = 64;
+
+private:
+  using storage_type =
+    typename std::aligned_storage<inline_size, alignof(void*)>::type;
 
+public:
+  // -- nested types ---------------------------------------------------------
+
+  /// Evaluates to `true` if `T` fits into the inline storage.
   template <class T>
-  cow_ptr(intrusive_ptr<T> p) noexcept : ptr_(std::move(p)) {
+  struct fits_inline
+      : std::integral_constant<bool, sizeof(T) <= inline_size
+                                     && alignof(T) <= alignof(storage_type)> {
+    // no content
+  };
+
+  // -- constructors, destructors, and assignment operators ------------------
+
+  cow_ptr() noexcept : ptr_(nullptr) {
     // nop
   }
 
-  inline cow_ptr(message_data* ptr, bool add_ref) noexcept
-      : ptr_(ptr, add_ref) {
+  cow_ptr(cow_ptr&& other) noexcept : ptr_(nullptr) {
+    move_from(other);
+  }
+
+  cow_ptr(const cow_ptr& other) noexcept : ptr_(nullptr) {
+    copy_from(other);
+  }
+
+  cow_ptr& operator=(cow_ptr&& other) noexcept {
+    if (this != &other) {
+      // `other` might be part of our content
+      cow_ptr tmp{std::move(other)};
+      destroy();
+      move_from(tmp);
+    }
+    return *this;
+  }
+
+  cow_ptr& operator=(const cow_ptr& other) noexcept {
+    if (this != &other) {
+      cow_ptr tmp{other};
+      destroy();
+      move_from(tmp);
+    }
+    return *this;
+  }
+
+  ~cow_ptr() {
+    destroy();
+  }
+
+  template <class T>
+  cow_ptr(intrusive_ptr<T> p) noexcept : ptr_(p.detach()) {
     // nop
   }
 
+  inline cow_ptr(message_data* ptr, bool add_ref) noexcept : ptr_(ptr) {
+    if (ptr != nullptr && add_ref)
+      intrusive_ptr_add_ref(ptr);
+  }
+
   // -- modifiers ------------------------------------------------------------
 
+  /// Replaces the content with a new `T` in the inline storage.
+  template <class T, class... Ts>
+  void emplace_inline(Ts&&... xs) {
+    static_assert(fits_inline<T>::value, "T does not fit into inline storage");
+    destroy();
+    ptr_ = new (&storage_) T(std::forward<Ts>(xs)...);
+  }
+
   inline void swap(cow_ptr& other) noexcept {
-    ptr_.swap(other.ptr_);
+    if (!is_inline() && !other.is_inline()) {
+      std::swap(ptr_, other.ptr_);
+      return;
+    }
+    cow_ptr tmp{std::move(other)};
+    other = std::move(*this);
+    *this = std::move(tmp);
   }
 
   inline void reset(message_data* p = nullptr, bool add_ref = true) noexcept {
-    ptr_.reset(p, add_ref);
+    if (p != nullptr && add_ref)
+      intrusive_ptr_add_ref(p);
+    destroy();
+    ptr_ = p;
   }
 
-  inline message_data* release() noexcept {
-    return ptr_.detach();
-  }
+  /// Transfers ownership of the content to the caller. Moves inline data to
+  /// the heap first.
+  message_data* release() noexcept;
 
   inline void unshare() {
     static_cast<void>(get_unshared());
@@ -109,13 +193,13 @@ public:
   /// Returns the raw pointer. Callers are responsible for unsharing
   /// the content if necessary.
   inline message_data* raw_ptr() {
-    return ptr_.get();
+    return ptr_;
   }
 
   // -- observers ------------------------------------------------------------
 
   inline const message_data* operator->() const noexcept {
-    return ptr_.get();
+    return ptr_;
   }
 
   inline const message_data& operator*() const noexcept {
@@ -123,16 +207,55 @@ public:
   }
 
   inline explicit operator bool() const noexcept {
-    return static_cast<bool>(ptr_);
+    return ptr_ != nullptr;
   }
 
   inline message_data* get() const noexcept {
-    return ptr_.get();
+    return ptr_;
+  }
+
+  /// Returns whether the content resides in the inline storage.
+  inline bool is_inline() const noexcept {
+    auto x = reinterpret_cast<uintptr_t>(ptr_);
+    auto first = reinterpret_cast<uintptr_t>(&storage_);
+    return x >= first && x < first + inline_size;
   }
 
 private:
   message_data* get_unshared();
-  intrusive_ptr<message_data> ptr_;
+
+  void copy_from(const cow_ptr& other) noexcept {
+    if (other.is_inline()) {
+      ptr_ = other.ptr_->copy_to(&storage_);
+    } else {
+      ptr_ = other.ptr_;
+      if (ptr_ != nullptr)
+        intrusive_ptr_add_ref(ptr_);
+    }
+  }
+
+  void move_from(cow_ptr& other) noexcept {
+    if (other.is_inline()) {
+      ptr_ = other.ptr_->copy_to(&storage_);
+      other.destroy();
+    } else {
+      ptr_ = other.ptr_;
+      other.ptr_ = nullptr;
+    }
+  }
+
+  void destroy() noexcept {
+    if (ptr_ == nullptr)
+      return;
+    if (is_inline())
+      ptr_->~message_data();
+    else
+      intrusive_ptr_release(ptr_);
+    ptr_ = nullptr;
+  }
+
+  message_data* ptr_;
+  storage_type storage_;
 };
 
 } // namespace detail
@@ -0,0 +1,136 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_MPMC_RING_HPP
+#define CAF_DETAIL_MPMC_RING_HPP
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace caf {
+namespace detail {
+
+/*
+ * A bounded, lock-free multi-producer multi-consumer FIFO queue based on
+ * Dmitry Vyukov's "Bounded MPMC queue". Each cell carries a sequence number
+ * that tells producers and consumers whether the cell is ready for them,
+ * i.e., `push` and `pop` only need a single CAS on the shared tail or head
+ * position and never allocate. The capacity is fixed at construction and
+ * rounded up to the next power of two.
+ */
+template <class T>
+class mpmc_ring {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using pointer = value_type*;
+
+  explicit mpmc_ring(size_type init_capacity) : head_(0), tail_(0) {
+    size_type cap = 2;
+    while (cap < init_capacity)
+      cap <<= 1;
+    mask_ = cap - 1;
+    cells_.reset(new cell[cap]);
+    for (size_type i = 0; i < cap; ++i)
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  mpmc_ring(const mpmc_ring&) = delete;
+  mpmc_ring& operator=(const mpmc_ring&) = delete;
+
+  /// Appends `value` to the queue unless the queue is full.
+  /// @returns `false` if the queue is full, `true` otherwise.
+  bool push(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto pos = tail_.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+      c = &cells_[pos & mask_];
+      auto seq = c->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        // the cell still holds a value from the previous round
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    c->value = value;
+    c->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Removes the oldest element from the queue.
+  /// @returns `nullptr` if the queue is empty, the element otherwise.
+  pointer pop() {
+    auto pos = head_.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+      c = &cells_[pos & mask_];
+      auto seq = c->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        // no producer has filled this cell yet
+        return nullptr;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    auto result = c->value;
+    c->seq.store(pos + mask_ + 1, std::memory_order_release);
+    return result;
+  }
+
+  /// Returns the number of elements the queue can hold.
+  size_type capacity() const {
+    return mask_ + 1;
+  }
+
+private:
+  struct cell {
+    std::atomic<size_type> seq;
+    pointer value;
+  };
+
+  // position of the next pop, shared by all consumers
+  std::atomic<size_type> head_;
+  char pad1_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_type>)];
+  // position of the next push, shared by all producers
+  std::atomic<size_type> tail_;
+  char pad2_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_type>)];
+  size_type mask_;
+  std::unique_ptr<cell[]> cells_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_MPMC_RING_HPP
@@ -0,0 +1,42 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_SET_THREAD_AFFINITY_HPP
+#define CAF_DETAIL_SET_THREAD_AFFINITY_HPP
+
+#include <string>
+#include <vector>
+
+namespace caf {
+namespace detail {
+
+/// Restricts the calling thread to the CPUs in `cpus`. Returns `false`
+/// if the operating system rejects the CPU set or does not support
+/// setting thread affinities.
+bool set_thread_affinity(const std::vector<int>& cpus);
+
+/// Restricts the calling thread to the CPUs in `cpu_list`, which uses the
+/// format of `cpu_topology::parse_cpu_list`, e.g., `0-3,8`. Does nothing
+/// and returns `true` if `cpu_list` is empty.
+bool set_thread_affinity(const std::string& cpu_list);
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_SET_THREAD_AFFINITY_HPP
@@ -0,0 +1,34 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_SET_THREAD_NAME_HPP
+#define CAF_DETAIL_SET_THREAD_NAME_HPP
+
+namespace caf {
+namespace detail {
+
+/// Sets the name of the calling thread as shown by tools such as `top -H`
+/// or `perf`. Operating systems may truncate long names, e.g., Linux
+/// limits thread names to 15 characters.
+void set_thread_name(const char* name);
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_SET_THREAD_NAME_HPP
@@ -23,11 +23,14 @@
 #include "caf/config.hpp"
 
 #include <list>
+#include <array>
 #include <deque>
 #include <mutex>
 #include <atomic>
 #include <memory>
 #include <limits>
+#include <thread>
+#include <chrono>
 #include <condition_variable> // std::cv_status
 
 #include "caf/detail/intrusive_partitioned_list.hpp"
@@ -47,12 +50,22 @@ enum class enqueue_result {
 
   /// Indicates that the enqueue operation failed because the
   /// queue has been closed by the reader.
-  queue_closed
+  queue_closed,
+
+  /// Indicates that the enqueue operation failed because the queue
+  /// reached its capacity. The caller keeps ownership of the element.
+  queue_full
 };
 
-/// An intrusive, thread-safe queue implementation.
-template <class T, class Delete = std::default_delete<T>>
+/// An intrusive, thread-safe queue implementation. Queues with more than one
+/// lane keep a separate stack for each lane and the reader always takes
+/// elements from the highest non-empty lane first, unless configured to
+/// serve lower lanes after a maximum number of elements in a row.
+template <class T, class Delete = std::default_delete<T>,
+          size_t NumLanes = 1>
 class single_reader_queue {
+  static_assert(NumLanes > 0, "a queue needs at least one lane");
+
 public:
   using value_type = T;
   using pointer = value_type*;
@@ -66,32 +79,157 @@ public:
     return take_head();
   }
 
-  /// Tries to enqueue a new element to the mailbox.
+  /// Tries to enqueue a new element to `lane` of the mailbox. Returns
+  /// `queue_full` without taking ownership of `new_element` if the queue is
+  /// bounded and reached its capacity.
+  /// @threadsafe
+  enqueue_result enqueue(pointer new_element, size_t lane = 0) {
+    CAF_ASSERT(new_element != nullptr);
+    CAF_ASSERT(lane < NumLanes);
+    // the counter guarantees that no more than `capacity_` elements can be
+    // in the queue, even with concurrent writers
+    if (capacity_ > 0 && size_.fetch_add(1) >= capacity_) {
+      size_.fetch_sub(1);
+      if (!closed())
+        return enqueue_result::queue_full;
+      delete_(new_element);
+      return enqueue_result::queue_closed;
+    }
+    return lane == 0 ? push(new_element) : push(new_element, lane);
+  }
+
+  /// Enqueues a new element to `lane` regardless of the capacity of this
+  /// queue.
+  /// @threadsafe
+  enqueue_result force_enqueue(pointer new_element, size_t lane = 0) {
+    CAF_ASSERT(new_element != nullptr);
+    CAF_ASSERT(lane < NumLanes);
+    if (capacity_ > 0)
+      size_.fetch_add(1);
+    return lane == 0 ? push(new_element) : push(new_element, lane);
+  }
+
+  /// Enqueues the `n` elements in `[first, last]` to `lane` with a single
+  /// CAS operation. The elements must be linked via `next` from the newest
+  /// element `first` to the oldest element `last`. Returns `queue_full`
+  /// if the queue is bounded and cannot store all `n` elements. The caller
+  /// keeps ownership of all elements unless this returns `success` or
+  /// `unblocked_reader`.
+  /// @threadsafe
+  enqueue_result enqueue_batch(pointer first, pointer last, size_t n,
+                               size_t lane = 0) {
+    CAF_ASSERT(first != nullptr && last != nullptr && n > 0);
+    CAF_ASSERT(lane < NumLanes);
+    if (capacity_ > 0 && size_.fetch_add(n) + n > capacity_) {
+      size_.fetch_sub(n);
+      return closed() ? enqueue_result::queue_closed
+                      : enqueue_result::queue_full;
+    }
+    auto res = lane == 0 ? push_batch(first, last)
+                         : push_batch(first, last, lane);
+    if (capacity_ > 0 && res == enqueue_result::queue_closed)
+      size_.fetch_sub(n);
+    return res;
+  }
+
+  /// Enqueues `new_element` to `lane` of a full queue by dropping the oldest
+  /// element in lane 0 that the reader did not fetch yet. Returns
+  /// `queue_full` without taking ownership of `new_element` if no such
+  /// element exists. Blocks other writers to lane 0 and the reader while
+  /// traversing the stack of lane 0, i.e., this member function is not
+  /// lock-free. Hands the dropped element to the caller via `displaced`
+  /// instead of deleting it if `displaced != nullptr`.
   /// @threadsafe
-  enqueue_result enqueue(pointer new_element) {
+  enqueue_result displace_oldest(pointer new_element, size_t lane = 0,
+                                 pointer* displaced = nullptr) {
     CAF_ASSERT(new_element != nullptr);
+    CAF_ASSERT(lane < NumLanes);
     pointer e = stack_.load();
     for (;;) {
+      while (e == writer_locked_dummy())
+        e = stack_.load();
       if (!e) {
-        // if tail is nullptr, the queue has been closed
         delete_(new_element);
         return enqueue_result::queue_closed;
       }
-      // a dummy is never part of a non-empty list
-      new_element->next = is_dummy(e) ? nullptr : e;
-      if (stack_.compare_exchange_strong(e, new_element)) {
-        return  (e == reader_blocked_dummy()) ? enqueue_result::unblocked_reader
-                                              : enqueue_result::success;
-      }
-      // continue with new value of e
+      if (is_dummy(e))
+        return enqueue_result::queue_full;
+      if (stack_.compare_exchange_weak(e, writer_locked_dummy()))
+        break;
     }
+    // we have exclusive access to the stack, its last element is the oldest
+    pointer oldest = e;
+    pointer prev = nullptr;
+    while (oldest->next != nullptr) {
+      prev = oldest;
+      oldest = oldest->next;
+    }
+    if (prev != nullptr)
+      prev->next = nullptr;
+    if (lane == 0) {
+      new_element->next = prev != nullptr ? e : nullptr;
+      stack_.store(new_element);
+      dispose(oldest, displaced);
+      return enqueue_result::success;
+    }
+    stack_.store(prev != nullptr ? e : stack_empty_dummy());
+    dispose(oldest, displaced);
+    return push(new_element, lane);
+  }
+
+  /// Blocks the caller until the queue has room for at least one element or
+  /// the reader closed the queue. Polls with exponential backoff, since the
+  /// reader never signals writers.
+  /// @threadsafe
+  void await_capacity() {
+    std::chrono::microseconds delay{1};
+    std::chrono::microseconds max_delay{1000};
+    while (capacity_ > 0 && size_.load() >= capacity_ && !closed()) {
+      std::this_thread::sleep_for(delay);
+      if (delay < max_delay)
+        delay *= 2;
+    }
+  }
+
+  /// Sets the maximum number of elements in this queue, whereas 0 means
+  /// unbounded. Includes elements the reader did not take yet but excludes
+  /// elements in the cache.
+  /// @warning Call only before the first enqueue.
+  void capacity(size_t x) {
+    capacity_ = x;
+  }
+
+  /// Returns the maximum number of elements in this queue or 0 if unbounded.
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  /// Returns the number of elements the reader did not take yet. Always
+  /// returns 0 for unbounded queues.
+  /// @threadsafe
+  size_t size() const {
+    return size_.load();
+  }
+
+  /// Sets how many elements the reader takes in a row from higher lanes
+  /// while a lower lane has pending elements, whereas 0 means that higher
+  /// lanes always take precedence.
+  /// @warning Call only from the reader (owner).
+  void max_streak(size_t x) {
+    max_streak_ = x;
+  }
+
+  /// Returns how many elements the reader takes in a row from higher lanes
+  /// while a lower lane has pending elements.
+  size_t max_streak() const {
+    return max_streak_;
   }
 
   /// Queries whether there is new data to read, i.e., whether the next
   /// call to {@link try_pop} would succeeed.
   /// @pre !closed()
   bool can_fetch_more() {
-    if (head_ != nullptr)
+    if (head_ != nullptr || !lanes_empty())
       return true;
     auto ptr = stack_.load();
     CAF_ASSERT(ptr != nullptr);
@@ -102,7 +240,7 @@ public:
   /// @warning Call only from the reader (owner).
   bool empty() {
     CAF_ASSERT(!closed());
-    return cache_.empty() && !head_ && is_dummy(stack_.load());
+    return cache_.empty() && !can_fetch_more();
   }
 
   /// Queries whether this has been closed.
@@ -119,8 +257,14 @@ public:
   /// Tries to set this queue from state `empty` to state `blocked`.
   bool try_block() {
     auto e = stack_empty_dummy();
-    return stack_.compare_exchange_strong(e, reader_blocked_dummy());
-    //return res || e == reader_blocked_dummy();
+    if (!stack_.compare_exchange_strong(e, reader_blocked_dummy()))
+      return false;
+    if (lanes_empty())
+      return true;
+    // a writer added an element to another lane before it could observe
+    // the blocked state, the reader remains blocked if a writer already
+    // unblocked it, since the writer is going to resume the reader
+    return !try_unblock();
   }
 
   /// Tries to set this queue from state `blocked` to state `empty`.
@@ -144,11 +288,27 @@ public:
     clear_cached_elements(f);
     if (!blocked() && fetch_new_data(nullptr))
       clear_cached_elements(f);
+    for (auto& x : lanes_) {
+      auto e = x.stack.exchange(lane_closed_dummy());
+      if (e != lane_closed_dummy())
+        clear_list(e, f);
+      clear_list(x.head, f);
+      x.head = nullptr;
+    }
     cache_.clear(f);
   }
 
-  single_reader_queue() : head_(nullptr) {
+  single_reader_queue()
+      : size_(0),
+        capacity_(0),
+        head_(nullptr),
+        max_streak_(0),
+        streak_(0) {
     stack_ = stack_empty_dummy();
+    for (auto& x : lanes_) {
+      x.stack = nullptr;
+      x.head = nullptr;
+    }
   }
 
   ~single_reader_queue() {
@@ -158,21 +318,20 @@ public:
 
   size_t count(size_t max_count = std::numeric_limits<size_t>::max()) {
     size_t res = cache_.count(max_count);
-    if (res >= max_count)
-      return res;
-    fetch_new_data();
-    auto ptr = head_;
-    while (ptr && res < max_count) {
-      ptr = ptr->next;
-      ++res;
+    for (size_t i = 0; i < NumLanes && res < max_count; ++i) {
+      fetch_all(i);
+      auto ptr = head_of(i);
+      while (ptr && res < max_count) {
+        ptr = ptr->next;
+        ++res;
+      }
     }
     return res;
   }
 
   pointer peek() {
-    if (head_ != nullptr || fetch_new_data())
-      return head_;
-    return nullptr;
+    auto i = next_lane(false);
+    return i < NumLanes ? head_of(i) : nullptr;
   }
 
   // note: the cache is intended to be used by the owner, the queue itself
@@ -202,6 +361,10 @@ public:
       case enqueue_result::queue_closed:
         // actor no longer alive
         return false;
+      case enqueue_result::queue_full:
+        // queue is bounded and full
+        delete_(new_element);
+        return false;
     }
     // should be unreachable
     CAF_CRITICAL("invalid result of enqueue()");
@@ -237,15 +400,189 @@ private:
   // exposed to "outside" access
   std::atomic<pointer> stack_;
 
+  // number of elements not taken by the reader, only used if bounded
+  std::atomic<size_t> size_;
+
+  // maximum number of elements or 0 if unbounded
+  size_t capacity_;
+
   // accessed only by the owner
   pointer head_;
   deleter_type delete_;
   intrusive_partitioned_list<value_type, deleter_type> cache_;
 
+  // stacks and reader-side lists of all lanes except lane 0, which
+  // uses `stack_` and `head_`
+  struct lane {
+    std::atomic<pointer> stack;
+    pointer head;
+  };
+
+  std::array<lane, NumLanes - 1> lanes_;
+
+  // maximum number of elements taken in a row from higher lanes while a
+  // lower lane has pending elements, 0 for strict priority
+  size_t max_streak_;
+
+  // number of elements taken in a row from higher lanes
+  size_t streak_;
+
+  // pushes `new_element` to the stack of new elements
+  enqueue_result push(pointer new_element) {
+    pointer e = stack_.load();
+    for (;;) {
+      while (e == writer_locked_dummy())
+        e = stack_.load();
+      if (!e) {
+        // if tail is nullptr, the queue has been closed
+        delete_(new_element);
+        return enqueue_result::queue_closed;
+      }
+      // a dummy is never part of a non-empty list
+      new_element->next = is_dummy(e) ? nullptr : e;
+      if (stack_.compare_exchange_strong(e, new_element)) {
+        return  (e == reader_blocked_dummy()) ? enqueue_result::unblocked_reader
+                                              : enqueue_result::success;
+      }
+      // continue with new value of e
+    }
+  }
+
+  // pushes the chain `[first, last]` to the stack of new elements
+  enqueue_result push_batch(pointer first, pointer last) {
+    pointer e = stack_.load();
+    for (;;) {
+      while (e == writer_locked_dummy())
+        e = stack_.load();
+      if (!e)
+        return enqueue_result::queue_closed;
+      last->next = is_dummy(e) ? nullptr : e;
+      if (stack_.compare_exchange_strong(e, first)) {
+        return  (e == reader_blocked_dummy()) ? enqueue_result::unblocked_reader
+                                              : enqueue_result::success;
+      }
+    }
+  }
+
+  // pushes the chain `[first, last]` to the stack of `lane`
+  enqueue_result push_batch(pointer first, pointer last, size_t lane) {
+    CAF_ASSERT(lane > 0 && lane < NumLanes);
+    auto& x = lanes_[lane - 1].stack;
+    pointer e = x.load();
+    for (;;) {
+      if (e == lane_closed_dummy())
+        return enqueue_result::queue_closed;
+      last->next = e;
+      if (x.compare_exchange_weak(e, first))
+        break;
+    }
+    e = reader_blocked_dummy();
+    if (stack_.compare_exchange_strong(e, stack_empty_dummy()))
+      return enqueue_result::unblocked_reader;
+    return enqueue_result::success;
+  }
+
+  // pushes `new_element` to the stack of `lane` and wakes up a blocked
+  // reader, since the reader blocks on the stack of lane 0
+  enqueue_result push(pointer new_element, size_t lane) {
+    CAF_ASSERT(lane > 0 && lane < NumLanes);
+    auto& x = lanes_[lane - 1].stack;
+    pointer e = x.load();
+    for (;;) {
+      if (e == lane_closed_dummy()) {
+        delete_(new_element);
+        return enqueue_result::queue_closed;
+      }
+      new_element->next = e;
+      if (x.compare_exchange_weak(e, new_element))
+        break;
+    }
+    e = reader_blocked_dummy();
+    if (stack_.compare_exchange_strong(e, stack_empty_dummy()))
+      return enqueue_result::unblocked_reader;
+    return enqueue_result::success;
+  }
+
+  // checks whether all lanes except lane 0 are empty
+  bool lanes_empty() {
+    for (auto& x : lanes_)
+      if (x.head != nullptr || x.stack.load() != nullptr)
+        return false;
+    return true;
+  }
+
+  // returns the reader-side list of `lane`
+  pointer& head_of(size_t lane) {
+    return lane == 0 ? head_ : lanes_[lane - 1].head;
+  }
+
+  // makes sure the reader-side list of `lane` is not empty if possible
+  bool lane_ready(size_t lane) {
+    if (lane == 0)
+      return head_ != nullptr || fetch_new_data();
+    auto& x = lanes_[lane - 1];
+    if (x.head != nullptr)
+      return true;
+    auto e = x.stack.exchange(nullptr);
+    CAF_ASSERT(e != lane_closed_dummy());
+    while (e) {
+      auto next = e->next;
+      e->next = x.head;
+      x.head = e;
+      e = next;
+    }
+    return x.head != nullptr;
+  }
+
+  // moves all new elements of `lane` to the end of its reader-side list
+  void fetch_all(size_t lane) {
+    auto& x = head_of(lane);
+    auto old = x;
+    x = nullptr;
+    lane_ready(lane);
+    if (old == nullptr)
+      return;
+    auto tail = old;
+    while (tail->next != nullptr)
+      tail = tail->next;
+    tail->next = x;
+    x = old;
+  }
+
+  // returns the lane for the next element or `NumLanes` if all lanes are
+  // empty, updates the current streak only if `consume == true`
+  size_t next_lane(bool consume) {
+    size_t first = NumLanes - 1;
+    while (first > 0 && !lane_ready(first))
+      --first;
+    if (first == 0)
+      return lane_ready(0) ? 0 : NumLanes;
+    if (max_streak_ == 0)
+      return first;
+    for (size_t i = 0; i < first; ++i) {
+      if (lane_ready(i)) {
+        if (streak_ >= max_streak_) {
+          if (consume)
+            streak_ = 0;
+          return i;
+        }
+        if (consume)
+          ++streak_;
+        return first;
+      }
+    }
+    if (consume)
+      streak_ = 0;
+    return first;
+  }
+
   // atomically sets stack_ back and enqueues all elements to the cache
   bool fetch_new_data(pointer end_ptr) {
     CAF_ASSERT(!end_ptr || end_ptr == stack_empty_dummy());
     pointer e = stack_.load();
+    // wait for a writer dropping the oldest element
+    while (e == writer_locked_dummy())
+      e = stack_.load();
     // must not be called on a closed queue
     CAF_ASSERT(e != nullptr);
     // fetching data while blocked is an error
@@ -272,6 +609,8 @@ private:
         return true;
       }
       // next iteration
+      while (e == writer_locked_dummy())
+        e = stack_.load();
     }
     return false;
   }
@@ -281,21 +620,37 @@ private:
   }
 
   pointer take_head() {
-    if (head_ != nullptr || fetch_new_data()) {
-      auto result = head_;
-      head_ = head_->next;
-      return result;
-    }
-    return nullptr;
+    auto i = next_lane(true);
+    if (i == NumLanes)
+      return nullptr;
+    auto& x = head_of(i);
+    auto result = x;
+    x = x->next;
+    if (capacity_ > 0)
+      size_.fetch_sub(1);
+    return result;
   }
 
   template <class F>
   void clear_cached_elements(const F& f) {
-    while (head_) {
-      auto next = head_->next;
-      f(*head_);
-      delete_(head_);
-      head_ = next;
+    clear_list(head_, f);
+    head_ = nullptr;
+  }
+
+  void dispose(pointer x, pointer* out) {
+    if (out != nullptr)
+      *out = x;
+    else
+      delete_(x);
+  }
+
+  template <class F>
+  void clear_list(pointer x, const F& f) {
+    while (x) {
+      auto next = x->next;
+      f(*x);
+      delete_(x);
+      x = next;
     }
   }
 
@@ -311,8 +666,23 @@ private:
                                      + static_cast<intptr_t>(sizeof(void*)));
   }
 
+  pointer writer_locked_dummy() {
+    // marks exclusive access of a writer in `displace_oldest`
+    auto offset = static_cast<intptr_t>(sizeof(void*) * 2);
+    return reinterpret_cast<pointer>(reinterpret_cast<intptr_t>(this)
+                                     + offset);
+  }
+
+  pointer lane_closed_dummy() {
+    // marks closed lanes, i.e., lanes that no longer accept elements
+    auto offset = static_cast<intptr_t>(sizeof(void*) * 3);
+    return reinterpret_cast<pointer>(reinterpret_cast<intptr_t>(this)
+                                     + offset);
+  }
+
   bool is_dummy(pointer ptr) {
-    return ptr == stack_empty_dummy() || ptr == reader_blocked_dummy();
+    return ptr == stack_empty_dummy() || ptr == reader_blocked_dummy()
+           || ptr == writer_locked_dummy();
   }
 };
 
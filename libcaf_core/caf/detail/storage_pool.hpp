@@ -0,0 +1,72 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_STORAGE_POOL_HPP
+#define CAF_DETAIL_STORAGE_POOL_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "caf/detail/shared_spinlock.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Recycles memory blocks of a fixed size. Any thread may return blocks to
+/// the pool, regardless of which thread allocated them.
+class storage_pool {
+public:
+  /// Default for the maximum number of cached blocks.
+  static constexpr size_t default_max_cached = 4096;
+
+  storage_pool(size_t block_size, size_t max_cached = default_max_cached);
+
+  ~storage_pool();
+
+  storage_pool(const storage_pool&) = delete;
+  storage_pool& operator=(const storage_pool&) = delete;
+
+  /// Returns a block of `block_size()` bytes.
+  void* allocate();
+
+  /// Appends `n` blocks of `block_size()` bytes to `xs`.
+  void allocate(size_t n, std::vector<void*>& xs);
+
+  /// Returns `ptr` to the pool.
+  void deallocate(void* ptr) noexcept;
+
+  /// Returns the size of all blocks.
+  inline size_t block_size() const {
+    return block_size_;
+  }
+
+  /// Returns the number of cached blocks.
+  size_t cached() const;
+
+private:
+  size_t block_size_;
+  size_t max_cached_;
+  mutable shared_spinlock mtx_;
+  std::vector<void*> free_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_STORAGE_POOL_HPP
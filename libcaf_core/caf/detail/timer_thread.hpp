@@ -0,0 +1,182 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_TIMER_THREAD_HPP
+#define CAF_DETAIL_TIMER_THREAD_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+
+#include "caf/fwd.hpp"
+#include "caf/message.hpp"
+#include "caf/duration.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/message_id.hpp"
+#include "caf/actor_control_block.hpp"
+
+#include "caf/detail/timing_wheel.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Base class for entries of the clock thread.
+class clock_entry : public timing_wheel_entry {
+public:
+  clock_entry();
+
+  ~clock_entry() override;
+
+  /// Called by the clock thread after the entry reached its deadline. The
+  /// entry either reschedules itself in `wheel` or releases itself.
+  virtual void expire(timing_wheel& wheel) = 0;
+
+  /// Called for entries that remain pending at shutdown.
+  virtual void dispose() = 0;
+
+  /// Tick for scheduling this entry after the clock thread fetched it.
+  uint64_t tick;
+
+  /// Link to the next element in the stack of new entries.
+  clock_entry* next_pending;
+};
+
+/// A timeout of a `behavior` that its actor re-arms after processing messages.
+/// Re-arming with a later deadline only updates the fields of the entry, the
+/// clock thread reschedules the entry once it reaches its previous deadline.
+/// Hence, an actor creates a `timeout_msg` only if the timeout actually
+/// expires rather than once per re-arm.
+class behavior_timeout : public clock_entry, public ref_counted {
+public:
+  explicit behavior_timeout(actor_control_block* owner);
+
+  ~behavior_timeout() override;
+
+  void expire(timing_wheel& wheel) override;
+
+  void dispose() override;
+
+  /// The actor receiving the `timeout_msg`. The owner keeps this entry alive
+  /// and the clock thread holds a strong reference while `queued == true`.
+  actor_control_block* owner;
+
+  /// Tick at which the clock thread delivers the timeout.
+  std::atomic<uint64_t> due;
+
+  /// ID of the timeout message or 0 if disarmed.
+  std::atomic<uint32_t> id;
+
+  /// Stores whether the clock thread holds a reference to this entry.
+  std::atomic<bool> queued;
+
+  /// Stores whether the owner dropped this entry.
+  std::atomic<bool> abandoned;
+
+  /// Largest tick ever stored to `due`. Only accessed by the owner.
+  uint64_t max_due;
+
+private:
+  // drops the references of the clock thread
+  void release();
+};
+
+/// Delivers delayed messages from a dedicated clock thread. Producers push
+/// new timeouts to a lock-free stack and the clock thread moves them to a
+/// `timing_wheel` with a resolution of one millisecond. Messages are never
+/// delivered before their deadline and messages with equal deadlines arrive
+/// in the order they were scheduled.
+class timer_thread {
+public:
+  using clock_type = std::chrono::steady_clock;
+
+  using resolution = std::chrono::milliseconds;
+
+  timer_thread();
+
+  ~timer_thread();
+
+  timer_thread(const timer_thread&) = delete;
+  timer_thread& operator=(const timer_thread&) = delete;
+
+  /// Starts the clock thread.
+  void start(actor_system& sys);
+
+  /// Stops the clock thread and drops all pending messages.
+  void stop();
+
+  /// Delivers `msg` from `from` to `to` after `rel_time`.
+  void schedule(const duration& rel_time, strong_actor_ptr from,
+                strong_actor_ptr to, message_id mid, message msg);
+
+  /// Arms the behavior timeout `x` of `owner` to deliver `timeout_msg{tid}`
+  /// after `rel_time`. Replaces `x` with a new entry if the previous entry
+  /// might expire later than `rel_time`.
+  void arm(intrusive_ptr<behavior_timeout>& x, actor_control_block* owner,
+           const duration& rel_time, uint32_t tid);
+
+  /// Disarms the behavior timeout `x` without deallocating it.
+  static void disarm(behavior_timeout& x);
+
+  /// Disarms the behavior timeout `x` and releases the owner's reference.
+  static void abandon(intrusive_ptr<behavior_timeout>& x);
+
+private:
+  class delayed_msg : public clock_entry {
+  public:
+    delayed_msg(uint64_t t, strong_actor_ptr x, strong_actor_ptr y,
+                message_id z, message w);
+
+    void expire(timing_wheel& wheel) override;
+
+    void dispose() override;
+
+    strong_actor_ptr from;
+    strong_actor_ptr to;
+    message_id mid;
+    message msg;
+  };
+
+  void run(actor_system& sys);
+
+  // hands `x` over to the clock thread
+  void push(clock_entry* x);
+
+  // moves all entries from the stack of new timeouts into the wheel
+  void fetch_pending();
+
+  // converts `x` to a tick of the wheel, deadlines round up to never deliver
+  // a message early while the current time rounds down
+  uint64_t to_tick(clock_type::time_point x, bool round_up) const;
+
+  clock_type::time_point epoch_;
+  std::atomic<clock_entry*> pending_;
+  timing_wheel wheel_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool stopped_;
+  std::thread thread_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_TIMER_THREAD_HPP
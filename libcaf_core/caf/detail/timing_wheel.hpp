@@ -0,0 +1,207 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_TIMING_WHEEL_HPP
+#define CAF_DETAIL_TIMING_WHEEL_HPP
+
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+namespace caf {
+namespace detail {
+
+class timing_wheel;
+
+/// Base class for entries of a `timing_wheel`.
+class timing_wheel_entry {
+public:
+  friend class timing_wheel;
+
+  timing_wheel_entry();
+
+  virtual ~timing_wheel_entry();
+
+  /// Returns whether this entry is currently stored in a wheel.
+  inline bool scheduled() const {
+    return list_ != nullptr;
+  }
+
+  /// Returns the tick at which this entry expires.
+  inline uint64_t deadline() const {
+    return deadline_;
+  }
+
+private:
+  struct list;
+
+  timing_wheel_entry* prev_;
+  timing_wheel_entry* next_;
+  list* list_;
+  uint64_t deadline_;
+};
+
+/// An intrusive list of entries, i.e., a single slot of a `timing_wheel`.
+struct timing_wheel_entry::list {
+  timing_wheel_entry* head;
+  timing_wheel_entry* tail;
+  size_t level;
+};
+
+/// A hierarchical timing wheel with `num_levels` levels of `num_slots` slots
+/// each. Level 0 has a resolution of one tick and each further level is
+/// `num_slots` times coarser than the previous one. Scheduling and canceling
+/// an entry runs in constant time. Advancing the wheel moves entries of a
+/// coarse slot to finer levels once the slot becomes current, i.e., each
+/// entry moves at most `num_levels - 1` times before it expires. Entries
+/// beyond the range of the top level wait in an overflow list.
+/// @note This class is not thread-safe and does not own its entries.
+class timing_wheel {
+public:
+  static constexpr size_t slot_bits = 8;
+
+  static constexpr size_t num_slots = size_t{1} << slot_bits;
+
+  static constexpr size_t num_levels = 4;
+
+  static constexpr uint64_t never = std::numeric_limits<uint64_t>::max();
+
+  explicit timing_wheel(uint64_t now = 0);
+
+  timing_wheel(const timing_wheel&) = delete;
+  timing_wheel& operator=(const timing_wheel&) = delete;
+
+  /// Returns the current tick.
+  inline uint64_t now() const {
+    return now_;
+  }
+
+  /// Returns the number of scheduled entries.
+  inline size_t size() const {
+    return size_;
+  }
+
+  /// Returns whether no entry is scheduled.
+  inline bool empty() const {
+    return size_ == 0;
+  }
+
+  /// Schedules `x` to expire at tick `deadline`. Entries with deadlines in
+  /// the past expire on the next call to `advance`.
+  /// @pre `!x->scheduled()`
+  void schedule(timing_wheel_entry* x, uint64_t deadline);
+
+  /// Removes `x` from the wheel.
+  /// @pre `x->scheduled()`
+  void cancel(timing_wheel_entry* x);
+
+  /// Returns a tick no later than the deadline of the next expiring entry or
+  /// `never` if the wheel is empty. The result is exact if the entry is
+  /// scheduled in the current rotation of level 0.
+  uint64_t next_expiry() const;
+
+  /// Advances the wheel to tick `t` and calls `f` for all expired entries in
+  /// order of their deadlines. Entries are removed from the wheel before
+  /// calling `f`, i.e., `f` may delete or reschedule them.
+  template <class F>
+  void advance(uint64_t t, F f) {
+    expire(due_, f);
+    while (now_ < t) {
+      if (size_ == 0) {
+        now_ = t;
+        return;
+      }
+      // fast-forward to the end of the current rotation of the finest level
+      // with entries, since no tick before can expire or cascade an entry
+      size_t level = 0;
+      while (level < num_levels && level_sizes_[level] == 0)
+        ++level;
+      if (level > 0) {
+        auto last = now_ | ((uint64_t{1} << (slot_bits * level)) - 1);
+        now_ = last < t ? last : t;
+        if (now_ == t)
+          return;
+      }
+      ++now_;
+      cascade();
+      expire(due_, f);
+      expire(slots_[0][now_ & (num_slots - 1)], f);
+    }
+  }
+
+  /// Removes all entries from the wheel and calls `f` for each of them.
+  template <class F>
+  void clear(F f) {
+    expire(due_, f);
+    expire(overflow_, f);
+    for (auto& level : slots_)
+      for (auto& slot : level)
+        expire(slot, f);
+  }
+
+private:
+  using list = timing_wheel_entry::list;
+
+  void push_back(list& xs, timing_wheel_entry* x);
+
+  // moves entries of coarse slots that became current to finer levels
+  void cascade();
+
+  // moves all entries of `xs` back into the wheel
+  void reinsert(list& xs);
+
+  // calls `f` for each entry of `xs` after removing all entries from `xs`
+  template <class F>
+  void expire(list& xs, F& f) {
+    auto x = xs.head;
+    if (x == nullptr)
+      return;
+    size_t n = 0;
+    for (auto i = x; i != nullptr; i = i->next_) {
+      i->list_ = nullptr;
+      ++n;
+    }
+    size_ -= n;
+    level_sizes_[xs.level] -= n;
+    xs.head = nullptr;
+    xs.tail = nullptr;
+    while (x != nullptr) {
+      auto next = x->next_;
+      x->prev_ = nullptr;
+      x->next_ = nullptr;
+      f(x);
+      x = next;
+    }
+  }
+
+  uint64_t now_;
+  size_t size_;
+  // number of entries per level, overflow and due entries count as one level
+  size_t level_sizes_[num_levels + 1];
+  // entries with deadlines at or before the current tick
+  list due_;
+  // entries beyond the range of the top level
+  list overflow_;
+  list slots_[num_levels][num_slots];
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_TIMING_WHEEL_HPP
@@ -20,6 +20,7 @@
 #ifndef CAF_DETAIL_TUPLE_VALS_HPP
 #define CAF_DETAIL_TUPLE_VALS_HPP
 
+#include <array>
 #include <tuple>
 #include <stdexcept>
 
@@ -107,9 +108,7 @@ public:
   tuple_vals_impl(const tuple_vals_impl&) = default;
 
   template <class... Us>
-  tuple_vals_impl(Us&&... xs)
-      : data_(std::forward<Us>(xs)...),
-        types_{{tuple_vals_type_helper<Ts>::get()...}} {
+  tuple_vals_impl(Us&&... xs) : data_(std::forward<Us>(xs)...) {
     // nop
   }
 
@@ -160,7 +159,7 @@ public:
   }
 
   rtti_pair type(size_t pos) const noexcept override {
-    return types_[pos];
+    return types()[pos];
   }
 
   error save(size_t pos, serializer& sink) const override {
@@ -207,8 +206,15 @@ private:
     return const_cast<tuple_vals_impl*>(this);
   }
 
+  // shared by all instances to keep objects small
+  static const std::array<rtti_pair, sizeof...(Ts)>& types() noexcept {
+    static std::array<rtti_pair, sizeof...(Ts)> result{{
+      tuple_vals_type_helper<Ts>::get()...
+    }};
+    return result;
+  }
+
   data_type data_;
-  std::array<rtti_pair, sizeof...(Ts)> types_;
 };
 
 template <class... Ts>
@@ -225,6 +231,14 @@ public:
   message_data::cow_ptr copy() const override {
     return message_data::cow_ptr(new tuple_vals(*this), false);
   }
+
+  message_data* copy_to(void* storage) const noexcept override {
+    return new (storage) tuple_vals(*this);
+  }
+
+  size_t memory_footprint() const noexcept override {
+    return sizeof(tuple_vals);
+  }
 };
 
 } // namespace detail
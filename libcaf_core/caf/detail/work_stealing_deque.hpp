@@ -0,0 +1,202 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_WORK_STEALING_DEQUE_HPP
+#define CAF_DETAIL_WORK_STEALING_DEQUE_HPP
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace caf {
+namespace detail {
+
+/*
+ * A lock-free work-stealing deque based on "Dynamic Circular Work-Stealing
+ * Deque" by Chase and Lev (SPAA 2005) using the memory orderings from
+ * "Correct and Efficient Work-Stealing for Weak Memory Models" by Le et al.
+ * (PPoPP 2013). The owner pushes and takes elements at the bottom (LIFO),
+ * while any other thread can steal elements from the top (FIFO). The deque
+ * stores raw pointers in a growable ring buffer and never allocates per
+ * element. Buffers that are replaced by a larger one remain alive until the
+ * deque is destroyed, because concurrent thieves may still read from them.
+ */
+template <class T>
+class work_stealing_deque {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using pointer = value_type*;
+
+  static constexpr size_type default_capacity = 1024;
+
+  explicit work_stealing_deque(size_type init_capacity = default_capacity)
+      : top_(0),
+        bottom_(0) {
+    // round up to the next power of two
+    size_type cap = 2;
+    while (cap < init_capacity)
+      cap <<= 1;
+    buffers_.emplace_back(new ring_buffer(cap));
+    buffer_ = buffers_.back().get();
+  }
+
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  /// Pushes `value` to the bottom of the deque.
+  /// @warning Call only from the owner.
+  void push(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto buf = buffer_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<index_type>(buf->capacity()) - 1)
+      buf = grow(buf, t, b);
+    buf->store(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /// Takes the most recently pushed element from the bottom of the deque,
+  /// returns `nullptr` if the deque is empty.
+  /// @warning Call only from the owner.
+  pointer take() {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto buf = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // deque is empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto result = buf->load(b);
+    if (t == b) {
+      // last element, race against thieves
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+        result = nullptr;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  /// Steals the oldest element from the top of the deque, returns `nullptr`
+  /// if the deque is empty or if another thread won the race for the element.
+  /// @threadsafe
+  pointer steal() {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom_.load(std::memory_order_acquire);
+    if (t >= b)
+      return nullptr;
+    // a consume load would suffice, but is promoted to acquire anyways
+    auto buf = buffer_.load(std::memory_order_acquire);
+    auto result = buf->load(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return nullptr;
+    return result;
+  }
+
+  /// Returns whether the deque is empty. The result is only a snapshot when
+  /// called from any thread other than the owner.
+  bool empty() const {
+    return size() == 0;
+  }
+
+  /// Returns the number of elements in the deque. The result is only a
+  /// snapshot when called from any thread other than the owner.
+  size_type size() const {
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+
+  /// Returns the current capacity of the ring buffer.
+  size_type capacity() const {
+    return buffer_.load(std::memory_order_relaxed)->capacity();
+  }
+
+private:
+  using index_type = int64_t;
+
+  class ring_buffer {
+  public:
+    explicit ring_buffer(size_type cap)
+        : mask_(cap - 1),
+          data_(new std::atomic<pointer>[cap]) {
+      // nop
+    }
+
+    size_type capacity() const {
+      return mask_ + 1;
+    }
+
+    pointer load(index_type pos) const {
+      return data_[static_cast<size_type>(pos) & mask_].load(
+        std::memory_order_relaxed);
+    }
+
+    void store(index_type pos, pointer value) {
+      data_[static_cast<size_type>(pos) & mask_].store(
+        value, std::memory_order_relaxed);
+    }
+
+  private:
+    size_type mask_;
+    std::unique_ptr<std::atomic<pointer>[]> data_;
+  };
+
+  // precondition: called by the owner while the buffer is full
+  ring_buffer* grow(ring_buffer* buf, index_type t, index_type b) {
+    auto ptr = new ring_buffer(buf->capacity() * 2);
+    buffers_.emplace_back(ptr);
+    for (auto i = t; i != b; ++i)
+      ptr->store(i, buf->load(i));
+    buffer_.store(ptr, std::memory_order_release);
+    return ptr;
+  }
+
+  // written by thieves and by the owner on the last element
+  std::atomic<index_type> top_;
+  char pad1_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)];
+  // written only by the owner
+  std::atomic<index_type> bottom_;
+  char pad2_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)];
+  // points to the last element in buffers_
+  std::atomic<ring_buffer*> buffer_;
+  // keeps all buffers alive, since thieves can still access old buffers
+  std::vector<std::unique_ptr<ring_buffer>> buffers_;
+};
+
+template <class T>
+constexpr typename work_stealing_deque<T>::size_type
+work_stealing_deque<T>::default_capacity;
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_WORK_STEALING_DEQUE_HPP
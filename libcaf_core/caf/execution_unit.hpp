@@ -59,9 +59,16 @@ public:
     proxies_ = ptr;
   }
 
+  /// Returns the scheduler partition this unit belongs to or `nullptr` if
+  /// the unit does not run as part of a partition.
+  scheduler::abstract_coordinator* partition() const {
+    return partition_;
+  }
+
 protected:
   actor_system* system_;
   proxy_registry* proxies_;
+  scheduler::abstract_coordinator* partition_;
 };
 
 } // namespace caf
@@ -35,6 +35,7 @@ template <class> class behavior_type_of;
 template <class> class trivial_match_case;
 template <class> class weak_intrusive_ptr;
 template <class> class typed_continue_helper;
+template <class> class polymorphic_allocator;
 
 template <class> struct timeout_definition;
 
@@ -61,6 +62,7 @@ class node_id;
 class duration;
 class behavior;
 class resumable;
+class byte_chunk;
 class actor_addr;
 class actor_pool;
 class message_id;
@@ -83,6 +85,9 @@ class proxy_registry;
 class actor_companion;
 class continue_helper;
 class mailbox_element;
+class mailbox_metrics;
+class memory_account;
+class memory_resource;
 class message_handler;
 class scheduled_actor;
 class response_promise;
@@ -93,6 +98,7 @@ class actor_control_block;
 class actor_system_config;
 class uniform_type_info_map;
 class forwarding_actor_proxy;
+class monotonic_buffer_resource;
 
 // -- structs ------------------------------------------------------------------
 
@@ -100,6 +106,8 @@ struct unit_t;
 struct exit_msg;
 struct down_msg;
 struct timeout_msg;
+struct mailbox_stats;
+struct memory_stats;
 struct group_down_msg;
 struct invalid_actor_t;
 struct invalid_actor_addr_t;
@@ -156,8 +164,12 @@ template <class> class type_erased_value_impl;
 class disposer;
 class message_data;
 class group_manager;
+class blocking_pool;
 class private_thread;
+class behavior_timeout;
 class dynamic_message_data;
+class memory_accounting;
+class mailbox_metrics_registry;
 
 } // namespace detail
 
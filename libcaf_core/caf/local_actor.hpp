@@ -21,8 +21,10 @@
 #define CAF_LOCAL_ACTOR_HPP
 
 #include <atomic>
+#include <limits>
 #include <cstdint>
 #include <utility>
+#include <algorithm>
 #include <exception>
 #include <functional>
 #include <type_traits>
@@ -52,6 +54,8 @@
 #include "caf/abstract_group.hpp"
 #include "caf/execution_unit.hpp"
 #include "caf/message_handler.hpp"
+#include "caf/mailbox_metrics.hpp"
+#include "caf/memory_account.hpp"
 #include "caf/response_promise.hpp"
 #include "caf/message_priority.hpp"
 #include "caf/check_typed_input.hpp"
@@ -62,6 +66,8 @@
 #include "caf/scheduler/abstract_coordinator.hpp"
 
 #include "caf/detail/disposer.hpp"
+#include "caf/detail/cache_index.hpp"
+#include "caf/detail/conflation_table.hpp"
 #include "caf/detail/behavior_stack.hpp"
 #include "caf/detail/typed_actor_util.hpp"
 #include "caf/detail/single_reader_queue.hpp"
@@ -93,9 +99,10 @@ public:
 
   // -- member types -----------------------------------------------------------
 
-  /// A queue optimized for single-reader-many-writers.
+  /// A queue optimized for single-reader-many-writers with one lane per
+  /// `message_priority`.
   using mailbox_type = detail::single_reader_queue<mailbox_element,
-                                                   detail::disposer>;
+                                                   detail::disposer, 2>;
 
   // -- constructors, destructors, and assignment operators --------------------
 
@@ -347,8 +354,17 @@ public:
     return mailbox_;
   }
 
+  /// Returns the index for all skipped messages in the mailbox cache.
+  inline detail::cache_index& cache_index() {
+    return cache_index_;
+  }
+
   virtual void initialize();
 
+  /// Called by event-based actors after each processed message if
+  /// `has_arena_flag` is set.
+  virtual void arena_checkpoint();
+
   bool cleanup(error&& fail_state, execution_unit* host) override;
 
   message_id new_request_id(message_priority mp);
@@ -365,12 +381,115 @@ public:
   /// Appends `x` to the cache for later consumption.
   void push_to_cache(mailbox_element_ptr ptr);
 
+  /// Removes `x` from the cache and destroys it.
+  void erase_from_cache(mailbox_element* x);
+
+  /// Sends `msg` to all `dests` using one mailbox element per receiver from
+  /// a single memory block and hands all receivers that were waiting for
+  /// messages to the scheduler at once.
+  void multicast_impl(const std::vector<abstract_actor*>& dests,
+                      message_id mid, message msg);
+
+  /// Returns the mailbox lane for `x`. Priority-aware actors put high-priority
+  /// messages into a separate lane.
+  inline size_t mailbox_lane(const mailbox_element& x) const {
+    return getf(is_priority_aware_flag) && x.is_high_priority() ? 1 : 0;
+  }
+
+  /// Enqueues `ptr` to the mailbox, replacing an older message with the same
+  /// conflation key if possible, and applies the overflow policy if needed.
+  detail::enqueue_result enqueue_to_mailbox(mailbox_element* ptr,
+                                            execution_unit* eu);
+
+  /// Enqueues all elements in `xs` to the mailbox and returns whether the
+  /// reader was blocked, i.e., needs to be resumed once. Takes ownership of
+  /// all elements. Unbounded mailboxes without conflation receive the batch
+  /// with one atomic operation per mailbox lane.
+  bool enqueue_batch_to_mailbox(std::vector<mailbox_element_ptr>& xs,
+                                execution_unit* eu);
+
+  /// Applies the overflow policy to `ptr` after the bounded mailbox rejected
+  /// it with `queue_full`. Returns the result of enqueueing `ptr` eventually
+  /// or `queue_full` if the policy dropped `ptr`.
+  detail::enqueue_result handle_overflow(mailbox_element* ptr,
+                                         execution_unit* eu);
+
+  /// Applies the budget policy of the actor system to `ptr` while the system
+  /// exceeds its memory budget.
+  detail::enqueue_result handle_over_budget(mailbox_element* ptr,
+                                            execution_unit* eu);
+
+  /// Destroys an element that the mailbox dropped for the drop-oldest
+  /// policy and releases its charge.
+  void drop_displaced(mailbox_element* x);
+
+  // -- mailbox metrics --------------------------------------------------------
+
+  /// Stamps `x` and counts it as pending. Must be called before enqueueing
+  /// `x`, since the actor may dequeue `x` right away. No-op unless CAF was
+  /// built with `CAF_ENABLE_MAILBOX_METRICS`.
+  inline void metrics_enqueue(mailbox_element& x) {
+#ifdef CAF_ENABLE_MAILBOX_METRICS
+    x.enqueued_at = mailbox_metrics::clock_type::now();
+    metrics_->enqueued();
+#else
+    CAF_IGNORE_UNUSED(x);
+#endif
+  }
+
+  /// Counts a stamped element as removed without reaching the actor.
+  inline void metrics_drop() {
+#ifdef CAF_ENABLE_MAILBOX_METRICS
+    metrics_->dropped();
+#endif
+  }
+
+  // -- memory accounting ------------------------------------------------------
+
+  /// Charges the footprint of `x` to the memory account of this actor and
+  /// returns the charged bytes. Must be called before enqueueing `x`.
+  inline size_t memory_charge(mailbox_element& x) {
+    if (!memory_)
+      return 0;
+    size_t max_charge = std::numeric_limits<uint32_t>::max();
+    auto n = std::min(x.memory_footprint(), max_charge);
+    x.charged = static_cast<uint32_t>(n);
+    memory_->charge(n);
+    return n;
+  }
+
+  /// Reverts a charge after the mailbox rejected the element.
+  inline void memory_release(size_t n) {
+    if (n > 0)
+      memory_->release(n);
+  }
+
+  /// Releases the charge of `x` after taking it out of the mailbox.
+  inline void memory_release(mailbox_element& x) {
+    memory_release(x.charged);
+    x.charged = 0;
+  }
+
 protected:
+  /// Sets the number of bytes the state of this actor occupies. No-op
+  /// unless the actor system enables memory accounting.
+  inline void memory_state(size_t n) {
+    if (memory_)
+      memory_->state(n);
+  }
+
   // -- member variables -------------------------------------------------------
 
+  // stores the newest message per key for conflating actors, must outlive
+  // the mailbox since the mailbox stores slots of this table
+  std::unique_ptr<detail::conflation_table> conflation_;
+
   // used by both event-based and blocking actors
   mailbox_type mailbox_;
 
+  // indexes all elements in the cache of our mailbox
+  detail::cache_index cache_index_;
+
   // identifies the execution unit this actor is currently executed by
   execution_unit* context_;
 
@@ -380,6 +499,17 @@ protected:
   // last used request ID
   message_id last_request_id_;
 
+  // selects how a bounded mailbox handles messages beyond its capacity
+  overflow_policy overflow_policy_;
+
+#ifdef CAF_ENABLE_MAILBOX_METRICS
+  // depth and queueing latency of our mailbox
+  intrusive_ptr<mailbox_metrics> metrics_;
+#endif
+
+  // bytes attributed to this actor if the system enables memory accounting
+  intrusive_ptr<memory_account> memory_;
+
   /// Factory function for returning initial behavior in function-based actors.
   std::function<behavior (local_actor*)> initial_behavior_fac_;
 };
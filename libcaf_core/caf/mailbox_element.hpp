@@ -20,6 +20,8 @@
 #ifndef CAF_MAILBOX_ELEMENT_HPP
 #define CAF_MAILBOX_ELEMENT_HPP
 
+#include <chrono>
+#include <vector>
 #include <cstddef>
 
 #include "caf/extend.hpp"
@@ -35,13 +37,15 @@
 #include "caf/meta/type_name.hpp"
 #include "caf/meta/omittable_if_empty.hpp"
 
+#include "caf/detail/memory.hpp"
 #include "caf/detail/disposer.hpp"
 #include "caf/detail/tuple_vals.hpp"
 #include "caf/detail/type_erased_tuple_view.hpp"
 
 namespace caf {
 
-class mailbox_element : public memory_managed, public message_view {
+class mailbox_element : public memory_managed, public message_view,
+                        public detail::slab_allocated {
 public:
   using forwarding_stack = std::vector<strong_actor_ptr>;
 
@@ -54,6 +58,10 @@ public:
   /// Avoids multi-processing in blocking actors via flagging.
   bool marked;
 
+  /// Number of bytes charged to the memory account of the receiver while
+  /// this element waits in its mailbox, 0 if none.
+  uint32_t charged;
+
   /// Source of this message and receiver of the final response.
   strong_actor_ptr sender;
 
@@ -64,6 +72,11 @@ public:
   /// if this is empty then the original sender receives the response.
   forwarding_stack stages;
 
+#ifdef CAF_ENABLE_MAILBOX_METRICS
+  /// Time at which the receiver started to enqueue this element.
+  std::chrono::steady_clock::time_point enqueued_at;
+#endif
+
   mailbox_element();
 
   mailbox_element(strong_actor_ptr&& x, message_id y,
@@ -77,6 +90,10 @@ public:
 
   const type_erased_tuple& content() const;
 
+  /// Returns the number of bytes this element occupies on the heap, including
+  /// message data but excluding memory owned by the stored values.
+  virtual size_t memory_footprint() const noexcept;
+
   mailbox_element(mailbox_element&&) = delete;
   mailbox_element(const mailbox_element&) = delete;
   mailbox_element& operator=(mailbox_element&&) = delete;
@@ -87,6 +104,11 @@ public:
   }
 
 protected:
+  /// Adds the forwarding stack to `self_size`.
+  inline size_t footprint(size_t self_size) const noexcept {
+    return self_size + stages.capacity() * sizeof(strong_actor_ptr);
+  }
+
   empty_type_erased_tuple dummy_;
 };
 
@@ -121,6 +143,10 @@ public:
     return detail::apply_moved_args(f, detail::get_indices(xs), xs);
   }
 
+  size_t memory_footprint() const noexcept override {
+    return footprint(sizeof(mailbox_element_vals));
+  }
+
   void dispose() noexcept {
     this->deref();
   }
@@ -157,6 +183,14 @@ mailbox_element_ptr
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages, message msg);
 
+/// Returns `n` mailbox elements that share the content of `msg`. All
+/// elements live in a single memory block that returns to the heap once
+/// the last element is gone.
+/// @relates mailbox_element
+std::vector<mailbox_element_ptr>
+make_mailbox_elements(strong_actor_ptr sender, message_id id, message msg,
+                      size_t n);
+
 /// @relates mailbox_element
 template <class T, class... Ts>
 typename std::enable_if<
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_MAILBOX_METRICS_HPP
+#define CAF_MAILBOX_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/fwd.hpp"
+#include "caf/ref_counted.hpp"
+
+namespace caf {
+
+/// A snapshot of the mailbox metrics of a single actor.
+struct mailbox_stats {
+  /// Number of buckets in the latency histogram. Bucket 0 counts messages that
+  /// waited less than 1us and bucket `i` counts messages that waited at least
+  /// `2^(i-1)` but less than `2^i` microseconds. The last bucket counts all
+  /// messages that waited longer.
+  static constexpr size_t num_buckets = 24;
+
+  using histogram = std::array<uint64_t, num_buckets>;
+
+  /// ID of the observed actor.
+  actor_id id;
+
+  /// Number of messages in the mailbox.
+  size_t depth;
+
+  /// Largest number of messages in the mailbox so far.
+  size_t high_water_mark;
+
+  /// Number of messages the actor took out of its mailbox so far.
+  uint64_t dequeued;
+
+  /// Queueing latency of all dequeued messages.
+  histogram latency;
+
+  /// Returns the exclusive upper bound of bucket `i` in microseconds or the
+  /// largest `uint64_t` for the last bucket.
+  static uint64_t upper_bound(size_t i);
+
+  /// Returns an upper bound in microseconds for the queueing latency of the
+  /// fraction `p` of all dequeued messages, e.g., `percentile(0.99)`.
+  uint64_t percentile(double p) const;
+};
+
+/// @relates mailbox_stats
+std::string to_string(const mailbox_stats& x);
+
+/// Collects the depth, high-water mark and queueing latency of an actor's
+/// mailbox. Senders and the receiving actor update the metrics concurrently
+/// using relaxed atomic operations only. Actors only collect metrics when
+/// compiling CAF with `CAF_ENABLE_MAILBOX_METRICS`.
+class mailbox_metrics : public ref_counted {
+public:
+  using clock_type = std::chrono::steady_clock;
+
+  explicit mailbox_metrics(actor_id aid);
+
+  ~mailbox_metrics() override;
+
+  /// Counts a message before it enters the mailbox.
+  inline void enqueued() noexcept {
+    auto n = depth_.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto hwm = high_water_mark_.load(std::memory_order_relaxed);
+    while (n > hwm
+           && !high_water_mark_.compare_exchange_weak(
+                hwm, n, std::memory_order_relaxed)) {
+      // nop
+    }
+  }
+
+  /// Counts a message that left the mailbox without reaching the actor, e.g.,
+  /// because the overflow policy dropped it.
+  inline void dropped() noexcept {
+    depth_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /// Counts a message the actor took out of its mailbox after it entered the
+  /// mailbox at `enqueued_at`.
+  inline void dequeued(clock_type::time_point enqueued_at) noexcept {
+    depth_.fetch_sub(1, std::memory_order_relaxed);
+    latency_[bucket(clock_type::now() - enqueued_at)]
+      .fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Returns the histogram bucket for a queueing latency of `x`.
+  static size_t bucket(clock_type::duration x);
+
+  /// Returns the ID of the observed actor.
+  inline actor_id id() const {
+    return id_;
+  }
+
+  /// Returns the current values of all metrics.
+  mailbox_stats snapshot() const;
+
+private:
+  actor_id id_;
+  std::atomic<size_t> depth_;
+  std::atomic<size_t> high_water_mark_;
+  std::array<std::atomic<uint64_t>, mailbox_stats::num_buckets> latency_;
+};
+
+} // namespace caf
+
+#endif // CAF_MAILBOX_METRICS_HPP
@@ -20,6 +20,7 @@
 #ifndef CAF_MAKE_ACTOR_HPP
 #define CAF_MAKE_ACTOR_HPP
 
+#include <vector>
 #include <type_traits>
 
 #include "caf/fwd.hpp"
@@ -30,6 +31,8 @@
 #include "caf/actor_storage.hpp"
 #include "caf/actor_control_block.hpp"
 
+#include "caf/detail/scope_guard.hpp"
+
 namespace caf {
 
 template <class T, class R = infer_handle_from_class_t<T>, class... Ts>
@@ -40,6 +43,32 @@ R make_actor(actor_id aid, node_id nid, actor_system* sys, Ts&&... xs) {
   return {&(ptr->ctrl), false};
 }
 
+/// Creates `n` actors of type `T` with consecutive IDs starting at `aid`.
+/// Acquires the memory for all actors from the pool of `actor_storage<T>`
+/// at once.
+template <class T, class R = infer_handle_from_class_t<T>, class... Ts>
+std::vector<R> make_actors(size_t n, actor_id aid, const node_id& nid,
+                           actor_system* sys, Ts&&... xs) {
+  using storage = actor_storage<T>;
+  std::vector<void*> blocks;
+  storage::pool().allocate(n, blocks);
+  size_t pos = 0;
+  // return unused blocks if a constructor throws
+  auto guard = detail::make_scope_guard([&] {
+    for (auto i = pos; i < blocks.size(); ++i)
+      storage::pool().deallocate(blocks[i]);
+  });
+  std::vector<R> result;
+  result.reserve(n);
+  for (; pos < n; ++pos) {
+    CAF_LOG_SPAWN_EVENT(aid + pos, std::forward_as_tuple(xs...));
+    auto ptr = new (blocks[pos]) storage(static_cast<actor_id>(aid + pos),
+                                         nid, sys, xs...);
+    result.emplace_back(&(ptr->ctrl), false);
+  }
+  return result;
+}
+
 } // namespace caf
 
 #endif // CAF_MAKE_ACTOR_HPP
@@ -54,6 +54,23 @@ struct unbox_message_element<actor_control_block*, 0> {
   using type = strong_actor_ptr;
 };
 
+namespace detail {
+
+template <class Storage, class... Ts>
+message make_message_data(std::true_type, Ts&&... xs) {
+  message_data::cow_ptr ptr;
+  ptr.emplace_inline<Storage>(std::forward<Ts>(xs)...);
+  return message{std::move(ptr)};
+}
+
+template <class Storage, class... Ts>
+message make_message_data(std::false_type, Ts&&... xs) {
+  auto ptr = make_counted<Storage>(std::forward<Ts>(xs)...);
+  return message{message_data::cow_ptr{std::move(ptr)}};
+}
+
+} // namespace detail
+
 ///
 template <class T>
 struct is_serializable_or_whitelisted {
@@ -89,8 +106,14 @@ make_message(T&& x, Ts&&... xs) {
                 "specializing `caf::allowed_unsafe_message_type<T>` "
                 "or using the macro CAF_ALLOW_UNSAFE_MESSAGE_TYPE");
   using storage = typename tl_apply<stored_types, tuple_vals>::type;
-  auto ptr = make_counted<storage>(std::forward<T>(x), std::forward<Ts>(xs)...);
-  return message{detail::message_data::cow_ptr{std::move(ptr)}};
+  // store small, trivially copyable values inline
+  std::integral_constant<
+    bool,
+    message_data::cow_ptr::fits_inline<storage>::value
+    && tl_forall<stored_types, std::is_trivially_copyable>::value
+  > token;
+  return make_message_data<storage>(token, std::forward<T>(x),
+                                    std::forward<Ts>(xs)...);
 }
 
 /// Returns a copy of @p other.
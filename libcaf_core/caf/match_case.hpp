@@ -24,6 +24,7 @@
 #include <type_traits>
 
 #include "caf/none.hpp"
+#include "caf/batch.hpp"
 #include "caf/param.hpp"
 #include "caf/optional.hpp"
 #include "caf/match_case.hpp"
@@ -58,6 +59,10 @@ public:
   virtual result invoke(detail::invoke_result_visitor& rv,
                         type_erased_tuple& xs) = 0;
 
+  /// Returns the factory for combining messages into a `batch<T>` if this
+  /// match case handles `batch<T>`, `nullptr` otherwise.
+  virtual const detail::batch_factory* batch() const;
+
   inline uint32_t type_token() const {
     return token_;
   }
@@ -165,6 +170,10 @@ public:
     return f.visit(fun_res) ? match_case::match : match_case::skip;
   }
 
+  const detail::batch_factory* batch() const override {
+    return detail::batch_factory_of<decayed_arg_types>::get();
+  }
+
 protected:
   F fun_;
 };
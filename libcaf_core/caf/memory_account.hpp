@@ -0,0 +1,97 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_MEMORY_ACCOUNT_HPP
+#define CAF_MEMORY_ACCOUNT_HPP
+
+#include <atomic>
+#include <string>
+#include <cstddef>
+
+#include "caf/fwd.hpp"
+#include "caf/ref_counted.hpp"
+
+namespace caf {
+
+/// A snapshot of the memory attributed to a single actor.
+struct memory_stats {
+  /// ID of the observed actor.
+  actor_id id;
+
+  /// Bytes occupied by messages waiting in the mailbox.
+  size_t mailbox;
+
+  /// Bytes occupied by the state of the actor.
+  size_t state;
+
+  /// Returns the sum of all attributed bytes.
+  inline size_t total() const {
+    return mailbox + state;
+  }
+};
+
+/// @relates memory_stats
+std::string to_string(const memory_stats& x);
+
+/// Attributes memory to a single actor. Senders charge the footprint of each
+/// message to the account of the receiver before enqueueing it and the
+/// receiver releases the charge when taking the message out of its mailbox.
+/// Each account also updates the system-wide total, which allows the
+/// actor system to enforce a memory budget. All updates are relaxed atomic
+/// operations. Actors only have an account if the actor system enables
+/// memory accounting.
+class memory_account : public ref_counted {
+public:
+  memory_account(actor_id aid, std::atomic<size_t>& total);
+
+  ~memory_account() override;
+
+  /// Attributes `n` bytes in the mailbox to this account.
+  inline void charge(size_t n) noexcept {
+    mailbox_.fetch_add(n, std::memory_order_relaxed);
+    total_.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  /// Removes `n` previously charged bytes from this account.
+  inline void release(size_t n) noexcept {
+    mailbox_.fetch_sub(n, std::memory_order_relaxed);
+    total_.fetch_sub(n, std::memory_order_relaxed);
+  }
+
+  /// Sets the number of bytes occupied by the state of the actor.
+  void state(size_t n) noexcept;
+
+  /// Returns the ID of the observed actor.
+  inline actor_id id() const {
+    return id_;
+  }
+
+  /// Returns the current values of this account.
+  memory_stats snapshot() const;
+
+private:
+  actor_id id_;
+  std::atomic<size_t> mailbox_;
+  std::atomic<size_t> state_;
+  std::atomic<size_t>& total_;
+};
+
+} // namespace caf
+
+#endif // CAF_MEMORY_ACCOUNT_HPP
@@ -0,0 +1,146 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_MEMORY_RESOURCE_HPP
+#define CAF_MEMORY_RESOURCE_HPP
+
+#include <limits>
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+
+#include "caf/config.hpp"
+
+namespace caf {
+
+/// Interface for classes that provide memory to `polymorphic_allocator`,
+/// modeled after `std::pmr::memory_resource`.
+class memory_resource {
+public:
+  /// Default alignment for allocations, suitable for any scalar type.
+  static constexpr size_t max_align = alignof(std::max_align_t);
+
+  virtual ~memory_resource();
+
+  /// Allocates `bytes` with alignment `align`.
+  inline void* allocate(size_t bytes, size_t align = max_align) {
+    return do_allocate(bytes, align);
+  }
+
+  /// Returns memory previously obtained via `allocate(bytes, align)`.
+  inline void deallocate(void* ptr, size_t bytes, size_t align = max_align) {
+    do_deallocate(ptr, bytes, align);
+  }
+
+  /// Returns whether memory allocated from `other` can be deallocated from
+  /// this resource and vice versa.
+  inline bool is_equal(const memory_resource& other) const noexcept {
+    return do_is_equal(other);
+  }
+
+protected:
+  virtual void* do_allocate(size_t bytes, size_t align) = 0;
+
+  virtual void do_deallocate(void* ptr, size_t bytes, size_t align) = 0;
+
+  virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+/// @relates memory_resource
+inline bool operator==(const memory_resource& x,
+                       const memory_resource& y) noexcept {
+  return &x == &y || x.is_equal(y);
+}
+
+/// @relates memory_resource
+inline bool operator!=(const memory_resource& x,
+                       const memory_resource& y) noexcept {
+  return !(x == y);
+}
+
+/// Returns a resource that uses the global `operator new` and
+/// `operator delete`.
+/// @relates memory_resource
+memory_resource* new_delete_resource() noexcept;
+
+/// An allocator that obtains memory from a `memory_resource`, modeled after
+/// `std::pmr::polymorphic_allocator`. Containers using this allocator have
+/// the same type regardless of where their memory comes from. Copies of
+/// containers fall back to `new_delete_resource()`, since they usually
+/// outlive the resource of the original, e.g., when sending them as part
+/// of a message.
+template <class T>
+class polymorphic_allocator {
+public:
+  using value_type = T;
+
+  polymorphic_allocator() noexcept : resource_(new_delete_resource()) {
+    // nop
+  }
+
+  polymorphic_allocator(memory_resource* resource) noexcept
+      : resource_(resource) {
+    CAF_ASSERT(resource != nullptr);
+  }
+
+  template <class U>
+  polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+      : resource_(other.resource()) {
+    // nop
+  }
+
+  T* allocate(size_t n) {
+    if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+      CAF_RAISE_ERROR("polymorphic_allocator: requested size too large");
+    return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) {
+    resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+  }
+
+  polymorphic_allocator select_on_container_copy_construction() const {
+    return {};
+  }
+
+  inline memory_resource* resource() const noexcept {
+    return resource_;
+  }
+
+private:
+  memory_resource* resource_;
+};
+
+/// @relates polymorphic_allocator
+template <class T, class U>
+bool operator==(const polymorphic_allocator<T>& x,
+                const polymorphic_allocator<U>& y) noexcept {
+  return *x.resource() == *y.resource();
+}
+
+/// @relates polymorphic_allocator
+template <class T, class U>
+bool operator!=(const polymorphic_allocator<T>& x,
+                const polymorphic_allocator<U>& y) noexcept {
+  return !(x == y);
+}
+
+} // namespace caf
+
+#endif // CAF_MEMORY_RESOURCE_HPP
@@ -22,6 +22,7 @@
 
 #include <tuple>
 #include <chrono>
+#include <vector>
 
 #include "caf/fwd.hpp"
 #include "caf/actor.hpp"
@@ -101,6 +102,50 @@ public:
                     dptr()->context(), std::forward<Ts>(xs)...);
   }
 
+  /// Sends all messages in `xs` to `dest` with priority `P`. The receiver
+  /// gets scheduled at most once for the whole batch.
+  template <message_priority P = message_priority::normal, class Dest = actor>
+  void send_batch(const Dest& dest, std::vector<message> xs) {
+    static_assert(!statically_typed<Subtype>() && !statically_typed<Dest>(),
+                  "batches consist of dynamically typed messages; use send() "
+                  "when communicating with statically typed actors");
+    if (dest && !xs.empty())
+      dest->enqueue_batch(dptr()->ctrl(), message_id::make(P), std::move(xs),
+                          dptr()->context());
+  }
+
+  /// Anonymously sends all messages in `xs` to `dest` with priority `P`.
+  /// The receiver gets scheduled at most once for the whole batch.
+  template <message_priority P = message_priority::normal, class Dest = actor>
+  void anon_send_batch(const Dest& dest, std::vector<message> xs) {
+    static_assert(!statically_typed<Dest>(),
+                  "batches consist of dynamically typed messages; use "
+                  "anon_send() when communicating with statically typed "
+                  "actors");
+    if (dest && !xs.empty())
+      dest->enqueue_batch(nullptr, message_id::make(P), std::move(xs),
+                          dptr()->context());
+  }
+
+  /// Sends `msg` to all actors in `dests` with priority `P`. All receivers
+  /// share the content of `msg` and receivers that were waiting for messages
+  /// get scheduled at once.
+  template <message_priority P = message_priority::normal, class Handles>
+  void multicast(const Handles& dests, message msg) {
+    using handle_type = typename Handles::value_type;
+    static_assert(!statically_typed<Subtype>()
+                  && !statically_typed<handle_type>(),
+                  "multicast sends dynamically typed messages; use send() "
+                  "when communicating with statically typed actors");
+    std::vector<abstract_actor*> xs;
+    xs.reserve(dests.size());
+    for (auto& dest : dests)
+      if (dest)
+        xs.push_back(actor_cast<abstract_actor*>(dest));
+    if (!xs.empty())
+      dptr()->multicast_impl(xs, message_id::make(P), std::move(msg));
+  }
+
   template <message_priority P = message_priority::normal,
             class Dest = actor, class... Ts>
   void delayed_send(const Dest& dest, const duration& rtime, Ts&&... xs) {
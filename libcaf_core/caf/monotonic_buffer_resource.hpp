@@ -0,0 +1,102 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_MONOTONIC_BUFFER_RESOURCE_HPP
+#define CAF_MONOTONIC_BUFFER_RESOURCE_HPP
+
+#include <cstddef>
+
+#include "caf/memory_resource.hpp"
+
+namespace caf {
+
+/// A resource that carves allocations out of large blocks and releases
+/// memory only all at once, modeled after
+/// `std::pmr::monotonic_buffer_resource`. Deallocating is a no-op.
+/// Unlike its standard counterpart, this resource can `reset` without
+/// returning its largest block to the upstream resource. Hence, an arena
+/// that gets reset after each request settles on a single block that fits
+/// the largest request and stops touching the upstream resource.
+class monotonic_buffer_resource : public memory_resource {
+public:
+  /// Default size of the first block in bytes.
+  static constexpr size_t default_initial_size = 1024;
+
+  explicit monotonic_buffer_resource(
+    size_t initial_size = default_initial_size,
+    memory_resource* upstream = new_delete_resource());
+
+  monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+  monotonic_buffer_resource& operator=(const monotonic_buffer_resource&)
+    = delete;
+
+  ~monotonic_buffer_resource() override;
+
+  /// Makes all memory available for new allocations again. Keeps the
+  /// largest block and returns all others to the upstream resource.
+  /// @warning Invalidates all memory allocated from this resource.
+  void reset();
+
+  /// Returns all blocks to the upstream resource.
+  /// @warning Invalidates all memory allocated from this resource.
+  void release();
+
+  /// Returns the number of bytes this resource currently holds from its
+  /// upstream resource.
+  inline size_t reserved() const noexcept {
+    return reserved_;
+  }
+
+  /// Returns the resource that provides blocks to this resource.
+  inline memory_resource* upstream_resource() const noexcept {
+    return upstream_;
+  }
+
+protected:
+  void* do_allocate(size_t bytes, size_t align) override;
+
+  void do_deallocate(void* ptr, size_t bytes, size_t align) override;
+
+  bool do_is_equal(const memory_resource& other) const noexcept override;
+
+private:
+  // prefix of each block, followed by the memory for allocations
+  struct block {
+    block* next;
+    size_t size;
+  };
+
+  // allocates a new block with room for `bytes` aligned to `align`
+  void grow(size_t bytes, size_t align);
+
+  // makes the memory of `x` available for allocations
+  void use(block* x);
+
+  memory_resource* upstream_;
+  size_t initial_size_;
+  size_t next_size_;
+  size_t reserved_;
+  block* blocks_;
+  char* pos_;
+  char* end_;
+};
+
+} // namespace caf
+
+#endif // CAF_MONOTONIC_BUFFER_RESOURCE_HPP
@@ -0,0 +1,48 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_OVERFLOW_POLICY_HPP
+#define CAF_OVERFLOW_POLICY_HPP
+
+#include <cstdint>
+
+namespace caf {
+
+/// Denotes how a bounded mailbox handles messages beyond its capacity.
+enum class overflow_policy : uint8_t {
+  /// Drops the new message.
+  drop_newest,
+  /// Drops the oldest message the receiver did not fetch yet and enqueues
+  /// the new message. Drops the new message if the receiver already fetched
+  /// all pending messages.
+  drop_oldest,
+  /// Drops the new message and sends a `sec::mailbox_full` error to the
+  /// sender, either as response to a request or as anonymous message. Note
+  /// that the default error handler of event-based actors terminates the
+  /// actor with the received error.
+  reject,
+  /// Suspends blocking senders until the receiver catches up. Blocking
+  /// senders are blocking, detached and pooled actors as well as anonymous
+  /// senders outside of actors. Falls back to `reject` for all other senders.
+  block
+};
+
+} // namespace caf
+
+#endif // CAF_OVERFLOW_POLICY_HPP
@@ -0,0 +1,184 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_POLICY_LOCK_FREE_WORK_SHARING_HPP
+#define CAF_POLICY_LOCK_FREE_WORK_SHARING_HPP
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+#include "caf/resumable.hpp"
+#include "caf/actor_system_config.hpp"
+
+#include "caf/policy/unprofiled.hpp"
+
+#include "caf/detail/mpmc_ring.hpp"
+#include "caf/detail/event_count.hpp"
+
+namespace caf {
+namespace policy {
+
+/// Implements scheduling of actors via work sharing, using a bounded
+/// lock-free ring as central job queue and an event count for idle workers.
+/// @extends scheduler_policy
+class lock_free_work_sharing : public unprofiled {
+public:
+  ~lock_free_work_sharing() override;
+
+  // The coordinator holds the central ring buffer, an overflow queue for jobs
+  // that did not fit into the ring and an event count for idle workers.
+  struct coordinator_data {
+    inline explicit coordinator_data(scheduler::abstract_coordinator* p)
+        : ring(p->system().config().work_sharing_queue_capacity),
+          overflow_size(0) {
+      // nop
+    }
+
+    detail::mpmc_ring<resumable> ring;
+    // number of jobs in `overflow`, allows skipping the lock
+    std::atomic<size_t> overflow_size;
+    // guards `overflow`
+    std::mutex overflow_mtx;
+    // jobs enqueued while the ring was full
+    std::deque<resumable*> overflow;
+    detail::event_count idle_workers;
+  };
+
+  struct worker_data {
+    inline explicit worker_data(scheduler::abstract_coordinator*) {
+      // nop
+    }
+  };
+
+  template <class Coordinator>
+  void enqueue(Coordinator* self, resumable* job) {
+    auto& data = d(self);
+    // once the ring overflowed, all jobs go to the overflow queue until
+    // workers drained it in order to keep jobs in FIFO order
+    if (data.overflow_size.load(std::memory_order_acquire) != 0
+        || !data.ring.push(job)) {
+      std::unique_lock<std::mutex> guard{data.overflow_mtx};
+      data.overflow.push_back(job);
+      data.overflow_size.store(data.overflow.size(),
+                               std::memory_order_release);
+    }
+    data.idle_workers.notify_one();
+  }
+
+  // Returns the next job from the ring or the overflow queue. Moves as many
+  // jobs from the overflow queue back to the ring as possible when taking
+  // a job from the overflow queue.
+  template <class Coordinator>
+  resumable* try_dequeue(Coordinator* self) {
+    auto& data = d(self);
+    auto job = data.ring.pop();
+    if (job != nullptr
+        || data.overflow_size.load(std::memory_order_acquire) == 0)
+      return job;
+    std::unique_lock<std::mutex> guard{data.overflow_mtx};
+    if (data.overflow.empty())
+      return nullptr;
+    job = data.overflow.front();
+    data.overflow.pop_front();
+    while (!data.overflow.empty() && data.ring.push(data.overflow.front()))
+      data.overflow.pop_front();
+    data.overflow_size.store(data.overflow.size(), std::memory_order_release);
+    return job;
+  }
+
+  template <class Coordinator>
+  void central_enqueue(Coordinator* self, resumable* job) {
+    enqueue(self, job);
+  }
+
+  template <class Coordinator>
+  void central_enqueue_batch(Coordinator* self,
+                             const std::vector<resumable*>& jobs) {
+    auto& data = d(self);
+    size_t i = 0;
+    if (data.overflow_size.load(std::memory_order_acquire) == 0)
+      while (i < jobs.size() && data.ring.push(jobs[i]))
+        ++i;
+    if (i < jobs.size()) {
+      std::unique_lock<std::mutex> guard{data.overflow_mtx};
+      data.overflow.insert(data.overflow.end(), jobs.begin() + i, jobs.end());
+      data.overflow_size.store(data.overflow.size(),
+                               std::memory_order_release);
+    }
+    if (jobs.size() == 1)
+      data.idle_workers.notify_one();
+    else
+      data.idle_workers.notify_all();
+  }
+
+  template <class Worker>
+  void external_enqueue(Worker* self, resumable* job) {
+    enqueue(self->parent(), job);
+  }
+
+  template <class Worker>
+  void internal_enqueue(Worker* self, resumable* job) {
+    enqueue(self->parent(), job);
+  }
+
+  template <class Worker>
+  void resume_job_later(Worker* self, resumable* job) {
+    // job has voluntarily released the CPU to let others run instead
+    // this means we are going to put this job to the very end of our queue
+    enqueue(self->parent(), job);
+  }
+
+  template <class Worker>
+  resumable* dequeue(Worker* self) {
+    auto p = self->parent();
+    auto& idle = d(p).idle_workers;
+    for (;;) {
+      auto job = try_dequeue(p);
+      if (job != nullptr)
+        return job;
+      // register as waiter, then check once more to not miss a wakeup
+      auto key = idle.prepare_wait();
+      job = try_dequeue(p);
+      if (job != nullptr) {
+        idle.cancel_wait();
+        return job;
+      }
+      idle.wait(key);
+    }
+  }
+
+  template <class Worker, class UnaryFunction>
+  void foreach_resumable(Worker*, UnaryFunction) {
+    // nop
+  }
+
+  template <class Coordinator, class UnaryFunction>
+  void foreach_central_resumable(Coordinator* self, UnaryFunction f) {
+    for (auto job = try_dequeue(self); job != nullptr; job = try_dequeue(self))
+      f(job);
+  }
+};
+
+} // namespace policy
+} // namespace caf
+
+#endif // CAF_POLICY_LOCK_FREE_WORK_SHARING_HPP
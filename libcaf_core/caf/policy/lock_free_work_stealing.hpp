@@ -0,0 +1,167 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_POLICY_LOCK_FREE_WORK_STEALING_HPP
+#define CAF_POLICY_LOCK_FREE_WORK_STEALING_HPP
+
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+
+#include "caf/resumable.hpp"
+
+#include "caf/policy/work_stealing.hpp"
+
+#include "caf/detail/work_stealing_deque.hpp"
+
+namespace caf {
+namespace policy {
+
+/// Implements scheduling of actors via work stealing, using a lock-free
+/// Chase-Lev deque for each worker instead of a locking, node-based queue.
+/// @extends scheduler_policy
+class lock_free_work_stealing : public work_stealing {
+public:
+  ~lock_free_work_stealing() override;
+
+  /// Combines a lock-free deque that only the owner can push to with an
+  /// inbox for jobs enqueued by other threads. The owner moves jobs from its
+  /// inbox to the deque once the deque runs dry, making them available to
+  /// thieves without taking a lock.
+  class queue_type {
+  public:
+    queue_type() : inbox_size_(0) {
+      // nop
+    }
+
+    queue_type(const queue_type&) = delete;
+    queue_type& operator=(const queue_type&) = delete;
+
+    /// Enqueues `job` to the inbox.
+    /// @threadsafe
+    void append(resumable* job) {
+      std::unique_lock<std::mutex> guard{inbox_mtx_};
+      inbox_.push_back(job);
+      inbox_size_.store(inbox_.size(), std::memory_order_release);
+    }
+
+    /// Pushes `job` to the bottom of the deque, i.e., `job` is the next
+    /// job for the owner unless a thief steals it first. Falls back to
+    /// `append` when called from any other thread, since execution units
+    /// can outlive the run of an actor, e.g., in response promises.
+    /// @threadsafe
+    void prepend(resumable* job) {
+      if (owned_by_this_thread())
+        deque_.push(job);
+      else
+        append(job);
+    }
+
+    /// Takes the next job for the owner.
+    /// @warning Call only from the owner.
+    resumable* take_head() {
+      auto job = deque_.take();
+      if (job != nullptr || inbox_size_.load(std::memory_order_acquire) == 0)
+        return job;
+      { // lifetime scope of guard
+        std::unique_lock<std::mutex> guard{inbox_mtx_};
+        buf_.swap(inbox_);
+        inbox_size_.store(0, std::memory_order_release);
+      }
+      // push in reverse order to run the oldest job first
+      for (auto i = buf_.rbegin(); i != buf_.rend(); ++i)
+        deque_.push(*i);
+      buf_.clear();
+      return deque_.take();
+    }
+
+    /// Steals a job from the top of the deque or, if the deque is empty,
+    /// from the inbox.
+    /// @threadsafe
+    resumable* take_tail() {
+      auto job = deque_.steal();
+      if (job != nullptr || inbox_size_.load(std::memory_order_acquire) == 0)
+        return job;
+      std::unique_lock<std::mutex> guard{inbox_mtx_};
+      if (inbox_.empty())
+        return nullptr;
+      job = inbox_.back();
+      inbox_.pop_back();
+      inbox_size_.store(inbox_.size(), std::memory_order_release);
+      return job;
+    }
+
+    /// Steals up to half of all jobs in the deque (but at least one) or, if
+    /// the deque is empty, up to half of all jobs in the inbox. Appends the
+    /// stolen jobs to `result` and returns their number.
+    /// @threadsafe
+    size_t take_tail_half(std::vector<resumable*>& result) {
+      auto n = std::max(size_t{1}, (deque_.size() + 1) / 2);
+      size_t stolen = 0;
+      for (; stolen < n; ++stolen) {
+        auto job = deque_.steal();
+        if (job == nullptr)
+          break;
+        result.push_back(job);
+      }
+      if (stolen > 0 || inbox_size_.load(std::memory_order_acquire) == 0)
+        return stolen;
+      std::unique_lock<std::mutex> guard{inbox_mtx_};
+      auto first = inbox_.begin() + (inbox_.size() / 2);
+      result.insert(result.end(), first, inbox_.end());
+      stolen = static_cast<size_t>(inbox_.end() - first);
+      inbox_.erase(first, inbox_.end());
+      inbox_size_.store(inbox_.size(), std::memory_order_release);
+      return stolen;
+    }
+
+    /// Marks the calling thread as owner of this queue.
+    void claim();
+
+    /// Returns whether the calling thread is the owner of this queue.
+    bool owned_by_this_thread() const;
+
+  private:
+    // jobs of the owner, exposed to thieves
+    detail::work_stealing_deque<resumable> deque_;
+    // number of jobs in inbox_, allows the owner to skip the lock
+    std::atomic<size_t> inbox_size_;
+    // guards inbox_
+    std::mutex inbox_mtx_;
+    // jobs enqueued by other threads
+    std::vector<resumable*> inbox_;
+    // swapped with inbox_ by the owner to avoid allocations
+    std::vector<resumable*> buf_;
+  };
+
+  using worker_data = basic_worker_data<queue_type>;
+
+  template <class Worker>
+  resumable* dequeue(Worker* self) {
+    d(self).queue.claim();
+    return work_stealing::dequeue(self);
+  }
+};
+
+} // namespace policy
+} // namespace caf
+
+#endif // CAF_POLICY_LOCK_FREE_WORK_STEALING_HPP
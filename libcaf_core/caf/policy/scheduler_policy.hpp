@@ -44,6 +44,11 @@ public:
   template <class Coordinator>
   void central_enqueue(Coordinator* self, resumable* job);
 
+  /// Enqueues all `jobs` to the coordinator at once.
+  template <class Coordinator>
+  void central_enqueue_batch(Coordinator* self,
+                             const std::vector<resumable*>& jobs);
+
   /// Enqueues a new job to the worker's queue from an
   /// external source, i.e., from any other thread.
   template <class Worker>
@@ -63,6 +68,11 @@ public:
   template <class Worker>
   resumable* dequeue(Worker* self);
 
+  /// Performs initialization in the worker's thread
+  /// before it dequeues its first job.
+  template <class Worker>
+  void after_start(Worker* self);
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker* self);
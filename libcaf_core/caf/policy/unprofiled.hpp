@@ -34,6 +34,13 @@ class unprofiled {
 public:
   virtual ~unprofiled();
 
+  /// Performs initialization in the worker's thread
+  /// before it dequeues its first job.
+  template <class Worker>
+  void after_start(Worker*) {
+    // nop
+  }
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker*) {
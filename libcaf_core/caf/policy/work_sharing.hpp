@@ -22,6 +22,7 @@
 
 #include <list>
 #include <mutex>
+#include <vector>
 #include <cstddef>
 #include <condition_variable>
 
@@ -70,6 +71,18 @@ public:
     enqueue(self, job);
   }
 
+  template <class Coordinator>
+  void central_enqueue_batch(Coordinator* self,
+                             const std::vector<resumable*>& jobs) {
+    queue_type l{jobs.begin(), jobs.end()};
+    std::unique_lock<std::mutex> guard(d(self).lock);
+    d(self).queue.splice(d(self).queue.end(), l);
+    if (jobs.size() == 1)
+      d(self).cv.notify_one();
+    else
+      d(self).cv.notify_all();
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     enqueue(self->parent(), job);
@@ -20,17 +20,25 @@
 #ifndef CAF_POLICY_WORK_STEALING_HPP
 #define CAF_POLICY_WORK_STEALING_HPP
 
+#include <array>
 #include <deque>
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <random>
+#include <vector>
 #include <cstddef>
+#include <utility>
 
+#include "caf/logger.hpp"
 #include "caf/resumable.hpp"
 #include "caf/actor_system_config.hpp"
 
 #include "caf/policy/unprofiled.hpp"
 
+#include "caf/detail/event_count.hpp"
+#include "caf/detail/cpu_topology.hpp"
+#include "caf/detail/set_thread_affinity.hpp"
 #include "caf/detail/double_ended_queue.hpp"
 
 namespace caf {
@@ -53,21 +61,44 @@ public:
     size_t step_size;
     size_t steal_interval;
     usec sleep_duration;
+    // parks the worker until new jobs arrive instead of sleeping
+    bool park;
   };
 
-  // The coordinator has only a counter for round-robin enqueue to its workers.
+  // Number of successful steals per locality level of the victim.
+  using steal_counters =
+    std::array<size_t, detail::cpu_topology::num_localities>;
+
+  // The coordinator has a counter for round-robin enqueue to its workers,
+  // an event count for parking idle workers and the CPU layout of the host
+  // for topology-aware victim selection.
   struct coordinator_data {
-    inline explicit coordinator_data(scheduler::abstract_coordinator*)
+    inline explicit coordinator_data(scheduler::abstract_coordinator* p)
         : next_worker(0) {
-      // nop
+      auto& cfg = p->system().config();
+      // partitions never pin their workers and thus always steal randomly
+      if (!p->is_partition()
+          && cfg.work_stealing_victim_selection == atom("topology")) {
+        topology = detail::cpu_topology::read();
+        // only consider CPUs available to workers
+        if (!cfg.scheduler_worker_cpus.empty())
+          topology.retain(
+            detail::cpu_topology::parse_cpu_list(cfg.scheduler_worker_cpus));
+      }
     }
 
     std::atomic<size_t> next_worker;
+    detail::event_count parked_workers;
+    // empty unless using topology-aware victim selection
+    detail::cpu_topology topology;
   };
 
   // Holds job job queue of a worker and a random number generator.
-  struct worker_data {
-    inline explicit worker_data(scheduler::abstract_coordinator* p)
+  // Derived policies can plug in a different `Queue` as long as it provides
+  // `append`, `prepend`, `take_head`, `take_tail` and `take_tail_half`.
+  template <class Queue>
+  struct basic_worker_data {
+    inline explicit basic_worker_data(scheduler::abstract_coordinator* p)
         : rengine(std::random_device{}()),
           // no need to worry about wrap-around; if `p->num_workers() < 2`,
           // `uniform` will not be used anyway
@@ -75,25 +106,131 @@ public:
           strategies{
             {p->system().config().work_stealing_aggressive_poll_attempts, 1,
              p->system().config().work_stealing_aggressive_steal_interval,
-             usec{0}},
+             usec{0}, false},
             {p->system().config().work_stealing_moderate_poll_attempts, 1,
              p->system().config().work_stealing_moderate_steal_interval,
-             usec{p->system().config().work_stealing_moderate_sleep_duration_us}},
+             usec{p->system().config().work_stealing_moderate_sleep_duration_us},
+             false},
             {1, 0, p->system().config().work_stealing_relaxed_steal_interval,
-            usec{p->system().config().work_stealing_relaxed_sleep_duration_us}}
-          } {
-      // nop
+            usec{p->system().config().work_stealing_relaxed_sleep_duration_us},
+            p->system().config().work_stealing_idle_strategy == atom("park")}
+          },
+          run_next(nullptr),
+          run_next_streak(0),
+          run_next_limit(p->system().config().work_stealing_run_next_limit),
+          steal_half(p->system().config().work_stealing_steal_half) {
+      for (auto& x : steals)
+        x = 0;
     }
 
     // This queue is exposed to other workers that may attempt to steal jobs
     // from it and the central scheduling unit can push new jobs to the queue.
-    queue_type queue;
+    Queue queue;
     // needed to generate pseudo random numbers
     std::default_random_engine rengine;
     std::uniform_int_distribution<size_t> uniform;
     poll_strategy strategies[3];
+    // other workers grouped by their locality relative to this worker,
+    // only used for topology-aware victim selection
+    std::vector<size_t> victims[detail::cpu_topology::num_localities];
+    // successful steals per locality, only written by the owning worker
+    std::atomic<size_t> steals[detail::cpu_topology::num_localities];
+    // job that runs next on this worker, cannot get stolen by others and
+    // thus keeps chains of messages between two actors on one core
+    resumable* run_next;
+    // number of consecutive jobs dequeued from `run_next`
+    size_t run_next_streak;
+    // maximum for `run_next_streak` before checking the queue again
+    size_t run_next_limit;
+    // the thread running this worker, set by `after_start`
+    std::thread::id owner;
+    // moves up to half of a victim's queue per steal instead of one job
+    bool steal_half;
+    // buffer for stolen jobs, only used if `steal_half` is set
+    std::vector<resumable*> stolen;
   };
 
+  using worker_data = basic_worker_data<queue_type>;
+
+  // Pins the worker to a CPU and groups all other workers by locality
+  // when using topology-aware victim selection. Worker N runs on the N-th
+  // CPU (modulo the number of CPUs), i.e., workers with adjacent IDs are
+  // close to each other. This replaces the mapping of `worker-cpus`, which
+  // only restricts the set of CPUs in topology mode.
+  template <class Worker>
+  void after_start(Worker* self) {
+    d(self).owner = std::this_thread::get_id();
+    auto p = self->parent();
+    auto& cpus = d(p).topology.cpus();
+    if (cpus.empty())
+      return;
+    auto cpu_of = [&](size_t id) -> const detail::cpu_topology::cpu& {
+      return cpus[id % cpus.size()];
+    };
+    auto& me = cpu_of(self->id());
+    if (!detail::set_thread_affinity(std::vector<int>{me.id}))
+      CAF_LOG_WARNING("unable to pin worker to CPU:" << CAF_ARG(me.id));
+    for (size_t i = 0; i < p->num_workers(); ++i)
+      if (i != self->id())
+        d(self).victims[detail::cpu_topology::distance(me, cpu_of(i))]
+        .push_back(i);
+  }
+
+  // Returns how many jobs all workers of `self` stole, grouped by the
+  // locality of the victim. Only topology-aware victim selection
+  // populates the counters, i.e., all counters are 0 otherwise.
+  template <class Coordinator>
+  static steal_counters steal_statistics(Coordinator* self) {
+    steal_counters result;
+    result.fill(0);
+    for (size_t i = 0; i < self->num_workers(); ++i) {
+      auto& steals = d(self->worker_by_id(i)).steals;
+      for (size_t j = 0; j < result.size(); ++j)
+        result[j] += steals[j].load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  // Steals one job from `victim` or, in steal-half mode, up to half of its
+  // jobs. In the latter case, `self` runs the first stolen job next and
+  // appends all others to its own queue, where other workers can steal them.
+  template <class Worker>
+  resumable* steal_from(Worker* self, Worker* victim) {
+    auto& data = d(self);
+    if (!data.steal_half)
+      return d(victim).queue.take_tail();
+    auto& xs = data.stolen;
+    if (d(victim).queue.take_tail_half(xs) == 0)
+      return nullptr;
+    for (auto i = xs.begin() + 1; i != xs.end(); ++i)
+      data.queue.append(*i);
+    if (xs.size() > 1)
+      unpark_one(self);
+    auto job = xs.front();
+    xs.clear();
+    return job;
+  }
+
+  // Tries one randomly picked victim per locality level, starting with
+  // workers sharing a cache with `self` and ending with remote nodes.
+  template <class Worker>
+  resumable* try_steal_by_locality(Worker* self) {
+    auto p = self->parent();
+    auto& victims = d(self).victims;
+    for (size_t i = 0; i < detail::cpu_topology::num_localities; ++i) {
+      auto& xs = victims[i];
+      if (xs.empty())
+        continue;
+      std::uniform_int_distribution<size_t> pick{0, xs.size() - 1};
+      auto job = steal_from(self, p->worker_by_id(xs[pick(d(self).rengine)]));
+      if (job) {
+        d(self).steals[i].fetch_add(1, std::memory_order_relaxed);
+        return job;
+      }
+    }
+    return nullptr;
+  }
+
   // Goes on a raid in quest for a shiny new job.
   template <class Worker>
   resumable* try_steal(Worker* self) {
@@ -102,12 +239,52 @@ public:
       // you can't steal from yourself, can you?
       return nullptr;
     }
+    if (!d(p).topology.empty())
+      return try_steal_by_locality(self);
     // roll the dice to pick a victim other than ourselves
     auto victim = d(self).uniform(d(self).rengine);
     if (victim == self->id())
       victim = p->num_workers() - 1;
     // steal oldest element from the victim's queue
-    return d(p->worker_by_id(victim)).queue.take_tail();
+    return steal_from(self, p->worker_by_id(victim));
+  }
+
+  // Visits all other workers in quest for a job, used before parking.
+  template <class Worker>
+  resumable* try_steal_from_any(Worker* self) {
+    auto p = self->parent();
+    for (size_t i = 0; i < p->num_workers(); ++i) {
+      if (i == self->id())
+        continue;
+      auto job = steal_from(self, p->worker_by_id(i));
+      if (job)
+        return job;
+    }
+    return nullptr;
+  }
+
+  // Blocks until new jobs are available unless the last check
+  // finds a job, in which case the job is returned immediately.
+  template <class Worker>
+  resumable* park(Worker* self) {
+    auto& parked = d(self->parent()).parked_workers;
+    auto key = parked.prepare_wait();
+    // check all queues once more after registering as waiter
+    auto job = d(self).queue.take_head();
+    if (!job)
+      job = try_steal_from_any(self);
+    if (job) {
+      parked.cancel_wait();
+      return job;
+    }
+    parked.wait(key);
+    return nullptr;
+  }
+
+  // Wakes up a parked worker to pick up new jobs.
+  template <class Worker>
+  void unpark_one(Worker* self) {
+    d(self->parent()).parked_workers.notify_one();
   }
 
   template <class Coordinator>
@@ -116,14 +293,44 @@ public:
     w->external_enqueue(job);
   }
 
+  // Distributes `jobs` round-robin and wakes up at most one parked worker
+  // per job instead of unparking a worker after each job.
+  template <class Coordinator>
+  void central_enqueue_batch(Coordinator* self,
+                             const std::vector<resumable*>& jobs) {
+    auto n = self->num_workers();
+    auto first = d(self).next_worker.fetch_add(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i)
+      d(self->worker_by_id((first + i) % n)).queue.append(jobs[i]);
+    auto& parked = d(self).parked_workers;
+    if (jobs.size() >= n) {
+      parked.notify_all();
+      return;
+    }
+    for (size_t i = 0; i < jobs.size(); ++i)
+      parked.notify_one();
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     d(self).queue.append(job);
+    unpark_one(self);
   }
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
-    d(self).queue.prepend(job);
+    auto& data = d(self);
+    // put the job into the run-next slot unless another thread calls this
+    // function (which happens when actors use a stale execution unit);
+    // a previous occupant of the slot moves to the queue instead
+    if (data.run_next_limit > 0 && data.owner == std::this_thread::get_id()) {
+      std::swap(job, data.run_next);
+      if (job == nullptr)
+        return;
+    }
+    data.queue.prepend(job);
+    // allow parked workers to steal this job
+    unpark_one(self);
   }
 
   template <class Worker>
@@ -139,11 +346,24 @@ public:
     // assume an active work load on the machine and perform aggresive
     // polling, then we relax our polling a bit and wait 50 us between
     // dequeue attempts, finally we assume pretty much nothing is going
-    // on and poll every 10 ms; this strategy strives to minimize the
-    // downside of "busy waiting", which still performs much better than a
-    // "signalizing" implementation based on mutexes and conition variables
-    auto& strategies = d(self).strategies;
+    // on and park the worker until a new job arrives (or poll every 10 ms
+    // if parking is disabled); parking uses an event count that enqueue
+    // operations only signal if at least one worker is actually parked
+    auto& data = d(self);
     resumable* job = nullptr;
+    if (data.run_next != nullptr) {
+      // two actors sending messages back and forth would starve all other
+      // jobs in our queue without a limit for consecutive run-next jobs
+      if (++data.run_next_streak > data.run_next_limit) {
+        data.run_next_streak = 0;
+        job = data.queue.take_head();
+      }
+      if (job == nullptr)
+        std::swap(job, data.run_next);
+      return job;
+    }
+    data.run_next_streak = 0;
+    auto& strategies = data.strategies;
     for (auto& strat : strategies) {
       for (size_t i = 0; i < strat.attempts; i += strat.step_size) {
         job = d(self).queue.take_head();
@@ -155,8 +375,13 @@ public:
           if (job)
             return job;
         }
-        if (strat.sleep_duration.count() > 0)
+        if (strat.park) {
+          job = park(self);
+          if (job)
+            return job;
+        } else if (strat.sleep_duration.count() > 0) {
           std::this_thread::sleep_for(strat.sleep_duration);
+        }
       }
     }
     // unreachable, because the last strategy loops
@@ -166,6 +391,10 @@ public:
 
   template <class Worker, class UnaryFunction>
   void foreach_resumable(Worker* self, UnaryFunction f) {
+    if (d(self).run_next != nullptr) {
+      f(d(self).run_next);
+      d(self).run_next = nullptr;
+    }
     auto next = [&] { return d(self).queue.take_head(); };
     for (auto job = next(); job != nullptr; job = next()) {
       f(job);
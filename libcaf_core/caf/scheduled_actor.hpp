@@ -148,6 +148,14 @@ public:
 
   void enqueue(mailbox_element_ptr ptr, execution_unit* eu) override;
 
+  void enqueue_deferred(mailbox_element_ptr ptr, execution_unit* eu,
+                        std::vector<resumable*>& wakeups) override;
+
+  using abstract_actor::enqueue_batch;
+
+  void enqueue_batch(std::vector<mailbox_element_ptr> xs,
+                     execution_unit* eu) override;
+
   // -- overridden functions of local_actor ------------------------------------
 
   const char* name() const override;
@@ -309,6 +317,10 @@ public:
   /// Returns the category of `x`.
   message_category categorize(mailbox_element& x);
 
+  /// Returns whether `categorize` may return anything but `ordinary` for
+  /// messages with type token `x`.
+  static bool is_system_message_token(uint32_t x);
+
   /// Tries to consume `x`.
   invoke_message_result consume(mailbox_element& x);
 
@@ -318,6 +330,12 @@ public:
   /// Tries to consume one element form the cache using the current behavior.
   bool consume_from_cache();
 
+  /// Replaces `x` with a single `batch<T>` if the current behavior handles
+  /// `batch<T>` and `x` is an asynchronous `T`. The batch includes up to
+  /// `max_size - 1` consecutive asynchronous `T` messages from the mailbox.
+  /// Returns how many additional messages the batch includes.
+  size_t gather_batch(mailbox_element_ptr& x, size_t max_size);
+
   /// Activates an actor and runs initialization code if necessary.
   /// @returns `true` if the actor is alive and ready for `reactivate`,
   ///          `false` otherwise.
@@ -388,6 +406,18 @@ protected:
       swap(g, f);
   }
 
+  /// Hands this actor to the scheduler. Runs the actor on `eu` if it belongs
+  /// to the actor's partition, otherwise enqueues it to its partition or to
+  /// the blocking pool if spawned with `pooled`.
+  void schedule(execution_unit* eu);
+
+  /// Enqueues `ptr` to the mailbox and returns whether the caller needs to
+  /// wake up this actor.
+  bool enqueue_impl(mailbox_element_ptr ptr, execution_unit* eu);
+
+  /// Adds a reference for the scheduler and resumes this actor.
+  void wake_up(execution_unit* eu);
+
   // -- member variables -------------------------------------------------------
 
   /// Stores user-defined callbacks for message handling.
@@ -396,6 +426,9 @@ protected:
   /// Identifies the timeout messages we are currently waiting for.
   uint32_t timeout_id_;
 
+  /// Timer entry for the behavior timeout, shared with the clock thread.
+  intrusive_ptr<detail::behavior_timeout> timeout_;
+
   /// Stores callbacks for awaited responses.
   std::forward_list<pending_response> awaited_responses_;
 
@@ -417,6 +450,10 @@ protected:
   /// Pointer to a private thread object associated with a detached actor.
   detail::private_thread* private_thread_;
 
+  /// Points to the scheduler partition of this actor or is `nullptr` if the
+  /// actor runs in the default scheduler.
+  scheduler::abstract_coordinator* partition_;
+
 # ifndef CAF_NO_EXCEPTIONS
   /// Customization point for setting a default exception callback.
   exception_handler exception_handler_;
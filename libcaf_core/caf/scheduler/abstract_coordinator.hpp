@@ -22,6 +22,7 @@
 
 #include <chrono>
 #include <atomic>
+#include <vector>
 #include <cstddef>
 
 #include "caf/fwd.hpp"
@@ -31,6 +32,9 @@
 #include "caf/duration.hpp"
 #include "caf/actor_addr.hpp"
 #include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+
+#include "caf/detail/timer_thread.hpp"
 
 namespace caf {
 namespace scheduler {
@@ -43,21 +47,35 @@ class abstract_coordinator : public actor_system::module {
 public:
   explicit abstract_coordinator(actor_system& sys);
 
+  /// Creates a coordinator for the scheduler partition `x`. Partitions take
+  /// their settings from `x` and leave timer and printer to the default
+  /// scheduler.
+  abstract_coordinator(actor_system& sys,
+                       const actor_system_config::scheduler_partition& x);
+
   /// Returns a handle to the central printing actor.
   actor printer() const;
 
   /// Puts `what` into the queue of a randomly chosen worker.
   virtual void enqueue(resumable* what) = 0;
 
+  /// Puts all `jobs` into the queues of the workers at once. The default
+  /// implementation calls `enqueue` for each job.
+  virtual void enqueue_batch(const std::vector<resumable*>& jobs);
+
   template <class Duration, class... Data>
   void delayed_send(Duration rel_time, strong_actor_ptr from,
                     strong_actor_ptr to, message_id mid, message data) {
-    timer_->enqueue(nullptr, invalid_message_id,
-                    make_message(duration{rel_time}, std::move(from),
-                                 std::move(to), mid, std::move(data)),
-                    nullptr);
+    delayed_send_impl(duration{rel_time}, std::move(from), std::move(to), mid,
+                      std::move(data));
   }
 
+  /// Arms the behavior timeout `x` of `self` to deliver `timeout_msg{tid}`
+  /// after `rel_time`, possibly replacing `x` with a new entry.
+  virtual void set_timeout(intrusive_ptr<detail::behavior_timeout>& x,
+                           actor_control_block* self,
+                           const duration& rel_time, uint32_t tid);
+
   inline actor_system& system() {
     return system_;
   }
@@ -70,6 +88,17 @@ public:
     return num_workers_;
   }
 
+  /// Returns whether this coordinator is a scheduler partition.
+  inline bool is_partition() const {
+    return is_partition_;
+  }
+
+  /// Returns the name of this partition.
+  /// @pre `is_partition()`
+  inline atom_value partition_name() const {
+    return partition_name_;
+  }
+
   void start() override;
 
   void init(actor_system_config& cfg) override;
@@ -81,6 +110,11 @@ public:
   static void cleanup_and_release(resumable*);
 
 protected:
+  /// Delivers `data` to `to` after `rel_time` via the clock thread.
+  virtual void delayed_send_impl(const duration& rel_time,
+                                 strong_actor_ptr from, strong_actor_ptr to,
+                                 message_id mid, message data);
+
   void stop_actors();
 
   // ID of the worker receiving the next enqueue
@@ -92,7 +126,13 @@ protected:
   // configured number of workers
   size_t num_workers_;
 
-  strong_actor_ptr timer_;
+  // stores whether this coordinator runs a scheduler partition
+  bool is_partition_;
+
+  // name of the partition, only meaningful if `is_partition_ == true`
+  atom_value partition_name_;
+
+  detail::timer_thread timer_;
   strong_actor_ptr printer_;
 
   actor_system& system_;
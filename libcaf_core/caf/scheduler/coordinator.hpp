@@ -45,6 +45,13 @@ public:
     // nop
   }
 
+  coordinator(actor_system& sys,
+              const actor_system_config::scheduler_partition& x)
+      : super(sys, x),
+        data_(this) {
+    // nop
+  }
+
   using worker_type = worker<Policy>;
 
   worker_type* worker_by_id(size_t x) {
@@ -130,6 +137,11 @@ protected:
     policy_.central_enqueue(this, ptr);
   }
 
+  void enqueue_batch(const std::vector<resumable*>& jobs) override {
+    if (!jobs.empty())
+      policy_.central_enqueue_batch(this, jobs);
+  }
+
 private:
   // usually of size std::thread::hardware_concurrency()
   std::vector<std::unique_ptr<worker_type>> workers_;
@@ -119,12 +119,22 @@ public:
   /// events (first) and dispatched delayed messages (second).
   std::pair<size_t, size_t> run_dispatch_loop();
 
+  /// Schedules a `timeout_msg` as regular delayed message to enable tests to
+  /// dispatch timeouts deterministically.
+  void set_timeout(intrusive_ptr<detail::behavior_timeout>& x,
+                   actor_control_block* self, const duration& rel_time,
+                   uint32_t tid) override;
+
 protected:
   void start() override;
 
   void stop() override;
 
   void enqueue(resumable* ptr) override;
+
+  void delayed_send_impl(const duration& rel_time, strong_actor_ptr from,
+                         strong_actor_ptr to, message_id mid,
+                         message data) override;
 };
 
 } // namespace scheduler
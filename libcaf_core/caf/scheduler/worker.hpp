@@ -20,13 +20,19 @@
 #ifndef CAF_SCHEDULER_WORKER_HPP
 #define CAF_SCHEDULER_WORKER_HPP
 
+#include <string>
 #include <cstddef>
 
 #include "caf/logger.hpp"
 #include "caf/resumable.hpp"
 #include "caf/execution_unit.hpp"
 
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+#include "caf/detail/cpu_topology.hpp"
+#include "caf/detail/set_thread_name.hpp"
 #include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/set_thread_affinity.hpp"
 
 namespace caf {
 namespace scheduler {
@@ -48,13 +54,30 @@ public:
         id_(worker_id),
         parent_(worker_parent),
         data_(worker_parent) {
-    // nop
+    if (worker_parent->is_partition())
+      partition_ = worker_parent;
   }
 
   void start() {
     CAF_ASSERT(this_thread_.get_id() == std::thread::id{});
     auto this_worker = this;
     this_thread_ = std::thread{[this_worker] {
+      auto id = std::to_string(this_worker->id());
+      auto partition = this_worker->partition();
+      if (partition != nullptr) {
+        // worker-cpus only applies to workers of the default scheduler
+        auto name = "caf." + to_string(partition->partition_name()) + "." + id;
+        detail::set_thread_name(name.c_str());
+        this_worker->run();
+        return;
+      }
+      auto name = "caf.worker." + id;
+      detail::set_thread_name(name.c_str());
+      auto& cpu_list = this_worker->system().config().scheduler_worker_cpus;
+      auto cpus = detail::cpu_topology::parse_cpu_list(cpu_list);
+      if (!cpus.empty())
+        detail::set_thread_affinity(
+          std::vector<int>{cpus[this_worker->id() % cpus.size()]});
       this_worker->run();
     }};
   }
@@ -106,6 +129,7 @@ public:
 private:
   void run() {
     CAF_SET_LOGGER_SYS(&system());
+    policy_.after_start(this);
     // scheduling loop
     for (;;) {
       auto job = policy_.dequeue(this);
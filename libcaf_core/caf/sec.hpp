@@ -91,7 +91,11 @@ enum class sec : uint8_t {
   /// Linking to a remote actor failed because actor no longer exists.
   remote_linking_failed,
   /// A function view was called without assigning an actor first.
-  bad_function_call
+  bad_function_call,
+  /// A bounded mailbox rejected a message because it reached its capacity.
+  mailbox_full,
+  /// The actor system rejected a message because it exceeds its memory budget.
+  memory_budget_exceeded
 };
 
 /// @relates sec
@@ -20,6 +20,8 @@
 #ifndef CAF_SEND_HPP
 #define CAF_SEND_HPP
 
+#include <vector>
+
 #include "caf/actor.hpp"
 #include "caf/message.hpp"
 #include "caf/actor_cast.hpp"
@@ -80,6 +82,17 @@ void anon_send(const Dest& dest, Ts&&... xs) {
                   std::forward<Ts>(xs)...);
 }
 
+/// Anonymously sends all messages in `xs` to `dest`. The receiver gets
+/// scheduled at most once for the whole batch.
+template <message_priority P = message_priority::normal, class Dest = actor>
+void anon_send_batch(const Dest& dest, std::vector<message> xs) {
+  static_assert(!statically_typed<Dest>(),
+                "batches consist of dynamically typed messages; use "
+                "anon_send() when communicating with statically typed actors");
+  if (dest && !xs.empty())
+    dest->enqueue_batch(nullptr, message_id::make(P), std::move(xs), nullptr);
+}
+
 /// Anonymously sends `dest` an exit message.
 template <class Dest>
 void anon_send_exit(const Dest& dest, exit_reason reason) {
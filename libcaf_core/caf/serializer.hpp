@@ -53,6 +53,12 @@ public:
   explicit serializer(execution_unit* ctx = nullptr);
 
   ~serializer() override;
+
+  /// Writes the content of `x` as a sequence of bytes. The default
+  /// implementation copies all bytes via `apply_raw`. Serializers with
+  /// scatter/gather output can override this member function to pass the
+  /// chunk on without copying it.
+  virtual error apply_chunk(const byte_chunk& x);
 };
 
 #ifndef CAF_NO_EXCEPTIONS
@@ -45,6 +45,9 @@ public:
 
   operator fun() const;
 
+  /// Returns whether `f` wraps the function returned by `operator fun()`.
+  static bool is_skip(const fun& f);
+
 private:
   static result<message> skip_fun_impl(scheduled_actor*, message_view&);
 };
@@ -36,7 +36,8 @@ enum class spawn_options : int {
   detach_flag = 0x04,
   hide_flag = 0x08,
   priority_aware_flag = 0x20,
-  lazy_init_flag = 0x40
+  lazy_init_flag = 0x40,
+  pooled_flag = 0x80
 };
 #endif
 
@@ -73,6 +74,10 @@ constexpr spawn_options priority_aware = spawn_options::priority_aware_flag;
 /// initialization until a message arrives.
 constexpr spawn_options lazy_init = spawn_options::lazy_init_flag;
 
+/// Causes the new actor to run in an elastic thread pool for actors that call
+/// blocking functions instead of running in the cooperative scheduler.
+constexpr spawn_options pooled = spawn_options::pooled_flag;
+
 /// Checks wheter `haystack` contains `needle`.
 /// @relates spawn_options
 constexpr bool has_spawn_option(spawn_options haystack, spawn_options needle) {
@@ -115,6 +120,12 @@ constexpr bool has_lazy_init_flag(spawn_options opts) {
   return has_spawn_option(opts, lazy_init);
 }
 
+/// Checks wheter the {@link pooled} flag is set in `opts`.
+/// @relates spawn_options
+constexpr bool has_pooled_flag(spawn_options opts) {
+  return has_spawn_option(opts, pooled);
+}
+
 /// @}
 
 /// @cond PRIVATE
@@ -21,12 +21,15 @@
 #define CAF_STATEFUL_ACTOR_HPP
 
 #include <new>
+#include <memory>
 #include <type_traits>
 
 #include "caf/fwd.hpp"
 #include "caf/sec.hpp"
 
 #include "caf/logger.hpp"
+#include "caf/memory_resource.hpp"
+#include "caf/monotonic_buffer_resource.hpp"
 
 #include "caf/detail/type_traits.hpp"
 
@@ -37,13 +40,21 @@ namespace caf {
 /// actor called `quit`. This state management brakes cycles and
 /// allows actors to automatically release ressources as soon
 /// as possible.
+///
+/// Each actor can own an arena for allocations that should not touch the
+/// global heap. A state opts in by declaring an `allocator_type` that is
+/// constructible from `polymorphic_allocator<char>`, following the
+/// uses-allocator convention of the standard library. The actor then
+/// passes an allocator for its arena as last argument to the constructor
+/// of its state.
 template <class State, class Base = event_based_actor>
 class stateful_actor : public Base {
 public:
   template <class... Ts>
   explicit stateful_actor(actor_config& cfg, Ts&&... xs)
       : Base(cfg, std::forward<Ts>(xs)...),
-        state(state_) {
+        state(state_),
+        reset_arena_after_message_(false) {
     if (detail::is_serializable<State>::value)
       this->setf(Base::is_serializable_flag);
   }
@@ -74,13 +85,54 @@ public:
   /// A reference to the actor's state.
   State& state;
 
+  // -- arena ------------------------------------------------------------------
+
+  /// Returns the arena of this actor, creating it on first use.
+  monotonic_buffer_resource& arena() {
+    if (!arena_) {
+      arena_.reset(new monotonic_buffer_resource);
+      this->setf(Base::has_arena_flag);
+    }
+    return *arena_;
+  }
+
+  /// Returns an allocator that obtains memory from the arena of this actor.
+  template <class T = char>
+  polymorphic_allocator<T> arena_allocator() {
+    return &arena();
+  }
+
+  /// Makes all memory of the arena available for new allocations again.
+  /// @warning Invalidates all objects allocated from the arena, i.e., the
+  ///          state must not refer to such objects anymore.
+  void reset_arena() {
+    if (arena_) {
+      arena_->reset();
+      this->memory_state(sizeof(State) + arena_->reserved());
+    }
+  }
+
+  /// Configures whether the actor calls `reset_arena` after each message.
+  /// Only event-based actors reset their arena automatically, since
+  /// blocking actors can nest receives.
+  void reset_arena_after_message(bool x) {
+    reset_arena_after_message_ = x;
+  }
+
   /// @cond PRIVATE
 
   void initialize() override {
     cr_state(this);
+    this->memory_state(sizeof(State) + (arena_ ? arena_->reserved() : 0));
     Base::initialize();
   }
 
+  void arena_checkpoint() override {
+    if (reset_arena_after_message_)
+      arena_->reset();
+    this->memory_state(sizeof(State) + arena_->reserved());
+  }
+
   /// @endcond
 
 private:
@@ -95,18 +147,36 @@ private:
     return sec::invalid_argument;
   }
 
+  template <class T>
+  void cr_state(T arg) {
+    using uses_arena = std::uses_allocator<State, polymorphic_allocator<char>>;
+    cr_state(arg, std::integral_constant<bool, uses_arena::value>{});
+  }
+
   template <class T>
   typename std::enable_if<std::is_constructible<State, T>::value>::type
-  cr_state(T arg) {
+  cr_state(T arg, std::false_type) {
     new (&state_) State(arg);
   }
 
   template <class T>
   typename std::enable_if<!std::is_constructible<State, T>::value>::type
-  cr_state(T) {
+  cr_state(T, std::false_type) {
     new (&state_) State();
   }
 
+  template <class T, class A = typename State::allocator_type>
+  typename std::enable_if<std::is_constructible<State, T, A>::value>::type
+  cr_state(T arg, std::true_type) {
+    new (&state_) State(arg, A{&arena()});
+  }
+
+  template <class T, class A = typename State::allocator_type>
+  typename std::enable_if<!std::is_constructible<State, T, A>::value>::type
+  cr_state(T, std::true_type) {
+    new (&state_) State(A{&arena()});
+  }
+
   static const char* unbox_str(const char* str) {
     return str;
   }
@@ -129,6 +199,12 @@ private:
   }
 
   union { State state_; };
+
+  // created on first use, destroyed after the state
+  std::unique_ptr<monotonic_buffer_resource> arena_;
+
+  // configures whether `arena_checkpoint` resets the arena
+  bool reset_arena_after_message_;
 };
 
 } // namespace caf
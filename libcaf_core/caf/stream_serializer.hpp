@@ -30,7 +30,9 @@
 #include <type_traits>
 
 #include "caf/sec.hpp"
+#include "caf/callback.hpp"
 #include "caf/streambuf.hpp"
+#include "caf/byte_chunk.hpp"
 #include "caf/serializer.hpp"
 
 #include "caf/detail/ieee_754.hpp"
@@ -48,16 +50,23 @@ class stream_serializer : public serializer {
                 "Streambuf must inherit from std::streambuf");
 
 public:
+  /// Receives chunks that bypass the stream buffer.
+  using chunk_writer = callback<const byte_chunk&>;
+
   template <class... Ts>
   explicit stream_serializer(actor_system& sys, Ts&&... xs)
     : serializer(sys),
-      streambuf_{std::forward<Ts>(xs)...} {
+      streambuf_{std::forward<Ts>(xs)...},
+      chunk_writer_(nullptr),
+      chunk_threshold_(0) {
   }
 
   template <class... Ts>
   explicit stream_serializer(execution_unit* ctx, Ts&&... xs)
     : serializer(ctx),
-      streambuf_{std::forward<Ts>(xs)...} {
+      streambuf_{std::forward<Ts>(xs)...},
+      chunk_writer_(nullptr),
+      chunk_threshold_(0) {
   }
 
   template <
@@ -71,7 +80,28 @@ public:
   >
   explicit stream_serializer(S&& sb)
     : serializer(nullptr),
-      streambuf_(std::forward<S>(sb)) {
+      streambuf_(std::forward<S>(sb)),
+      chunk_writer_(nullptr),
+      chunk_threshold_(0) {
+  }
+
+  /// Hands all chunks with at least `min_size` bytes to `f` instead of
+  /// copying them into the stream buffer. The serializer writes the length
+  /// prefix of such a chunk before calling `f`, i.e., `f` must emit the
+  /// chunk right after everything written to the stream buffer so far.
+  /// Passing `nullptr` restores the default behavior.
+  void set_chunk_writer(chunk_writer* f, size_t min_size) {
+    chunk_writer_ = f;
+    chunk_threshold_ = min_size;
+  }
+
+  error apply_chunk(const byte_chunk& x) override {
+    if (chunk_writer_ == nullptr || x.size() < chunk_threshold_)
+      return serializer::apply_chunk(x);
+    auto n = x.size();
+    return error::eval([&] { return begin_sequence(n); },
+                       [&] { return (*chunk_writer_)(x); },
+                       [&] { return end_sequence(); });
   }
 
   error begin_object(uint16_t& typenr, std::string& name) override {
@@ -185,6 +215,8 @@ private:
   }
 
   Streambuf streambuf_;
+  chunk_writer* chunk_writer_;
+  size_t chunk_threshold_;
 };
 
 } // namespace caf
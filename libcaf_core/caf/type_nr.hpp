@@ -45,6 +45,7 @@ using sorted_builtin_types =
     std::vector<actor_addr>,            // @addrvec
     atom_value,                         // @atom
     std::vector<char>,                  // @charbuf
+    byte_chunk,                         // @chunk
     down_msg,                           // @down
     duration,                           // @duration
     timestamp,                          // @timestamp
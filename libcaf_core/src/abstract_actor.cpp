@@ -65,6 +65,29 @@ void abstract_actor::enqueue(strong_actor_ptr sender, message_id mid,
   enqueue(make_mailbox_element(sender, mid, {}, std::move(msg)), host);
 }
 
+void abstract_actor::enqueue_deferred(mailbox_element_ptr what,
+                                      execution_unit* host,
+                                      std::vector<resumable*>&) {
+  enqueue(std::move(what), host);
+}
+
+void abstract_actor::enqueue_batch(std::vector<mailbox_element_ptr> xs,
+                                   execution_unit* host) {
+  for (auto& x : xs)
+    enqueue(std::move(x), host);
+}
+
+void abstract_actor::enqueue_batch(strong_actor_ptr sender, message_id mid,
+                                   std::vector<message> xs,
+                                   execution_unit* host) {
+  std::vector<mailbox_element_ptr> elements;
+  elements.reserve(xs.size());
+  for (auto& x : xs)
+    elements.emplace_back(make_mailbox_element(sender, mid, {},
+                                               std::move(x)));
+  enqueue_batch(std::move(elements), host);
+}
+
 abstract_actor::abstract_actor(actor_config& cfg)
     : abstract_channel(cfg.flags) {
   // nop
@@ -43,6 +43,9 @@
 
 #include "caf/policy/work_stealing.hpp"
 
+#include "caf/detail/set_thread_name.hpp"
+#include "caf/detail/set_thread_affinity.hpp"
+
 #include "caf/logger.hpp"
 
 namespace caf {
@@ -54,85 +57,6 @@ namespace scheduler {
 
 namespace {
 
-using hrc = std::chrono::high_resolution_clock;
-
-class timer_actor : public blocking_actor {
-public:
-  explicit timer_actor(actor_config& cfg) : blocking_actor(cfg) {
-    // nop
-  }
-
-  struct delayed_msg {
-    strong_actor_ptr from;
-    strong_actor_ptr to;
-    message_id mid;
-    message msg;
-  };
-
-  void deliver(delayed_msg& dm) {
-    dm.to->enqueue(dm.from, dm.mid, std::move(dm.msg), nullptr);
-  }
-
-  template <class Map, class... Ts>
-  void insert_dmsg(Map& storage, const duration& d, Ts&&... xs) {
-    auto tout = hrc::now();
-    tout += d;
-    delayed_msg dmsg{std::forward<Ts>(xs)...};
-    storage.emplace(std::move(tout), std::move(dmsg));
-  }
-
-  void act() override {
-    // local state
-    accept_one_cond rc;
-    bool running = true;
-    std::multimap<hrc::time_point, delayed_msg> messages;
-    // our message handler
-    behavior nested{
-      [&](const duration& d, strong_actor_ptr& from,
-          strong_actor_ptr& to, message_id mid, message& msg) {
-        insert_dmsg(messages, d, std::move(from),
-                    std::move(to), mid, std::move(msg));
-      },
-      [&](const exit_msg& dm) {
-        if (dm.reason) {
-          fail_state(dm.reason);
-          running = false;
-        }
-      }
-    };
-    auto bhvr = detail::make_blocking_behavior(
-      &nested,
-      others >> [&](message_view& x) -> result<message> {
-        std::cerr << "*** unexpected message in timer_actor: "
-                  << to_string(x.content()) << std::endl;
-        return sec::unexpected_message;
-      }
-    );
-    // loop until receiving an exit message
-    while (running) {
-      if (messages.empty()) {
-        // use regular receive as long as we don't have a pending timeout
-        receive_impl(rc, message_id::make(), bhvr);
-      } else {
-        auto tout = messages.begin()->first;
-        if (await_data(tout)) {
-          receive_impl(rc, message_id::make(), bhvr);
-        } else {
-          auto it = messages.begin();
-          while (it != messages.end() && (it->first) <= tout) {
-            deliver(it->second);
-            it = messages.erase(it);
-          }
-        }
-      }
-    }
-  }
-
-  const char* name() const override {
-    return "timer_actor";
-  }
-};
-
 using string_sink = std::function<void (std::string&&)>;
 
 // the first value is the use count, the last ostream_handle that
@@ -233,6 +157,8 @@ public:
   }
 
   void act() override {
+    detail::set_thread_name("caf.printer");
+    detail::set_thread_affinity(system().config().scheduler_utility_cpus);
     struct actor_data {
       std::string current_line;
       sink_handle redirect;
@@ -319,14 +245,25 @@ actor abstract_coordinator::printer() const {
   return actor_cast<actor>(printer_);
 }
 
+void abstract_coordinator::enqueue_batch(const std::vector<resumable*>& jobs) {
+  for (auto job : jobs)
+    enqueue(job);
+}
+
 void abstract_coordinator::start() {
   CAF_LOG_TRACE("");
-  // launch utility actors
-  timer_ = actor_cast<strong_actor_ptr>(system_.spawn<timer_actor, hidden + detached>());
+  // partitions leave timer and printer to the default scheduler
+  if (is_partition_)
+    return;
+  // launch clock thread and utility actors
+  timer_.start(system_);
   printer_ = actor_cast<strong_actor_ptr>(system_.spawn<printer_actor, hidden + detached>());
 }
 
 void abstract_coordinator::init(actor_system_config& cfg) {
+  // partitions are fully configured at construction time
+  if (is_partition_)
+    return;
   max_throughput_ = cfg.scheduler_max_throughput;
   num_workers_ = cfg.scheduler_max_threads;
 }
@@ -339,18 +276,57 @@ void* abstract_coordinator::subtype_ptr() {
   return this;
 }
 
+void abstract_coordinator::delayed_send_impl(const duration& rel_time,
+                                             strong_actor_ptr from,
+                                             strong_actor_ptr to,
+                                             message_id mid, message data) {
+  // only the default scheduler runs a clock thread
+  if (is_partition_) {
+    system_.scheduler().delayed_send(rel_time, std::move(from), std::move(to),
+                                     mid, std::move(data));
+    return;
+  }
+  timer_.schedule(rel_time, std::move(from), std::move(to), mid,
+                  std::move(data));
+}
+
+void abstract_coordinator::set_timeout(
+  intrusive_ptr<detail::behavior_timeout>& x, actor_control_block* self,
+  const duration& rel_time, uint32_t tid) {
+  if (is_partition_) {
+    system_.scheduler().set_timeout(x, self, rel_time, tid);
+    return;
+  }
+  timer_.arm(x, self, rel_time, tid);
+}
+
 void abstract_coordinator::stop_actors() {
   CAF_LOG_TRACE("");
+  if (is_partition_)
+    return;
   scoped_actor self{system_, true};
-  anon_send_exit(timer_, exit_reason::user_shutdown);
+  timer_.stop();
   anon_send_exit(printer_, exit_reason::user_shutdown);
-  self->wait_for(timer_, printer_);
+  self->wait_for(printer_);
 }
 
 abstract_coordinator::abstract_coordinator(actor_system& sys)
     : next_worker_(0),
       max_throughput_(0),
       num_workers_(0),
+      is_partition_(false),
+      partition_name_(atom("")),
+      system_(sys) {
+  // nop
+}
+
+abstract_coordinator::abstract_coordinator(
+  actor_system& sys, const actor_system_config::scheduler_partition& x)
+    : next_worker_(0),
+      max_throughput_(x.max_throughput),
+      num_workers_(x.max_threads > 0 ? x.max_threads : 1),
+      is_partition_(true),
+      partition_name_(x.name),
       system_(sys) {
   // nop
 }
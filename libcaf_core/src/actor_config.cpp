@@ -24,7 +24,11 @@ namespace caf {
 actor_config::actor_config(execution_unit* ptr)
   : host(ptr),
     flags(abstract_channel::is_abstract_actor_flag),
-    groups(nullptr) {
+    groups(nullptr),
+    partition(nullptr),
+    mailbox_capacity(0),
+    mailbox_overflow(overflow_policy::drop_newest),
+    conflation_slots(0) {
   // nop
 }
 
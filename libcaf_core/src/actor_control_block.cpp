@@ -48,6 +48,13 @@ void actor_control_block::enqueue(mailbox_element_ptr what,
   get()->enqueue(std::move(what), host);
 }
 
+void actor_control_block::enqueue_batch(strong_actor_ptr sender,
+                                        message_id mid,
+                                        std::vector<message> xs,
+                                        execution_unit* host) {
+  get()->enqueue_batch(std::move(sender), mid, std::move(xs), host);
+}
+
 bool intrusive_ptr_upgrade_weak(actor_control_block* x) {
   auto count = x->strong_refs.load();
   while (count != 0)
@@ -26,8 +26,14 @@
 #include "caf/event_based_actor.hpp"
 #include "caf/actor_system_config.hpp"
 
+#include "caf/detail/blocking_pool.hpp"
+#include "caf/detail/memory_accounting.hpp"
+#include "caf/detail/mailbox_metrics_registry.hpp"
+
 #include "caf/policy/work_sharing.hpp"
 #include "caf/policy/work_stealing.hpp"
+#include "caf/policy/lock_free_work_sharing.hpp"
+#include "caf/policy/lock_free_work_stealing.hpp"
 
 #include "caf/scheduler/coordinator.hpp"
 #include "caf/scheduler/test_coordinator.hpp"
@@ -209,23 +215,37 @@ actor_system::actor_system(actor_system_config& cfg)
   using test = scheduler::test_coordinator;
   using share = scheduler::coordinator<policy::work_sharing>;
   using steal = scheduler::coordinator<policy::work_stealing>;
+  using lf_steal = scheduler::coordinator<policy::lock_free_work_stealing>;
+  using lf_share = scheduler::coordinator<policy::lock_free_work_sharing>;
   using profiled_share = scheduler::profiled_coordinator<policy::work_sharing>;
   using profiled_steal = scheduler::profiled_coordinator<policy::work_stealing>;
+  using profiled_lf_steal =
+    scheduler::profiled_coordinator<policy::lock_free_work_stealing>;
+  using profiled_lf_share =
+    scheduler::profiled_coordinator<policy::lock_free_work_sharing>;
   // set scheduler only if not explicitly loaded by user
   if (!sched) {
     enum sched_conf {
-      stealing          = 0x0001,
-      sharing           = 0x0002,
-      testing           = 0x0003,
-      profiled          = 0x0100,
-      profiled_stealing = 0x0101,
-      profiled_sharing  = 0x0102
+      stealing             = 0x0001,
+      sharing              = 0x0002,
+      testing              = 0x0003,
+      lf_stealing          = 0x0004,
+      lf_sharing           = 0x0005,
+      profiled             = 0x0100,
+      profiled_stealing    = 0x0101,
+      profiled_sharing     = 0x0102,
+      profiled_lf_stealing = 0x0104,
+      profiled_lf_sharing  = 0x0105
     };
     sched_conf sc = stealing;
     if (cfg.scheduler_policy == atom("sharing"))
       sc = sharing;
     else if (cfg.scheduler_policy == atom("testing"))
       sc = testing;
+    else if (cfg.scheduler_policy == atom("lf-steal"))
+      sc = lf_stealing;
+    else if (cfg.scheduler_policy == atom("lf-share"))
+      sc = lf_sharing;
     else if (cfg.scheduler_policy != atom("stealing"))
       std::cerr << "[WARNING] " << deep_to_string(cfg.scheduler_policy)
                 << " is an unrecognized scheduler pollicy, "
@@ -240,16 +260,53 @@ actor_system::actor_system(actor_system_config& cfg)
       case sharing:
         sched.reset(new share(*this));
         break;
+      case lf_stealing:
+        sched.reset(new lf_steal(*this));
+        break;
+      case lf_sharing:
+        sched.reset(new lf_share(*this));
+        break;
       case profiled_stealing:
         sched.reset(new profiled_steal(*this));
         break;
       case profiled_sharing:
         sched.reset(new profiled_share(*this));
         break;
+      case profiled_lf_stealing:
+        sched.reset(new profiled_lf_steal(*this));
+        break;
+      case profiled_lf_sharing:
+        sched.reset(new profiled_lf_share(*this));
+        break;
       case testing:
         sched.reset(new test(*this));
     }
   }
+  // create dedicated worker pools for all scheduler partitions
+  for (auto& x : cfg.scheduler_partitions) {
+    scheduler::abstract_coordinator* ptr;
+    if (x.policy == atom("sharing"))
+      ptr = new scheduler::coordinator<policy::work_sharing>(*this, x);
+    else if (x.policy == atom("lf-steal"))
+      ptr = new scheduler::coordinator<policy::lock_free_work_stealing>(*this,
+                                                                        x);
+    else if (x.policy == atom("lf-share"))
+      ptr = new scheduler::coordinator<policy::lock_free_work_sharing>(*this,
+                                                                       x);
+    else {
+      if (x.policy != atom("stealing"))
+        std::cerr << "[WARNING] " << deep_to_string(x.policy)
+                  << " is an unrecognized scheduler policy for partition "
+                  << deep_to_string(x.name)
+                  << ", falling back to 'stealing' (i.e. work-stealing)"
+                  << std::endl;
+      ptr = new scheduler::coordinator<policy::work_stealing>(*this, x);
+    }
+    partitions_.emplace_back(ptr);
+  }
+  blocking_pool_.reset(new detail::blocking_pool(*this));
+  mailbox_metrics_.reset(new detail::mailbox_metrics_registry(*this));
+  memory_accounting_.reset(new detail::memory_accounting(*this));
   // initialize state for each module and give each module the opportunity
   // to influence the system configuration, e.g., by adding more types
   logger_->init(cfg);
@@ -268,14 +325,18 @@ actor_system::actor_system(actor_system_config& cfg)
   for (auto& mod : modules_)
     if (mod)
       mod->start();
+  for (auto& partition : partitions_)
+    partition->start();
   groups_.start();
   logger_->start();
+  mailbox_metrics_->start();
 }
 
 actor_system::~actor_system() {
   CAF_LOG_DEBUG("shutdown actor system");
   if (await_actors_before_shutdown_)
     await_all_actors_done();
+  mailbox_metrics_->stop();
   // shutdown system-level servers
   anon_send_exit(spawn_serv_, exit_reason::user_shutdown);
   anon_send_exit(config_serv_, exit_reason::user_shutdown);
@@ -286,6 +347,10 @@ actor_system::~actor_system() {
   registry_.erase(atom("ConfigServ"));
   // group module is the first one, relies on MM
   groups_.stop();
+  // partitions run user actors only and are stopped before any module
+  for (auto& partition : partitions_)
+    partition->stop();
+  blocking_pool_->stop();
   // stop modules in reverse order
   for (auto i = modules_.rbegin(); i != modules_.rend(); ++i)
     if (*i)
@@ -311,6 +376,15 @@ scheduler::abstract_coordinator& actor_system::scheduler() {
   return *static_cast<ptr>(modules_[module::scheduler].get());
 }
 
+scheduler::abstract_coordinator*
+actor_system::scheduler_partition(atom_value name) {
+  for (auto& partition : partitions_)
+    if (partition->partition_name() == name)
+      return partition.get();
+  CAF_LOG_WARNING("no scheduler partition named" << CAF_ARG(name));
+  return nullptr;
+}
+
 caf::logger& actor_system::logger() {
   return *logger_;
 }
@@ -361,6 +435,38 @@ scoped_execution_unit* actor_system::dummy_execution_unit() {
   return &dummy_execution_unit_;
 }
 
+detail::blocking_pool& actor_system::blocking_pool() {
+  return *blocking_pool_;
+}
+
+detail::mailbox_metrics_registry& actor_system::mailbox_metrics() {
+  return *mailbox_metrics_;
+}
+
+std::vector<mailbox_stats> actor_system::mailbox_snapshot() {
+  return mailbox_metrics_->snapshot();
+}
+
+optional<mailbox_stats> actor_system::mailbox_snapshot(actor_id aid) {
+  return mailbox_metrics_->snapshot(aid);
+}
+
+detail::memory_accounting& actor_system::memory_accounting() {
+  return *memory_accounting_;
+}
+
+std::vector<memory_stats> actor_system::memory_top(size_t n) {
+  return memory_accounting_->top(n);
+}
+
+optional<memory_stats> actor_system::memory_snapshot(actor_id aid) {
+  return memory_accounting_->snapshot(aid);
+}
+
+size_t actor_system::memory_in_use() {
+  return memory_accounting_->total();
+}
+
 actor_id actor_system::next_actor_id() {
   return ++ids_;
 }
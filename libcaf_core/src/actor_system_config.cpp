@@ -96,16 +96,31 @@ actor_system_config::actor_system_config()
   work_stealing_moderate_sleep_duration_us = 50;
   work_stealing_relaxed_steal_interval = 1;
   work_stealing_relaxed_sleep_duration_us = 10000;
+  work_stealing_idle_strategy = atom("park");
+  work_stealing_victim_selection = atom("random");
+  work_stealing_run_next_limit = 16;
+  work_stealing_steal_half = false;
+  work_sharing_queue_capacity = 4096;
+  blocking_pool_max_threads = 256;
+  blocking_pool_idle_timeout_ms = 1000;
+  mailbox_max_priority_streak = 0;
+  mailbox_metrics_ms_interval = 0;
+  mailbox_memory_accounting = false;
+  mailbox_memory_budget = 0;
+  mailbox_budget_policy = atom("reject");
   logger_filename = "actor_log_[PID]_[TIMESTAMP]_[NODE].log";
   logger_console = atom("NONE");
   middleman_network_backend = atom("default");
   middleman_enable_automatic_connections = false;
   middleman_max_consecutive_reads = 50;
   middleman_heartbeat_interval = 0;
+  middleman_zero_copy_threshold = 1024;
   // fill our options vector for creating INI and CLI parsers
   opt_group{options_, "scheduler"}
   .add(scheduler_policy, "policy",
-       "sets the scheduling policy to either 'stealing' (default) or 'sharing'")
+       "sets the scheduling policy to 'stealing' (default), 'lf-steal' "
+       "(lock-free work stealing), 'sharing' or 'lf-share' (lock-free "
+       "work sharing)")
   .add(scheduler_max_threads, "max-threads",
        "sets a fixed number of worker threads for the scheduler")
   .add(scheduler_max_throughput, "max-throughput",
@@ -115,7 +130,11 @@ actor_system_config::actor_system_config()
   .add(scheduler_profiling_ms_resolution, "profiling-ms-resolution",
        "sets the rate in ms in which the profiler collects data")
   .add(scheduler_profiling_output_file, "profiling-output-file",
-       "sets the output file for the profiler");
+       "sets the output file for the profiler")
+  .add(scheduler_worker_cpus, "worker-cpus",
+       "pins worker N to the N-th CPU of given list, e.g., '0-3,8-11'")
+  .add(scheduler_utility_cpus, "utility-cpus",
+       "pins timer, printer and logger threads to given list of CPUs");
   opt_group(options_, "work-stealing")
   .add(work_stealing_aggressive_poll_attempts, "aggressive-poll-attempts",
        "sets the number of zero-sleep-interval polling attempts")
@@ -130,7 +149,38 @@ actor_system_config::actor_system_config()
   .add(work_stealing_relaxed_steal_interval, "relaxed-steal-interval",
        "sets the frequency of steal attempts during relaxed polling")
   .add(work_stealing_relaxed_sleep_duration_us, "relaxed-sleep-duration",
-       "sets the sleep interval between poll attempts during relaxed polling");
+       "sets the sleep interval between poll attempts during relaxed polling")
+  .add(work_stealing_idle_strategy, "idle-strategy",
+       "sets the relaxed strategy to either 'park' (default) or 'sleep'")
+  .add(work_stealing_victim_selection, "victim-selection",
+       "sets the victim selection to 'random' (default) or 'topology'")
+  .add(work_stealing_run_next_limit, "run-next-limit",
+       "sets the max. number of run-next jobs in a row (0 disables the slot)")
+  .add(work_stealing_steal_half, "steal-half",
+       "enables stealing up to half of a victim's queue at once");
+  opt_group(options_, "work-sharing")
+  .add(work_sharing_queue_capacity, "queue-capacity",
+       "sets the capacity of the lock-free job queue used by 'lf-share'");
+  opt_group(options_, "blocking-pool")
+  .add(blocking_pool_max_threads, "max-threads",
+       "sets the max. number of threads for actors spawned as 'pooled'")
+  .add(blocking_pool_idle_timeout_ms, "idle-timeout",
+       "sets the time (ms) after which idle threads of the pool terminate");
+  opt_group(options_, "mailbox")
+  .add(mailbox_max_priority_streak, "max-priority-streak",
+       "sets the max. number of high-priority messages in a row (0 = no max.)")
+  .add(mailbox_metrics_ms_interval, "metrics-ms-interval",
+       "sets the rate in ms for writing mailbox metrics (0 = never)")
+  .add(mailbox_metrics_output_file, "metrics-output-file",
+       "sets the output file for mailbox metrics (default: std::cerr)")
+  .add(mailbox_memory_accounting, "memory-accounting",
+       "enables attributing the memory of pending messages to actors")
+  .add(mailbox_memory_budget, "memory-budget",
+       "sets a system-wide memory budget in bytes, implies memory "
+       "accounting (0 = unlimited)")
+  .add(mailbox_budget_policy, "budget-policy",
+       "sets the policy for messages beyond the budget to 'reject' "
+       "(default), 'drop-new', 'drop-old' or 'block'");
   opt_group{options_, "logger"}
   .add(logger_filename, "filename",
        "sets the filesystem path of the log file")
@@ -150,7 +200,12 @@ actor_system_config::actor_system_config()
   .add(middleman_max_consecutive_reads, "max-consecutive-reads",
        "sets the maximum number of consecutive I/O reads per broker")
   .add(middleman_heartbeat_interval, "heartbeat-interval",
-       "sets the interval (ms) of heartbeat, 0 (default) means disabling it");
+       "sets the interval (ms) of heartbeat, 0 (default) means disabling it")
+  .add(middleman_multiplexer_cpus, "multiplexer-cpus",
+       "pins the multiplexer thread to given list of CPUs")
+  .add(middleman_zero_copy_threshold, "zero-copy-threshold",
+       "sets the minimum size of byte chunks sent without copying them, "
+       "0 disables zero-copy writes");
   opt_group(options_, "opencl")
   .add(opencl_device_ids, "device-ids",
        "restricts which OpenCL devices are accessed by CAF");
@@ -284,8 +339,14 @@ actor_system_config& actor_system_config::parse(message& args,
                    atom("asio")
 #                  endif
                   }, middleman_network_backend, "middleman.network-backend");
-  verify_atom_opt({atom("stealing"), atom("sharing")},
+  verify_atom_opt({atom("stealing"), atom("lf-steal"), atom("sharing"),
+                   atom("lf-share")},
                   scheduler_policy, "scheduler.policy ");
+  verify_atom_opt({atom("park"), atom("sleep")},
+                  work_stealing_idle_strategy, "work-stealing.idle-strategy");
+  verify_atom_opt({atom("random"), atom("topology")},
+                  work_stealing_victim_selection,
+                  "work-stealing.victim-selection");
   if (res.opts.count("caf#dump-config") != 0u) {
     cli_helptext_printed = true;
     std::string category;
@@ -303,6 +364,16 @@ actor_system_config& actor_system_config::parse(message& args,
   return *this;
 }
 
+actor_system_config&
+actor_system_config::add_scheduler_partition(atom_value name,
+                                             size_t max_threads,
+                                             atom_value policy,
+                                             size_t max_throughput) {
+  scheduler_partitions.push_back(
+    scheduler_partition{name, policy, max_threads, max_throughput});
+  return *this;
+}
+
 actor_system_config&
 actor_system_config::add_actor_factory(std::string name, actor_factory fun) {
   actor_factories.emplace(std::move(name), std::move(fun));
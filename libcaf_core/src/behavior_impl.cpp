@@ -37,6 +37,15 @@ public:
     return x == match_case::no_match ? second->invoke(f, xs) : x;
   }
 
+  bool may_match(uint32_t tt) const override {
+    return first->may_match(tt) || second->may_match(tt);
+  }
+
+  const batch_factory* batch_for(const type_erased_tuple& xs) const override {
+    auto result = first->batch_for(xs);
+    return result != nullptr ? result : second->batch_for(xs);
+  }
+
   void handle_timeout() override {
     // the second behavior overrides the timeout handling of
     // first behavior
@@ -89,7 +98,8 @@ behavior_impl::~behavior_impl() {
 behavior_impl::behavior_impl(duration tout)
     : timeout_(tout),
       begin_(nullptr),
-      end_(nullptr) {
+      end_(nullptr),
+      has_batches_(false) {
   // nop
 }
 
@@ -115,6 +125,32 @@ match_case::result behavior_impl::invoke(detail::invoke_result_visitor& f,
   return match_case::no_match;
 }
 
+bool behavior_impl::may_match(uint32_t tt) const {
+  for (auto i = begin_; i != end_; ++i)
+    if (i->type_token == tt)
+      return true;
+  return false;
+}
+
+const batch_factory*
+behavior_impl::batch_for(const type_erased_tuple& xs) const {
+  if (!has_batches_)
+    return nullptr;
+  for (auto i = begin_; i != end_; ++i) {
+    auto f = i->ptr->batch();
+    if (f != nullptr && f->accepts(xs))
+      return f;
+  }
+  return nullptr;
+}
+
+void behavior_impl::init_batches() {
+  has_batches_ = false;
+  for (auto i = begin_; i != end_; ++i)
+    if (i->ptr->batch() != nullptr)
+      has_batches_ = true;
+}
+
 optional<message> behavior_impl::invoke(message& xs) {
   maybe_message_visitor f;
   // the following const-cast is safe, because invoke() is aware of
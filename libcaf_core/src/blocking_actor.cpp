@@ -25,6 +25,7 @@
 #include "caf/actor_system.hpp"
 #include "caf/actor_registry.hpp"
 
+#include "caf/detail/set_thread_name.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 #include "caf/detail/invoke_result_visitor.hpp"
 #include "caf/detail/default_invoke_result_visitor.hpp"
@@ -60,25 +61,52 @@ blocking_actor::~blocking_actor() {
   // avoid weak-vtables warning
 }
 
-void blocking_actor::enqueue(mailbox_element_ptr ptr, execution_unit*) {
+void blocking_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   CAF_ASSERT(ptr != nullptr);
   CAF_ASSERT(getf(is_blocking_flag));
   CAF_LOG_TRACE(CAF_ARG(*ptr));
   CAF_LOG_SEND_EVENT(ptr);
   auto mid = ptr->mid;
   auto src = ptr->sender;
-  // returns false if mailbox has been closed
-  if (!mailbox().synchronized_enqueue(mtx_, cv_, ptr.release())) {
-    CAF_LOG_REJECT_EVENT();
-    if (mid.is_request()) {
-      detail::sync_request_bouncer srb{exit_reason()};
-      srb(src, mid);
+  auto x = ptr.release();
+  metrics_enqueue(*x);
+  auto res = enqueue_to_mailbox(x, eu);
+  switch (res) {
+    case detail::enqueue_result::unblocked_reader: {
+      CAF_LOG_ACCEPT_EVENT();
+      std::unique_lock<std::mutex> guard(mtx_);
+      cv_.notify_one();
+      break;
     }
-  } else {
-    CAF_LOG_ACCEPT_EVENT();
+    case detail::enqueue_result::queue_closed:
+      CAF_LOG_REJECT_EVENT();
+      metrics_drop();
+      if (mid.is_request()) {
+        detail::sync_request_bouncer srb{exit_reason()};
+        srb(src, mid);
+      }
+      break;
+    case detail::enqueue_result::success:
+      CAF_LOG_ACCEPT_EVENT();
+      break;
+    case detail::enqueue_result::queue_full:
+      // dropped by the overflow policy of a bounded mailbox
+      CAF_LOG_REJECT_EVENT();
+      metrics_drop();
+      break;
   }
 }
 
+void blocking_actor::enqueue_batch(std::vector<mailbox_element_ptr> xs,
+                                   execution_unit* eu) {
+  CAF_ASSERT(getf(is_blocking_flag));
+  CAF_LOG_TRACE(CAF_ARG(xs.size()));
+  if (xs.empty() || !enqueue_batch_to_mailbox(xs, eu))
+    return;
+  std::unique_lock<std::mutex> guard(mtx_);
+  cv_.notify_one();
+}
+
 const char* blocking_actor::name() const {
   return "blocking_actor";
 }
@@ -91,6 +119,7 @@ void blocking_actor::launch(execution_unit*, bool, bool hide) {
   home_system().inc_detached_threads();
   std::thread([](strong_actor_ptr ptr) {
     // actor lives in its own thread
+    detail::set_thread_name("caf.blocking");
     auto this_ptr = ptr->get();
     CAF_ASSERT(dynamic_cast<blocking_actor*>(this_ptr) != 0);
     auto self = static_cast<blocking_actor*>(this_ptr);
@@ -166,10 +195,19 @@ public:
   using cache_type = local_actor::mailbox_type::cache_type;
   using iterator = cache_type::iterator;
 
-  cached_sequence(cache_type& cache)
-      : cache_(cache),
-        i_(cache.continuation()),
-        e_(cache.end()) {
+  cached_sequence(blocking_actor* self, message_id mid)
+      : self_(self),
+        i_(self->mailbox().cache().continuation()),
+        e_(self->mailbox().cache().end()),
+        single_(mid.valid()) {
+    if (single_) {
+      // only the response with ID `mid` can match, look it up in O(1)
+      auto ptr = self->cache_index().response(mid);
+      i_ = ptr != nullptr && !ptr->marked ? iterator{ptr} : e_;
+      if (i_ != e_)
+        i_->marked = true;
+      return;
+    }
     // iterater to the first un-marked element
     i_ = advance_impl(i_);
   }
@@ -181,12 +219,14 @@ public:
   void advance() override {
     CAF_ASSERT(i_->marked);
     i_->marked = false;
-    i_ = advance_impl(i_.next());
+    i_ = single_ ? e_ : advance_impl(i_.next());
   }
 
   void erase_and_advance() override {
     CAF_ASSERT(i_->marked);
-    i_ = advance_impl(cache_.erase(i_));
+    auto next = i_.next();
+    self_->erase_from_cache(i_.ptr);
+    i_ = single_ ? e_ : advance_impl(next);
   }
 
   bool await_value(bool) override {
@@ -210,9 +250,10 @@ public:
     return i;
   }
 
-  cache_type& cache_;
+  blocking_actor* self_;
   iterator i_;
   iterator e_;
+  bool single_;
 };
 
 class mailbox_sequence : public message_sequence {
@@ -316,7 +357,7 @@ void blocking_actor::receive_impl(receive_cond& rcc,
                                   detail::blocking_behavior& bhvr) {
   CAF_LOG_TRACE(CAF_ARG(mid));
   // we start iterating the cache and iterating mailbox elements afterwards
-  cached_sequence seq1{mailbox().cache()};
+  cached_sequence seq1{this, mid};
   mailbox_sequence seq2{this, bhvr.timeout()};
   message_sequence_combinator seq{&seq1, &seq2};
   detail::default_invoke_result_visitor<blocking_actor> visitor{this};
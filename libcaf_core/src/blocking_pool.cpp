@@ -0,0 +1,124 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/blocking_pool.hpp"
+
+#include <thread>
+
+#include "caf/logger.hpp"
+#include "caf/resumable.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/scoped_execution_unit.hpp"
+
+#include "caf/detail/set_thread_name.hpp"
+
+namespace caf {
+namespace detail {
+
+blocking_pool::blocking_pool(actor_system& sys)
+    : system_(sys),
+      max_throughput_(sys.config().scheduler_max_throughput),
+      idle_timeout_(sys.config().blocking_pool_idle_timeout_ms),
+      num_threads_(0),
+      num_idle_(0),
+      stopped_(false) {
+  auto x = sys.config().blocking_pool_max_threads;
+  max_threads_ = x > 0 ? x : 1;
+}
+
+void blocking_pool::enqueue(resumable* job) {
+  CAF_ASSERT(job != nullptr);
+  std::unique_lock<std::mutex> guard{mtx_};
+  jobs_.push_back(job);
+  // idle threads that have been notified but did not yet pick up a job
+  // remain in `num_idle_`, i.e., we grow only if no thread can take `job`
+  if (num_idle_ >= jobs_.size() || num_threads_ == max_threads_) {
+    cv_.notify_one();
+    return;
+  }
+  ++num_threads_;
+  system_.inc_detached_threads();
+  std::thread{[this] {
+    set_thread_name("caf.pooled");
+    run();
+    // must be the last access to this pool, since the actor system destroys
+    // the pool only after all detached threads are done
+    system_.dec_detached_threads();
+  }}.detach();
+}
+
+void blocking_pool::stop() {
+  std::unique_lock<std::mutex> guard{mtx_};
+  stopped_ = true;
+  cv_.notify_all();
+}
+
+size_t blocking_pool::num_threads() {
+  std::unique_lock<std::mutex> guard{mtx_};
+  return num_threads_;
+}
+
+size_t blocking_pool::num_idle_threads() {
+  std::unique_lock<std::mutex> guard{mtx_};
+  return num_idle_;
+}
+
+void blocking_pool::run() {
+  CAF_SET_LOGGER_SYS(&system_);
+  CAF_LOG_TRACE("");
+  // spawns and wakeups of non-pooled actors go to the scheduler
+  scoped_execution_unit ctx{&system_};
+  auto has_work = [&] { return !jobs_.empty() || stopped_; };
+  std::unique_lock<std::mutex> guard{mtx_};
+  for (;;) {
+    if (jobs_.empty()) {
+      if (stopped_)
+        break;
+      ++num_idle_;
+      auto awoken = cv_.wait_for(guard, idle_timeout_, has_work);
+      --num_idle_;
+      if (!awoken)
+        break;
+      continue;
+    }
+    auto job = jobs_.front();
+    jobs_.pop_front();
+    guard.unlock();
+    switch (job->resume(&ctx, max_throughput_)) {
+      case resumable::resume_later:
+        // keep reference to the job, it goes to the end of the queue to give
+        // other jobs a chance to run if the pool reached its maximum size
+        guard.lock();
+        jobs_.push_back(job);
+        break;
+      case resumable::done:
+      case resumable::awaiting_message:
+      case resumable::shutdown_execution_unit:
+        // releasing the job may destroy an actor, so we do this unlocked
+        intrusive_ptr_release(job);
+        guard.lock();
+        break;
+    }
+  }
+  --num_threads_;
+}
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,108 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/byte_chunk.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include "caf/make_counted.hpp"
+#include "caf/serializer.hpp"
+#include "caf/deserializer.hpp"
+
+namespace caf {
+
+byte_chunk::storage::storage(std::vector<char> buf) : buf_(std::move(buf)) {
+  // nop
+}
+
+byte_chunk::storage::~storage() {
+  // nop
+}
+
+byte_chunk::byte_chunk() noexcept : data_(nullptr), size_(0) {
+  // nop
+}
+
+byte_chunk::byte_chunk(std::vector<char> buf) : data_(nullptr), size_(0) {
+  if (buf.empty())
+    return;
+  storage_ = make_counted<storage>(std::move(buf));
+  data_ = storage_->buf().data();
+  size_ = storage_->buf().size();
+}
+
+byte_chunk::byte_chunk(storage_ptr ptr, const char* data, size_t size) noexcept
+    : storage_(std::move(ptr)),
+      data_(data),
+      size_(size) {
+  // nop
+}
+
+byte_chunk byte_chunk::copy(const void* buf, size_t num_bytes) {
+  auto first = reinterpret_cast<const char*>(buf);
+  return byte_chunk{std::vector<char>(first, first + num_bytes)};
+}
+
+byte_chunk byte_chunk::slice(size_t offset, size_t len) const {
+  offset = std::min(offset, size_);
+  len = std::min(len, size_ - offset);
+  if (len == 0)
+    return {};
+  return {storage_, data_ + offset, len};
+}
+
+void byte_chunk::reset() noexcept {
+  storage_.reset();
+  data_ = nullptr;
+  size_ = 0;
+}
+
+std::vector<char> byte_chunk::to_vector() const {
+  return {begin(), end()};
+}
+
+int byte_chunk::compare(const byte_chunk& other) const noexcept {
+  auto n = std::min(size_, other.size_);
+  auto res = n > 0 ? memcmp(data_, other.data_, n) : 0;
+  if (res != 0)
+    return res;
+  return size_ < other.size_ ? -1 : (size_ == other.size_ ? 0 : 1);
+}
+
+error inspect(serializer& f, byte_chunk& x) {
+  return f.apply_chunk(x);
+}
+
+error inspect(deserializer& f, byte_chunk& x) {
+  size_t n = 0;
+  std::vector<char> buf;
+  auto e = error::eval([&] { return f.begin_sequence(n); },
+                       [&] {
+                         buf.resize(n);
+                         return f.apply_raw(n, buf.data());
+                       },
+                       [&] { return f.end_sequence(); });
+  if (e)
+    return e;
+  x = byte_chunk{std::move(buf)};
+  return none;
+}
+
+} // namespace caf
@@ -0,0 +1,81 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/cache_index.hpp"
+
+#include "caf/mailbox_element.hpp"
+
+namespace caf {
+namespace detail {
+
+constexpr cache_index::key_type cache_index::response_key;
+
+cache_index::cache_index()
+    : next_high_(1),
+      next_normal_(position{1} << 62) {
+  // nop
+}
+
+void cache_index::add(mailbox_element* x, bool high_priority) {
+  CAF_ASSERT(x != nullptr);
+  auto key = key_of(*x);
+  auto pos = high_priority ? next_high_++ : next_normal_++;
+  by_key_[key].emplace(pos, x);
+  entries_.emplace(x, entry{key, pos});
+  if (key == response_key)
+    responses_.emplace(x->mid.integer_value(), x);
+}
+
+void cache_index::erase(mailbox_element* x) {
+  auto i = entries_.find(x);
+  if (i == entries_.end())
+    return;
+  auto j = by_key_.find(i->second.key);
+  CAF_ASSERT(j != by_key_.end());
+  j->second.erase(i->second.pos);
+  // drop empty buckets to keep `next` cheap
+  if (j->second.empty())
+    by_key_.erase(j);
+  if (i->second.key == response_key) {
+    auto k = responses_.find(x->mid.integer_value());
+    if (k != responses_.end() && k->second == x)
+      responses_.erase(k);
+  }
+  entries_.erase(i);
+}
+
+void cache_index::clear() {
+  by_key_.clear();
+  entries_.clear();
+  responses_.clear();
+}
+
+mailbox_element* cache_index::response(message_id mid) const {
+  auto i = responses_.find(mid.integer_value());
+  return i != responses_.end() ? i->second : nullptr;
+}
+
+cache_index::key_type cache_index::key_of(mailbox_element& x) {
+  if (x.mid.is_response())
+    return response_key;
+  return x.content().type_token();
+}
+
+} // namespace detail
+} // namespace caf
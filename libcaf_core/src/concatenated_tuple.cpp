@@ -57,6 +57,10 @@ message_data::cow_ptr concatenated_tuple::copy() const {
   return cow_ptr(new concatenated_tuple(*this), false);
 }
 
+size_t concatenated_tuple::memory_footprint() const noexcept {
+  return sizeof(concatenated_tuple) + data_.capacity() * sizeof(cow_ptr);
+}
+
 void* concatenated_tuple::get_mutable(size_t pos) {
   CAF_ASSERT(pos < size());
   auto selected = select(pos);
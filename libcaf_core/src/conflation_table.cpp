@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/conflation_table.hpp"
+
+#include "caf/system_messages.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+enum slot_state {
+  free_slot,
+  claimed_slot,
+  used_slot
+};
+
+// spreads consecutive keys over the table (finalizer of MurmurHash3)
+uint64_t mix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+} // namespace <anonymous>
+
+conflation_table::slot::slot() : state(free_slot), key(0), latest(nullptr) {
+  // nop
+}
+
+conflation_table::slot::~slot() {
+  // the reader is gone, i.e., nobody is going to process this message
+  mailbox_element_ptr{latest.load()};
+}
+
+void conflation_table::slot::request_deletion(bool) noexcept {
+  // the mailbox dropped this slot without handing it to the reader, e.g.,
+  // after closing the mailbox, hence the message never reaches the actor
+  mailbox_element_ptr{latest.exchange(nullptr)};
+}
+
+conflation_table::conflation_table(conflation_key_fun fun, size_t capacity)
+    : fun_(std::move(fun)) {
+  size_t n = 1;
+  while (n < capacity)
+    n <<= 1;
+  mask_ = n - 1;
+  slots_.reset(new slot[n]);
+  first_ = reinterpret_cast<const char*>(&slots_[0]);
+  last_ = reinterpret_cast<const char*>(&slots_[0] + n);
+}
+
+conflation_table::~conflation_table() {
+  // nop
+}
+
+conflation_table::slot* conflation_table::slot_for(mailbox_element& x) {
+  if (!x.mid.is_async())
+    return nullptr;
+  auto& content = x.content();
+  auto tk = content.type_token();
+  if (tk == make_type_token<exit_msg>() || tk == make_type_token<down_msg>())
+    return nullptr;
+  auto k = fun_(content);
+  if (!k)
+    return nullptr;
+  // linear probing, keys never leave the table
+  auto pos = mix(*k);
+  for (size_t i = 0; i <= mask_; ++i) {
+    auto& s = slots_[(pos + i) & mask_];
+    auto st = s.state.load();
+    if (st == free_slot) {
+      int expected = free_slot;
+      if (s.state.compare_exchange_strong(expected, claimed_slot)) {
+        s.key = *k;
+        s.state = used_slot;
+        return &s;
+      }
+      st = expected;
+    }
+    // another writer is about to store its key
+    while (st == claimed_slot)
+      st = s.state.load();
+    if (s.key == *k)
+      return &s;
+  }
+  return nullptr;
+}
+
+mailbox_element* conflation_table::take(mailbox_element* x) {
+  return static_cast<slot*>(x)->latest.exchange(nullptr);
+}
+
+} // namespace detail
+} // namespace caf
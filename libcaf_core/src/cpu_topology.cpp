@@ -0,0 +1,138 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include <map>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+// reads the first line of the file at `path`
+bool read_first_line(const std::string& path, std::string& result) {
+  std::ifstream in{path};
+  return static_cast<bool>(std::getline(in, result));
+}
+
+// returns the smallest CPU sharing the last-level cache with `cpu` or
+// `cpu` itself if sysfs has no cache information for it
+int last_level_cache(const std::string& cpu_dir, int cpu) {
+  int result = cpu;
+  int max_level = 0;
+  std::string line;
+  for (int i = 0;; ++i) {
+    auto dir = cpu_dir + "/cache/index" + std::to_string(i);
+    if (!read_first_line(dir + "/level", line))
+      return result;
+    auto level = std::atoi(line.c_str());
+    if (level < max_level || !read_first_line(dir + "/shared_cpu_list", line))
+      continue;
+    auto xs = cpu_topology::parse_cpu_list(line);
+    if (!xs.empty()) {
+      max_level = level;
+      result = *std::min_element(xs.begin(), xs.end());
+    }
+  }
+}
+
+} // namespace <anonymous>
+
+constexpr size_t cpu_topology::num_localities;
+
+cpu_topology cpu_topology::read(const std::string& root) {
+  cpu_topology result;
+  std::string line;
+  if (!read_first_line(root + "/cpu/online", line))
+    return result;
+  // map each CPU to its NUMA node, CPUs without node default to node 0
+  std::map<int, int> nodes;
+  std::string nodes_line;
+  if (read_first_line(root + "/node/online", nodes_line))
+    for (auto node : parse_cpu_list(nodes_line)) {
+      std::string cpus_line;
+      auto path = root + "/node/node" + std::to_string(node) + "/cpulist";
+      if (read_first_line(path, cpus_line))
+        for (auto id : parse_cpu_list(cpus_line))
+          nodes.emplace(id, node);
+    }
+  for (auto id : parse_cpu_list(line)) {
+    auto dir = root + "/cpu/cpu" + std::to_string(id);
+    auto i = nodes.find(id);
+    result.cpus_.push_back(cpu{id, last_level_cache(dir, id),
+                               i != nodes.end() ? i->second : 0});
+  }
+  std::sort(result.cpus_.begin(), result.cpus_.end(),
+            [](const cpu& x, const cpu& y) {
+    if (x.node != y.node)
+      return x.node < y.node;
+    if (x.cache != y.cache)
+      return x.cache < y.cache;
+    return x.id < y.id;
+  });
+  return result;
+}
+
+std::vector<int> cpu_topology::parse_cpu_list(const std::string& str) {
+  std::vector<int> result;
+  auto i = str.begin();
+  auto e = str.end();
+  auto read_int = [&](int& x) -> bool {
+    if (i == e || !isdigit(*i))
+      return false;
+    x = 0;
+    for (; i != e && isdigit(*i); ++i)
+      x = x * 10 + (*i - '0');
+    return true;
+  };
+  int first;
+  while (read_int(first)) {
+    auto last = first;
+    if (i != e && *i == '-' && (++i, !read_int(last)))
+      break;
+    for (auto x = first; x <= last; ++x)
+      result.push_back(x);
+    if (i == e || *i != ',')
+      break;
+    ++i;
+  }
+  return result;
+}
+
+void cpu_topology::retain(const std::vector<int>& ids) {
+  auto not_in_ids = [&](const cpu& x) {
+    return std::find(ids.begin(), ids.end(), x.id) == ids.end();
+  };
+  cpus_.erase(std::remove_if(cpus_.begin(), cpus_.end(), not_in_ids),
+              cpus_.end());
+}
+
+cpu_topology::locality cpu_topology::distance(const cpu& x, const cpu& y) {
+  if (x.node != y.node)
+    return remote_node;
+  return x.cache == y.cache ? shared_cache : same_node;
+}
+
+} // namespace detail
+} // namespace caf
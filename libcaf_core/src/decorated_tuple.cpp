@@ -53,6 +53,10 @@ message_data::cow_ptr decorated_tuple::copy() const {
   return cow_ptr(new decorated_tuple(*this), false);
 }
 
+size_t decorated_tuple::memory_footprint() const noexcept {
+  return sizeof(decorated_tuple) + mapping_.capacity() * sizeof(size_t);
+}
+
 void* decorated_tuple::get_mutable(size_t pos) {
   CAF_ASSERT(pos < size());
   return decorated_->get_mutable(mapping_[pos]);
@@ -53,6 +53,11 @@ message_data::cow_ptr dynamic_message_data::copy() const {
   return make_counted<dynamic_message_data>(*this);
 }
 
+size_t dynamic_message_data::memory_footprint() const noexcept {
+  return sizeof(dynamic_message_data)
+         + elements_.capacity() * sizeof(elements::value_type);
+}
+
 void* dynamic_message_data::get_mutable(size_t pos) {
   CAF_ASSERT(pos < size());
   return elements_[pos]->get_mutable();
@@ -0,0 +1,92 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/event_count.hpp"
+
+#ifdef CAF_LINUX
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+#ifdef CAF_LINUX
+
+static_assert(sizeof(std::atomic<event_count::key_type>) == sizeof(int),
+              "cannot use std::atomic<uint32_t> as futex word");
+
+int* futex_addr(std::atomic<event_count::key_type>& x) {
+  return reinterpret_cast<int*>(&x);
+}
+
+void futex_wait(std::atomic<event_count::key_type>& x,
+                event_count::key_type expected) {
+  syscall(SYS_futex, futex_addr(x), FUTEX_WAIT_PRIVATE,
+          static_cast<int>(expected), nullptr, nullptr, 0);
+}
+
+void futex_wake(std::atomic<event_count::key_type>& x, int num_threads) {
+  syscall(SYS_futex, futex_addr(x), FUTEX_WAKE_PRIVATE, num_threads, nullptr,
+          nullptr, 0);
+}
+
+#endif // CAF_LINUX
+
+} // namespace <anonymous>
+
+event_count::event_count() : epoch_(0), waiters_(0) {
+  // nop
+}
+
+void event_count::wait(key_type key) {
+# ifdef CAF_LINUX
+  // futex_wait returns immediately if epoch_ no longer equals key
+  while (epoch_.load(std::memory_order_acquire) == key)
+    futex_wait(epoch_, key);
+# else
+  std::unique_lock<std::mutex> guard{mtx_};
+  while (epoch_.load(std::memory_order_acquire) == key)
+    cv_.wait(guard);
+# endif
+  waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void event_count::notify(bool all) {
+# ifdef CAF_LINUX
+  epoch_.fetch_add(1, std::memory_order_release);
+  futex_wake(epoch_, all ? INT_MAX : 1);
+# else
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{mtx_};
+    epoch_.fetch_add(1, std::memory_order_release);
+  }
+  if (all)
+    cv_.notify_all();
+  else
+    cv_.notify_one();
+# endif
+}
+
+} // namespace detail
+} // namespace caf
@@ -23,7 +23,8 @@ namespace caf {
 
 execution_unit::execution_unit(actor_system* sys)
     : system_(sys),
-      proxies_(nullptr) {
+      proxies_(nullptr),
+      partition_(nullptr) {
   // nop
 }
 
@@ -30,10 +30,13 @@
 #include "caf/local_actor.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/actor_ostream.hpp"
+#include "caf/system_messages.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/default_attachable.hpp"
 #include "caf/binary_deserializer.hpp"
 
+#include "caf/detail/memory_accounting.hpp"
+#include "caf/detail/mailbox_metrics_registry.hpp"
 #include "caf/detail/private_thread.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 
@@ -45,12 +48,25 @@ namespace caf {
 local_actor::local_actor(actor_config& cfg)
     : monitorable_actor(cfg),
       context_(cfg.host),
+      overflow_policy_(cfg.mailbox_overflow),
       initial_behavior_fac_(std::move(cfg.init_fun)) {
-  // nop
+  mailbox_.capacity(cfg.mailbox_capacity);
+  mailbox_.max_streak(home_system().config().mailbox_max_priority_streak);
+  if (cfg.conflation_key)
+    conflation_.reset(new detail::conflation_table(
+      std::move(cfg.conflation_key), cfg.conflation_slots));
+#ifdef CAF_ENABLE_MAILBOX_METRICS
+  metrics_ = make_counted<mailbox_metrics>(id());
+  home_system().mailbox_metrics().add(metrics_);
+#endif
+  memory_ = home_system().memory_accounting().make_account(id());
 }
 
 local_actor::~local_actor() {
-  // nop
+  // nobody can enqueue to us anymore, hence the remaining charge belongs to
+  // messages the mailbox or the conflation table disposed without us
+  if (memory_)
+    memory_release(memory_->snapshot().mailbox);
 }
 
 void local_actor::on_destroy() {
@@ -62,6 +78,254 @@ void local_actor::on_destroy() {
   }
 }
 
+namespace {
+
+// blocking, detached and pooled actors own their thread, anonymous messages
+// without execution unit originate from threads outside of the scheduler
+bool may_block(const strong_actor_ptr& sender, execution_unit* eu) {
+  if (!sender)
+    return eu == nullptr;
+  auto ptr = actor_cast<abstract_actor*>(sender);
+  return ptr->getf(abstract_actor::is_blocking_flag)
+         || ptr->getf(abstract_actor::is_detached_flag)
+         || ptr->getf(abstract_actor::is_pooled_flag);
+}
+
+// responses are limited by the number of pending requests and dropping
+// exit or down messages would break links and monitors
+bool is_vital(const mailbox_element& x) {
+  auto tk = x.content().type_token();
+  return x.mid.is_response() || tk == make_type_token<exit_msg>()
+         || tk == make_type_token<down_msg>();
+}
+
+} // namespace <anonymous>
+
+void local_actor::multicast_impl(const std::vector<abstract_actor*>& dests,
+                                 message_id mid, message msg) {
+  CAF_LOG_TRACE(CAF_ARG(dests.size()) << CAF_ARG(mid) << CAF_ARG(msg));
+  auto elements = make_mailbox_elements(ctrl(), mid, std::move(msg),
+                                        dests.size());
+  std::vector<resumable*> wakeups;
+  for (size_t i = 0; i < dests.size(); ++i)
+    dests[i]->enqueue_deferred(std::move(elements[i]), context(), wakeups);
+  if (!wakeups.empty())
+    home_system().scheduler().enqueue_batch(wakeups);
+}
+
+detail::enqueue_result local_actor::enqueue_to_mailbox(mailbox_element* ptr,
+                                                       execution_unit* eu) {
+  CAF_ASSERT(ptr != nullptr);
+  if (memory_ && home_system().memory_accounting().over_budget()
+      && !is_vital(*ptr))
+    return handle_over_budget(ptr, eu);
+  auto lane = mailbox_lane(*ptr);
+  auto slot = conflation_ ? conflation_->slot_for(*ptr) : nullptr;
+  auto charged = memory_charge(*ptr);
+  if (slot == nullptr) {
+    auto res = mailbox().enqueue(ptr, lane);
+    if (res == detail::enqueue_result::queue_full)
+      res = handle_overflow(ptr, eu);
+    if (res == detail::enqueue_result::queue_full
+        || res == detail::enqueue_result::queue_closed)
+      memory_release(charged);
+    return res;
+  }
+  // the slot is in the mailbox as long as it holds a message, hence we
+  // only need to enqueue the slot after storing the first message for it
+  mailbox_element_ptr old{slot->latest.exchange(ptr)};
+  if (old) {
+    memory_release(*old);
+    metrics_drop();
+    return detail::enqueue_result::success;
+  }
+  // conflated keys bypass the capacity of bounded mailboxes, since there is
+  // at most one slot per key in the mailbox anyways
+  return mailbox().force_enqueue(slot, lane);
+}
+
+bool local_actor::enqueue_batch_to_mailbox(
+  std::vector<mailbox_element_ptr>& xs, execution_unit* eu) {
+  CAF_LOG_TRACE(CAF_ARG(xs.size()));
+  bool unblocked = false;
+  detail::sync_request_bouncer bounce{exit_reason()};
+  if (conflation_ || mailbox().capacity() > 0
+      || (memory_ && home_system().memory_accounting().over_budget())) {
+    // conflation, overflow and budget policies operate on individual elements
+    for (auto& x : xs) {
+      metrics_enqueue(*x);
+      auto mid = x->mid;
+      strong_actor_ptr sender;
+      if (mid.is_request())
+        sender = x->sender;
+      switch (enqueue_to_mailbox(x.release(), eu)) {
+        case detail::enqueue_result::unblocked_reader:
+          unblocked = true;
+          break;
+        case detail::enqueue_result::queue_closed:
+          bounce(sender, mid);
+          metrics_drop();
+          break;
+        case detail::enqueue_result::queue_full:
+          metrics_drop();
+          break;
+        default:
+          break;
+      }
+    }
+    return unblocked;
+  }
+  // link all elements of a lane from newest to oldest, i.e., in the order
+  // of the stack inside the mailbox
+  static constexpr size_t num_lanes = 2;
+  mailbox_element* first[num_lanes] = {nullptr, nullptr};
+  mailbox_element* last[num_lanes] = {nullptr, nullptr};
+  size_t n[num_lanes] = {0, 0};
+  for (auto& x : xs) {
+    metrics_enqueue(*x);
+    memory_charge(*x);
+    auto lane = mailbox_lane(*x);
+    auto ptr = x.release();
+    ptr->next = first[lane];
+    first[lane] = ptr;
+    if (last[lane] == nullptr)
+      last[lane] = ptr;
+    ++n[lane];
+  }
+  for (size_t lane = 0; lane < num_lanes; ++lane) {
+    if (n[lane] == 0)
+      continue;
+    switch (mailbox().enqueue_batch(first[lane], last[lane], n[lane], lane)) {
+      case detail::enqueue_result::unblocked_reader:
+        unblocked = true;
+        break;
+      case detail::enqueue_result::success:
+        break;
+      default: {
+        // the mailbox did not take ownership of the chain
+        auto i = first[lane];
+        for (size_t j = 0; j < n[lane]; ++j) {
+          mailbox_element_ptr ptr{i};
+          i = i->next;
+          memory_release(*ptr);
+          bounce(*ptr);
+          metrics_drop();
+        }
+      }
+    }
+  }
+  return unblocked;
+}
+
+detail::enqueue_result local_actor::handle_overflow(mailbox_element* ptr,
+                                                    execution_unit* eu) {
+  CAF_ASSERT(ptr != nullptr);
+  CAF_LOG_TRACE(CAF_ARG(*ptr));
+  mailbox_element_ptr x{ptr};
+  auto lane = mailbox_lane(*x);
+  if (is_vital(*x))
+    return mailbox().force_enqueue(x.release(), lane);
+  switch (overflow_policy_) {
+    case overflow_policy::drop_newest:
+      break;
+    case overflow_policy::drop_oldest: {
+      mailbox_element* displaced = nullptr;
+      auto res = mailbox().displace_oldest(x.get(), lane, &displaced);
+      if (res != detail::enqueue_result::queue_full) {
+        x.release();
+        if (displaced != nullptr)
+          drop_displaced(displaced);
+        return res;
+      }
+      break;
+    }
+    case overflow_policy::block:
+      if (may_block(x->sender, eu)) {
+        for (;;) {
+          mailbox().await_capacity();
+          auto res = mailbox().enqueue(x.get(), lane);
+          if (res != detail::enqueue_result::queue_full) {
+            x.release();
+            return res;
+          }
+        }
+      }
+      // fall through
+    case overflow_policy::reject: {
+      // errors are anonymous to avoid ping-pong between bounded mailboxes
+      auto& sender = x->sender;
+      if (sender)
+        sender->enqueue(nullptr, x->mid.is_request() ? x->mid.response_id()
+                                                     : message_id::make(),
+                        make_message(make_error(sec::mailbox_full)), eu);
+      break;
+    }
+  }
+  CAF_LOG_DEBUG("mailbox full, dropped message");
+  return detail::enqueue_result::queue_full;
+}
+
+detail::enqueue_result local_actor::handle_over_budget(mailbox_element* ptr,
+                                                       execution_unit* eu) {
+  CAF_ASSERT(ptr != nullptr);
+  CAF_LOG_TRACE(CAF_ARG(*ptr));
+  auto& accounting = home_system().memory_accounting();
+  mailbox_element_ptr x{ptr};
+  switch (accounting.budget_policy()) {
+    case overflow_policy::drop_newest:
+      break;
+    case overflow_policy::drop_oldest: {
+      // the new message replaces the oldest one, i.e., our mailbox does not
+      // grow, but it bypasses conflation and the capacity of the mailbox
+      auto charged = memory_charge(*x);
+      mailbox_element* displaced = nullptr;
+      auto res = mailbox().displace_oldest(x.get(), mailbox_lane(*x),
+                                           &displaced);
+      if (res == detail::enqueue_result::queue_full) {
+        memory_release(charged);
+        break;
+      }
+      x.release();
+      if (res == detail::enqueue_result::queue_closed)
+        memory_release(charged);
+      if (displaced != nullptr)
+        drop_displaced(displaced);
+      return res;
+    }
+    case overflow_policy::block:
+      if (may_block(x->sender, eu)) {
+        accounting.await_budget();
+        return enqueue_to_mailbox(x.release(), eu);
+      }
+      // fall through
+    case overflow_policy::reject: {
+      auto& sender = x->sender;
+      if (sender)
+        sender->enqueue(nullptr, x->mid.is_request() ? x->mid.response_id()
+                                                     : message_id::make(),
+                        make_message(make_error(sec::memory_budget_exceeded)),
+                        eu);
+      break;
+    }
+  }
+  CAF_LOG_DEBUG("memory budget exceeded, dropped message");
+  return detail::enqueue_result::queue_full;
+}
+
+void local_actor::drop_displaced(mailbox_element* x) {
+  CAF_ASSERT(x != nullptr);
+  // displacing a slot drops the newest message for its key
+  if (conflation_ && conflation_->owns(x)) {
+    mailbox_element_ptr ptr{detail::conflation_table::take(x)};
+    if (ptr)
+      memory_release(*ptr);
+  } else {
+    mailbox_element_ptr ptr{x};
+    memory_release(*ptr);
+  }
+  metrics_drop();
+}
+
 void local_actor::request_response_timeout(const duration& d, message_id mid) {
   CAF_LOG_TRACE(CAF_ARG(d) << CAF_ARG(mid));
   if (!d.valid())
@@ -88,6 +352,10 @@ void local_actor::on_exit() {
   // nop
 }
 
+void local_actor::arena_checkpoint() {
+  // nop
+}
+
 
 message_id local_actor::new_request_id(message_priority mp) {
   auto result = ++last_request_id_;
@@ -95,51 +363,41 @@ message_id local_actor::new_request_id(message_priority mp) {
 }
 
 mailbox_element_ptr local_actor::next_message() {
-  if (!getf(is_priority_aware_flag))
-    return mailbox_element_ptr{mailbox().try_pop()};
-  // we partition the mailbox into four segments in this case:
-  // <-------- ! was_skipped --------> | <--------  was_skipped  -------->
-  // <-- high prio --><-- low prio --> | <-- high prio --><-- low prio -->
-  auto& cache = mailbox().cache();
-  auto i = cache.begin();
-  auto e = cache.separator();
-  // read elements from mailbox if we don't have a high
-  // priority message or if cache is empty
-  if (i == e || !i->is_high_priority()) {
-    // insert points for high priority
-    auto hp_pos = i;
-    // read whole mailbox at once
-    auto tmp = mailbox().try_pop();
-    while (tmp != nullptr) {
-      cache.insert(tmp->is_high_priority() ? hp_pos : e, tmp);
-      // adjust high priority insert point on first low prio element insert
-      if (hp_pos == e && !tmp->is_high_priority())
-        --hp_pos;
-      tmp = mailbox().try_pop();
+  // the mailbox picks high-priority messages from their own lane
+  mailbox_element_ptr result;
+  for (;;) {
+    auto ptr = mailbox().try_pop();
+    if (ptr == nullptr || !conflation_ || !conflation_->owns(ptr)) {
+      result.reset(ptr);
+      break;
     }
+    // writers enqueue the slot again once we took its message out
+    result.reset(detail::conflation_table::take(ptr));
+    if (result)
+      break;
   }
-  mailbox_element_ptr result;
-  i = cache.begin();
-  if (i != e)
-    result.reset(cache.take(i));
+  if (result)
+    memory_release(*result);
+#ifdef CAF_ENABLE_MAILBOX_METRICS
+  if (result)
+    metrics_->dequeued(result->enqueued_at);
+#endif
   return result;
 }
 
 bool local_actor::has_next_message() {
-  if (!getf(is_priority_aware_flag))
-    return mailbox_.can_fetch_more();
-  auto& mbox = mailbox();
-  auto& cache = mbox.cache();
-  return cache.begin() != cache.separator() || mbox.can_fetch_more();
+  return mailbox_.can_fetch_more();
 }
 
 void local_actor::push_to_cache(mailbox_element_ptr ptr) {
   CAF_ASSERT(ptr != nullptr);
   CAF_LOG_TRACE(CAF_ARG(*ptr));
   if (!getf(is_priority_aware_flag) || !ptr->is_high_priority()) {
+    cache_index_.add(ptr.get());
     mailbox().cache().insert(mailbox().cache().end(), ptr.release());
     return;
   }
+  cache_index_.add(ptr.get(), true);
   auto high_prio = [](const mailbox_element& val) {
     return val.is_high_priority();
   };
@@ -150,6 +408,12 @@ void local_actor::push_to_cache(mailbox_element_ptr ptr) {
                ptr.release());
 }
 
+void local_actor::erase_from_cache(mailbox_element* x) {
+  CAF_ASSERT(x != nullptr);
+  cache_index_.erase(x);
+  mailbox().cache().erase(x);
+}
+
 void local_actor::send_exit(const actor_addr& whom, error reason) {
   send_exit(actor_cast<strong_actor_ptr>(whom), std::move(reason));
 }
@@ -180,9 +444,26 @@ void local_actor::initialize() {
 bool local_actor::cleanup(error&& fail_state, execution_unit* host) {
   CAF_LOG_TRACE(CAF_ARG(fail_state));
   if (!mailbox_.closed()) {
-    detail::sync_request_bouncer f{fail_state};
+    cache_index_.clear();
+    detail::sync_request_bouncer bounce{fail_state};
+    auto f = [&](mailbox_element& x) {
+      if (conflation_ && conflation_->owns(&x)) {
+        // slots only store asynchronous messages, i.e., nothing to bounce
+        mailbox_element_ptr ptr{detail::conflation_table::take(&x)};
+        if (ptr)
+          memory_release(*ptr);
+        return;
+      }
+      memory_release(x);
+      bounce(x);
+    };
     mailbox_.close(f);
   }
+  if (memory_)
+    home_system().memory_accounting().erase(id());
+#ifdef CAF_ENABLE_MAILBOX_METRICS
+  home_system().mailbox_metrics().erase(id());
+#endif
   // tell registry we're done
   unregister_from_system();
   monitorable_actor::cleanup(std::move(fail_state), host);
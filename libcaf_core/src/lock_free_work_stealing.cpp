@@ -0,0 +1,45 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/policy/lock_free_work_stealing.hpp"
+
+namespace caf {
+namespace policy {
+
+namespace {
+
+// the queue owned by the worker running on this thread (if any)
+thread_local const lock_free_work_stealing::queue_type* s_owned_queue;
+
+} // namespace <anonymous>
+
+lock_free_work_stealing::~lock_free_work_stealing() {
+  // nop
+}
+
+void lock_free_work_stealing::queue_type::claim() {
+  s_owned_queue = this;
+}
+
+bool lock_free_work_stealing::queue_type::owned_by_this_thread() const {
+  return s_owned_queue == this;
+}
+
+} // namespace policy
+} // namespace caf
@@ -43,6 +43,8 @@
 #include "caf/actor_system_config.hpp"
 
 #include "caf/detail/get_process_id.hpp"
+#include "caf/detail/set_thread_name.hpp"
+#include "caf/detail/set_thread_affinity.hpp"
 #include "caf/detail/single_reader_queue.hpp"
 
 namespace caf {
@@ -455,7 +457,11 @@ void logger::start() {
   parent_thread_ = std::this_thread::get_id();
   if (system_.config().logger_verbosity == quiet_log_lvl_atom::value)
     return;
-  thread_ = std::thread{[this] { this->run(); }};
+  thread_ = std::thread{[this] {
+    detail::set_thread_name("caf.logger");
+    detail::set_thread_affinity(system_.config().scheduler_utility_cpus);
+    this->run();
+  }};
 #endif
 }
 
@@ -19,10 +19,19 @@
 
 #include "caf/mailbox_element.hpp"
 
+#include <new>
+#include <atomic>
+
 namespace caf {
 
 namespace {
 
+/// Returns the heap memory occupied by the content of `x`.
+size_t content_footprint(const message& x) {
+  auto& vals = x.cvals();
+  return vals && !vals.is_inline() ? vals->memory_footprint() : 0;
+}
+
 /// Wraps a `message` into a mailbox element.
 class mailbox_element_wrapper : public mailbox_element {
 public:
@@ -44,17 +53,77 @@ public:
     return std::move(msg_);
   }
 
+  size_t memory_footprint() const noexcept override {
+    return footprint(sizeof(mailbox_element_wrapper)) + content_footprint(msg_);
+  }
+
 private:
   /// Stores the content of this mailbox element.
   message msg_;
 };
 
+/// Header of a memory block that stores mailbox elements for multicasts.
+struct element_block {
+  std::atomic<size_t> rc;
+
+  /// Returns the size of the header, padded to allow elements of type `T`
+  /// right after it.
+  template <class T>
+  static constexpr size_t padded_size() {
+    return (sizeof(element_block) + alignof(T) - 1) / alignof(T) * alignof(T);
+  }
+};
+
+/// Shares a `message` with other elements in the same memory block.
+class block_element : public mailbox_element {
+public:
+  block_element(element_block* block, const strong_actor_ptr& x0,
+                message_id x1, const message& x2)
+      : mailbox_element(strong_actor_ptr{x0}, x1, forwarding_stack{}),
+        block_(block),
+        msg_(x2) {
+    // nop
+  }
+
+  type_erased_tuple& content() override {
+    auto ptr = msg_.vals().raw_ptr();
+    if (ptr != nullptr)
+      return *ptr;
+    return dummy_;
+  }
+
+  message move_content_to_message() override {
+    return std::move(msg_);
+  }
+
+  // all elements of a block share the content, but each receiver keeps
+  // the content alive and hence pays for it
+  size_t memory_footprint() const noexcept override {
+    return footprint(sizeof(block_element)) + content_footprint(msg_);
+  }
+
+  void request_deletion(bool) noexcept override {
+    auto block = block_;
+    this->~block_element();
+    // the last element releases the whole block
+    if (block->rc.fetch_sub(1) == 1) {
+      block->~element_block();
+      ::operator delete(block);
+    }
+  }
+
+private:
+  element_block* block_;
+  message msg_;
+};
+
 } // namespace <anonymous>
 
 mailbox_element::mailbox_element()
     : next(nullptr),
       prev(nullptr),
-      marked(false) {
+      marked(false),
+      charged(0) {
   // nop
 }
 
@@ -63,6 +132,7 @@ mailbox_element::mailbox_element(strong_actor_ptr&& x, message_id y,
     : next(nullptr),
       prev(nullptr),
       marked(false),
+      charged(0),
       sender(std::move(x)),
       mid(y),
       stages(std::move(z)) {
@@ -85,6 +155,10 @@ const type_erased_tuple& mailbox_element::content() const {
   return const_cast<mailbox_element*>(this)->content();
 }
 
+size_t mailbox_element::memory_footprint() const noexcept {
+  return footprint(sizeof(mailbox_element));
+}
+
 mailbox_element_ptr make_mailbox_element(strong_actor_ptr sender, message_id id,
                                          mailbox_element::forwarding_stack stages,
                                          message msg) {
@@ -93,4 +167,23 @@ mailbox_element_ptr make_mailbox_element(strong_actor_ptr sender, message_id id,
   return mailbox_element_ptr{ptr};
 }
 
+std::vector<mailbox_element_ptr>
+make_mailbox_elements(strong_actor_ptr sender, message_id id, message msg,
+                      size_t n) {
+  std::vector<mailbox_element_ptr> result;
+  if (n == 0)
+    return result;
+  result.reserve(n);
+  auto offset = element_block::padded_size<block_element>();
+  auto mem = static_cast<char*>(::operator new(offset
+                                               + n * sizeof(block_element)));
+  auto block = new (mem) element_block;
+  block->rc = n;
+  auto elements = reinterpret_cast<block_element*>(mem + offset);
+  for (size_t i = 0; i < n; ++i)
+    result.emplace_back(new (elements + i) block_element(block, sender, id,
+                                                         msg));
+  return result;
+}
+
 } // namespace caf
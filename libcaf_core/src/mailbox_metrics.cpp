@@ -0,0 +1,113 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/mailbox_metrics.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace caf {
+
+constexpr size_t mailbox_stats::num_buckets;
+
+uint64_t mailbox_stats::upper_bound(size_t i) {
+  if (i + 1 >= num_buckets)
+    return std::numeric_limits<uint64_t>::max();
+  return uint64_t{1} << i;
+}
+
+uint64_t mailbox_stats::percentile(double p) const {
+  if (dequeued == 0)
+    return 0;
+  auto threshold = static_cast<uint64_t>(std::ceil(p * dequeued));
+  uint64_t sum = 0;
+  for (size_t i = 0; i < num_buckets; ++i) {
+    sum += latency[i];
+    if (sum >= threshold && sum > 0)
+      return upper_bound(i);
+  }
+  return upper_bound(num_buckets - 1);
+}
+
+std::string to_string(const mailbox_stats& x) {
+  auto bound = [&](double p) {
+    auto res = x.percentile(p);
+    return res == std::numeric_limits<uint64_t>::max()
+           ? std::string{"inf"}
+           : std::to_string(res) + "us";
+  };
+  std::string result = "mailbox_stats(id = ";
+  result += std::to_string(x.id);
+  result += ", depth = ";
+  result += std::to_string(x.depth);
+  result += ", high_water_mark = ";
+  result += std::to_string(x.high_water_mark);
+  result += ", dequeued = ";
+  result += std::to_string(x.dequeued);
+  if (x.dequeued == 0) {
+    result += ")";
+    return result;
+  }
+  result += ", p50 < ";
+  result += bound(0.5);
+  result += ", p99 < ";
+  result += bound(0.99);
+  result += ", max < ";
+  result += bound(1.);
+  result += ")";
+  return result;
+}
+
+mailbox_metrics::mailbox_metrics(actor_id aid)
+    : id_(aid),
+      depth_(0),
+      high_water_mark_(0) {
+  for (auto& x : latency_)
+    x = 0;
+}
+
+mailbox_metrics::~mailbox_metrics() {
+  // nop
+}
+
+size_t mailbox_metrics::bucket(clock_type::duration x) {
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(x).count();
+  if (us <= 0)
+    return 0;
+  // bucket `i` covers [2^(i-1), 2^i), i.e., i = floor(log2(us)) + 1
+  size_t i = 1;
+  while ((us >>= 1) != 0 && i < mailbox_stats::num_buckets - 1)
+    ++i;
+  return i;
+}
+
+mailbox_stats mailbox_metrics::snapshot() const {
+  mailbox_stats result;
+  result.id = id_;
+  result.depth = depth_.load(std::memory_order_relaxed);
+  result.high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+  result.dequeued = 0;
+  for (size_t i = 0; i < mailbox_stats::num_buckets; ++i) {
+    result.latency[i] = latency_[i].load(std::memory_order_relaxed);
+    result.dequeued += result.latency[i];
+  }
+  return result;
+}
+
+} // namespace caf
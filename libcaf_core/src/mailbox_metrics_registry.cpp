@@ -0,0 +1,129 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/mailbox_metrics_registry.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include "caf/logger.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+
+#include "caf/detail/set_thread_name.hpp"
+#include "caf/detail/set_thread_affinity.hpp"
+
+namespace caf {
+namespace detail {
+
+mailbox_metrics_registry::mailbox_metrics_registry(actor_system& sys)
+    : system_(sys),
+      stopped_(false) {
+  // nop
+}
+
+mailbox_metrics_registry::~mailbox_metrics_registry() {
+  stop();
+}
+
+void mailbox_metrics_registry::add(intrusive_ptr<mailbox_metrics> x) {
+  CAF_ASSERT(x != nullptr);
+  std::unique_lock<std::mutex> guard{mtx_};
+  auto aid = x->id();
+  entries_.emplace(aid, std::move(x));
+}
+
+void mailbox_metrics_registry::erase(actor_id aid) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  entries_.erase(aid);
+}
+
+std::vector<mailbox_stats> mailbox_metrics_registry::snapshot() {
+  std::vector<mailbox_stats> result;
+  std::unique_lock<std::mutex> guard{mtx_};
+  result.reserve(entries_.size());
+  for (auto& kvp : entries_)
+    result.emplace_back(kvp.second->snapshot());
+  return result;
+}
+
+optional<mailbox_stats> mailbox_metrics_registry::snapshot(actor_id aid) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  auto i = entries_.find(aid);
+  if (i == entries_.end())
+    return none;
+  return i->second->snapshot();
+}
+
+void mailbox_metrics_registry::start() {
+  if (system_.config().mailbox_metrics_ms_interval == 0)
+    return;
+  thread_ = std::thread{[this] {
+    set_thread_name("caf.metrics");
+    set_thread_affinity(system_.config().scheduler_utility_cpus);
+    run();
+  }};
+}
+
+void mailbox_metrics_registry::stop() {
+  if (!thread_.joinable())
+    return;
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{mtx_};
+    stopped_ = true;
+    cv_.notify_one();
+  }
+  thread_.join();
+}
+
+void mailbox_metrics_registry::run() {
+  CAF_SET_LOGGER_SYS(&system_);
+  CAF_LOG_TRACE("");
+  auto& cfg = system_.config();
+  std::ofstream file;
+  if (!cfg.mailbox_metrics_output_file.empty()) {
+    file.open(cfg.mailbox_metrics_output_file);
+    if (!file)
+      std::cerr << "[WARNING] could not open file \""
+                << cfg.mailbox_metrics_output_file
+                << "\" (writing mailbox metrics to std::cerr instead)"
+                << std::endl;
+  }
+  std::ostream& out = file ? static_cast<std::ostream&>(file) : std::cerr;
+  std::chrono::milliseconds interval{cfg.mailbox_metrics_ms_interval};
+  auto next = std::chrono::steady_clock::now() + interval;
+  std::unique_lock<std::mutex> guard{mtx_};
+  while (!cv_.wait_until(guard, next, [&] { return stopped_; })) {
+    next += interval;
+    guard.unlock();
+    // UNIX timestamp in microseconds followed by the snapshot of each actor
+    using std::chrono::system_clock;
+    using std::chrono::microseconds;
+    auto t = std::chrono::duration_cast<microseconds>(
+               system_clock::now().time_since_epoch()).count();
+    for (auto& x : snapshot())
+      out << t << ' ' << to_string(x) << '\n';
+    out.flush();
+    guard.lock();
+  }
+}
+
+} // namespace detail
+} // namespace caf
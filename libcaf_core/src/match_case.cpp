@@ -29,4 +29,8 @@ match_case::match_case(uint32_t tt) : token_(tt) {
   // nop
 }
 
+const detail::batch_factory* match_case::batch() const {
+  return nullptr;
+}
+
 } // namespace caf
@@ -19,99 +19,302 @@
 
 #include "caf/detail/memory.hpp"
 
-#include <vector>
-#include <typeinfo>
+#include <mutex>
+#include <atomic>
+#include <memory>
 
-#include "caf/mailbox_element.hpp"
+#if defined(CAF_CLANG) || defined(CAF_MACOS)
+#include <pthread.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+constexpr size_t memory::max_slab_size;
+constexpr size_t memory::magazine_size;
+constexpr size_t memory::slab_size;
 
 #ifdef CAF_NO_MEM_MANAGEMENT
 
-int caf_memory_keep_compiler_happy() {
-  // this function shuts up a linker warning saying that the
-  // object file has no symbols
-  return 0;
+void* memory::allocate(size_t size) {
+  return ::operator new(size);
 }
 
-#else // CAF_NO_MEM_MANAGEMENT
+void memory::deallocate(void* ptr, size_t) noexcept {
+  ::operator delete(ptr);
+}
 
-namespace caf {
-namespace detail {
+std::vector<slab_stats> memory::stats() {
+  return {};
+}
+
+#else // CAF_NO_MEM_MANAGEMENT
 
 namespace {
 
-using cache_map = std::map<const std::type_info*, std::unique_ptr<memory_cache>>;
+// 16-byte steps up to 128, 32-byte steps up to 256, 64-byte steps up to 512
+constexpr size_t num_size_classes = 16;
 
-} // namespace <anonymous>
+size_t size_class(size_t size) {
+  if (size <= 128)
+    return size == 0 ? 0 : (size - 1) / 16;
+  if (size <= 256)
+    return 8 + (size - 129) / 32;
+  return 12 + (size - 257) / 64;
+}
+
+size_t class_size(size_t id) {
+  if (id < 8)
+    return (id + 1) * 16;
+  if (id < 12)
+    return 128 + (id - 7) * 32;
+  return 256 + (id - 11) * 64;
+}
+
+struct free_node {
+  free_node* next;
+};
+
+// a singly linked list of free objects
+struct free_list {
+  free_node* head = nullptr;
+  size_t count = 0;
+
+  void push(free_node* x) {
+    x->next = head;
+    head = x;
+    ++count;
+  }
+
+  free_node* pop() {
+    auto x = head;
+    head = x->next;
+    --count;
+    return x;
+  }
+
+  // removes and returns the first `n` elements
+  free_list split(size_t n) {
+    CAF_ASSERT(n > 0 && n <= count);
+    free_list result;
+    result.head = head;
+    result.count = n;
+    auto last = head;
+    for (size_t i = 1; i < n; ++i)
+      last = last->next;
+    head = last->next;
+    count -= n;
+    last->next = nullptr;
+    return result;
+  }
+};
+
+// global state for one size class, shared by all threads
+struct depot {
+  std::mutex mtx;
+  std::vector<free_list> magazines;
+  std::atomic<uint64_t> allocations;
+  std::atomic<uint64_t> deallocations;
+  std::atomic<uint64_t> reserved;
+  std::atomic<uint64_t> transfers;
+
+  depot() : allocations(0), deallocations(0), reserved(0), transfers(0) {
+    // nop
+  }
+
+  void put(free_list xs) {
+    std::unique_lock<std::mutex> guard{mtx};
+    magazines.push_back(xs);
+    ++transfers;
+  }
+
+  bool get(free_list& xs) {
+    std::unique_lock<std::mutex> guard{mtx};
+    if (magazines.empty())
+      return false;
+    xs = magazines.back();
+    magazines.pop_back();
+    ++transfers;
+    return true;
+  }
+
+  // allocates a new slab and carves it into free objects
+  free_list grow(size_t id) {
+    auto size = class_size(id);
+    auto n = memory::slab_size / size;
+    auto slab = reinterpret_cast<char*>(::operator new(n * size));
+    reserved += n * size;
+    free_list result;
+    for (size_t i = n; i > 0; --i)
+      result.push(reinterpret_cast<free_node*>(slab + (i - 1) * size));
+    return result;
+  }
+};
+
+// never destroyed, since objects may get released during static destruction
+depot* depots() {
+  static depot* instance = new depot[num_size_classes];
+  return instance;
+}
+
+// per-thread cache for all size classes
+class thread_cache {
+public:
+  thread_cache() : pending_allocs_{}, pending_deallocs_{} {
+    // nop
+  }
+
+  ~thread_cache() {
+    auto ds = depots();
+    for (size_t id = 0; id < num_size_classes; ++id) {
+      if (lists_[id].count > 0)
+        ds[id].put(lists_[id]);
+      flush(id);
+    }
+  }
+
+  void* allocate(size_t id) {
+    auto& xs = lists_[id];
+    if (xs.count == 0 && !depots()[id].get(xs))
+      xs = depots()[id].grow(id);
+    if (++pending_allocs_[id] == memory::magazine_size)
+      flush(id);
+    return xs.pop();
+  }
+
+  void deallocate(void* ptr, size_t id) {
+    auto& xs = lists_[id];
+    xs.push(reinterpret_cast<free_node*>(ptr));
+    // keep one magazine for upcoming allocations and pass the other one on
+    if (xs.count >= 2 * memory::magazine_size)
+      depots()[id].put(xs.split(memory::magazine_size));
+    if (++pending_deallocs_[id] == memory::magazine_size)
+      flush(id);
+  }
+
+  void flush(size_t id) {
+    auto& d = depots()[id];
+    d.allocations += pending_allocs_[id];
+    d.deallocations += pending_deallocs_[id];
+    pending_allocs_[id] = 0;
+    pending_deallocs_[id] = 0;
+  }
+
+  void flush() {
+    for (size_t id = 0; id < num_size_classes; ++id)
+      flush(id);
+  }
+
+private:
+  free_list lists_[num_size_classes];
+  uint64_t pending_allocs_[num_size_classes];
+  uint64_t pending_deallocs_[num_size_classes];
+};
 
 #if defined(CAF_CLANG) || defined(CAF_MACOS)
-namespace {
 
 pthread_key_t s_key;
 pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
 
-} // namespace <anonymous>
-
-void cache_map_destructor(void* ptr) {
-  delete reinterpret_cast<cache_map*>(ptr);
+void thread_cache_destructor(void* ptr) {
+  delete reinterpret_cast<thread_cache*>(ptr);
 }
 
-void make_cache_map() {
-  pthread_key_create(&s_key, cache_map_destructor);
+void make_thread_cache_key() {
+  pthread_key_create(&s_key, thread_cache_destructor);
 }
 
-cache_map& get_cache_map() {
-  pthread_once(&s_key_once, make_cache_map);
-  auto cache = reinterpret_cast<cache_map*>(pthread_getspecific(s_key));
+thread_cache* get_thread_cache() {
+  pthread_once(&s_key_once, make_thread_cache_key);
+  auto cache = reinterpret_cast<thread_cache*>(pthread_getspecific(s_key));
   if (cache == nullptr) {
-    cache = new cache_map;
+    cache = new thread_cache;
     pthread_setspecific(s_key, cache);
-    // insert default types
-    //std::unique_ptr<memory_cache> tmp(new basic_memory_cache<mailbox_element>);
-    //cache->emplace(&typeid(mailbox_element), std::move(tmp));
   }
-  return *cache;
+  return cache;
 }
 
 #else // !CAF_CLANG && !CAF_MACOS
 
-namespace {
-
-thread_local std::unique_ptr<cache_map> s_key;
+// set after destroying the cache of this thread
+thread_local bool s_cache_destroyed = false;
 
-} // namespace <anonymous>
+struct thread_cache_holder {
+  std::unique_ptr<thread_cache> ptr;
 
-cache_map& get_cache_map() {
-  if (!s_key) {
-    s_key = std::unique_ptr<cache_map>(new cache_map);
-    // insert default types
-    std::unique_ptr<memory_cache> tmp(new basic_memory_cache<mailbox_element>);
-    s_key->emplace(&typeid(mailbox_element), std::move(tmp));
+  ~thread_cache_holder() {
+    ptr.reset();
+    s_cache_destroyed = true;
   }
-  return *s_key;
+};
+
+thread_local thread_cache_holder s_cache;
+
+thread_cache* get_thread_cache() {
+  if (s_cache_destroyed)
+    return nullptr;
+  if (!s_cache.ptr)
+    s_cache.ptr.reset(new thread_cache);
+  return s_cache.ptr.get();
 }
 
 #endif
 
-memory_cache::~memory_cache() {
-  // nop
+} // namespace <anonymous>
+
+void* memory::allocate(size_t size) {
+  if (size > max_slab_size)
+    return ::operator new(size);
+  auto id = size_class(size);
+  auto cache = get_thread_cache();
+  if (cache != nullptr)
+    return cache->allocate(id);
+  // the thread is shutting down, bypass the cache
+  auto& d = depots()[id];
+  ++d.allocations;
+  free_list xs;
+  if (!d.get(xs))
+    xs = d.grow(id);
+  auto result = xs.pop();
+  if (xs.count > 0)
+    d.put(xs);
+  return result;
 }
 
-memory_cache* memory::get_cache_map_entry(const std::type_info* tinf) {
-  auto& cache = get_cache_map();
-  auto i = cache.find(tinf);
-  if (i != cache.end()) {
-    return i->second.get();
+void memory::deallocate(void* ptr, size_t size) noexcept {
+  if (size > max_slab_size) {
+    ::operator delete(ptr);
+    return;
+  }
+  auto id = size_class(size);
+  auto cache = get_thread_cache();
+  if (cache != nullptr) {
+    cache->deallocate(ptr, id);
+    return;
   }
-  return nullptr;
+  // the thread is shutting down, bypass the cache
+  auto& d = depots()[id];
+  ++d.deallocations;
+  free_list xs;
+  xs.push(reinterpret_cast<free_node*>(ptr));
+  d.put(xs);
 }
 
-void memory::add_cache_map_entry(const std::type_info* tinf,
-                                 memory_cache* instance) {
-  auto& cache = get_cache_map();
-  cache[tinf].reset(instance);
+std::vector<slab_stats> memory::stats() {
+  auto cache = get_thread_cache();
+  if (cache != nullptr)
+    cache->flush();
+  std::vector<slab_stats> result;
+  auto ds = depots();
+  for (size_t id = 0; id < num_size_classes; ++id)
+    result.push_back(slab_stats{class_size(id), ds[id].allocations.load(),
+                                ds[id].deallocations.load(),
+                                ds[id].reserved.load(),
+                                ds[id].transfers.load()});
+  return result;
 }
 
+#endif // CAF_NO_MEM_MANAGEMENT
+
 } // namespace detail
 } // namespace caf
-
-#endif // CAF_NO_MEM_MANAGEMENT
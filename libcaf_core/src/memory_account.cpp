@@ -0,0 +1,60 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/memory_account.hpp"
+
+namespace caf {
+
+std::string to_string(const memory_stats& x) {
+  std::string result = "memory_stats(id = ";
+  result += std::to_string(x.id);
+  result += ", mailbox = ";
+  result += std::to_string(x.mailbox);
+  result += ", state = ";
+  result += std::to_string(x.state);
+  result += ")";
+  return result;
+}
+
+memory_account::memory_account(actor_id aid, std::atomic<size_t>& total)
+    : id_(aid),
+      mailbox_(0),
+      state_(0),
+      total_(total) {
+  // nop
+}
+
+memory_account::~memory_account() {
+  // nop
+}
+
+void memory_account::state(size_t n) noexcept {
+  auto old = state_.exchange(n, std::memory_order_relaxed);
+  if (n > old)
+    total_.fetch_add(n - old, std::memory_order_relaxed);
+  else
+    total_.fetch_sub(old - n, std::memory_order_relaxed);
+}
+
+memory_stats memory_account::snapshot() const {
+  return {id_, mailbox_.load(std::memory_order_relaxed),
+          state_.load(std::memory_order_relaxed)};
+}
+
+} // namespace caf
@@ -0,0 +1,127 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/memory_accounting.hpp"
+
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <algorithm>
+
+#include "caf/atom.hpp"
+#include "caf/logger.hpp"
+#include "caf/deep_to_string.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+overflow_policy parse_budget_policy(atom_value x) {
+  if (x == atom("drop-new"))
+    return overflow_policy::drop_newest;
+  if (x == atom("drop-old"))
+    return overflow_policy::drop_oldest;
+  if (x == atom("block"))
+    return overflow_policy::block;
+  if (x != atom("reject"))
+    std::cerr << "[WARNING] " << deep_to_string(x)
+              << " is an unrecognized budget policy, falling back to 'reject'"
+              << std::endl;
+  return overflow_policy::reject;
+}
+
+} // namespace <anonymous>
+
+memory_accounting::memory_accounting(actor_system& sys)
+    : enabled_(sys.config().mailbox_memory_accounting
+               || sys.config().mailbox_memory_budget > 0),
+      budget_(sys.config().mailbox_memory_budget),
+      budget_policy_(parse_budget_policy(sys.config().mailbox_budget_policy)),
+      total_(0) {
+  // nop
+}
+
+memory_accounting::~memory_accounting() {
+  // nop
+}
+
+void memory_accounting::await_budget() const {
+  std::chrono::microseconds delay{1};
+  std::chrono::microseconds max_delay{1000};
+  while (over_budget()) {
+    std::this_thread::sleep_for(delay);
+    if (delay < max_delay)
+      delay *= 2;
+  }
+}
+
+intrusive_ptr<memory_account> memory_accounting::make_account(actor_id aid) {
+  if (!enabled_)
+    return nullptr;
+  auto result = make_counted<memory_account>(aid, total_);
+  std::unique_lock<std::mutex> guard{mtx_};
+  entries_.emplace(aid, result);
+  return result;
+}
+
+void memory_accounting::erase(actor_id aid) {
+  if (!enabled_)
+    return;
+  std::unique_lock<std::mutex> guard{mtx_};
+  auto i = entries_.find(aid);
+  if (i == entries_.end())
+    return;
+  i->second->state(0);
+  entries_.erase(i);
+}
+
+std::vector<memory_stats> memory_accounting::top(size_t n) {
+  std::vector<memory_stats> result;
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{mtx_};
+    result.reserve(entries_.size());
+    for (auto& kvp : entries_)
+      result.emplace_back(kvp.second->snapshot());
+  }
+  auto greater = [](const memory_stats& x, const memory_stats& y) {
+    return x.total() > y.total();
+  };
+  if (n < result.size()) {
+    auto nth = result.begin() + static_cast<ptrdiff_t>(n);
+    std::partial_sort(result.begin(), nth, result.end(), greater);
+    result.erase(nth, result.end());
+  } else {
+    std::sort(result.begin(), result.end(), greater);
+  }
+  return result;
+}
+
+optional<memory_stats> memory_accounting::snapshot(actor_id aid) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  auto i = entries_.find(aid);
+  if (i == entries_.end())
+    return none;
+  return i->second->snapshot();
+}
+
+} // namespace detail
+} // namespace caf
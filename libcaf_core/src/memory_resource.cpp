@@ -0,0 +1,59 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/memory_resource.hpp"
+
+#include <new>
+
+namespace caf {
+
+namespace {
+
+class new_delete_resource_impl : public memory_resource {
+protected:
+  void* do_allocate(size_t bytes, size_t align) override {
+    // operator new only guarantees the default alignment before C++17
+    CAF_ASSERT(align <= max_align);
+    CAF_IGNORE_UNUSED(align);
+    return ::operator new(bytes);
+  }
+
+  void do_deallocate(void* ptr, size_t, size_t) override {
+    ::operator delete(ptr);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+} // namespace <anonymous>
+
+constexpr size_t memory_resource::max_align;
+
+memory_resource::~memory_resource() {
+  // nop
+}
+
+memory_resource* new_delete_resource() noexcept {
+  static new_delete_resource_impl instance;
+  return &instance;
+}
+
+} // namespace caf
@@ -58,6 +58,11 @@ merged_tuple::cow_ptr merged_tuple::copy() const {
   return cow_ptr{make_counted<merged_tuple>(data_, mapping_)};
 }
 
+size_t merged_tuple::memory_footprint() const noexcept {
+  return sizeof(merged_tuple) + data_.capacity() * sizeof(cow_ptr)
+         + mapping_.capacity() * sizeof(mapping_type::value_type);
+}
+
 void* merged_tuple::get_mutable(size_t pos) {
   CAF_ASSERT(pos < mapping_.size());
   auto& p = mapping_[pos];
@@ -32,14 +32,30 @@ bool message_data::shared() const noexcept {
   return !unique();
 }
 
+message_data* message_data::copy_to(void*) const noexcept {
+  return nullptr;
+}
+
+constexpr size_t message_data::cow_ptr::inline_size;
+
+message_data* message_data::cow_ptr::release() noexcept {
+  if (!is_inline()) {
+    auto result = ptr_;
+    ptr_ = nullptr;
+    return result;
+  }
+  auto cptr = ptr_->copy();
+  destroy();
+  return cptr.release();
+}
+
 message_data* message_data::cow_ptr::get_unshared() {
-  auto p = ptr_.get();
-  if (!p->unique()) {
-    auto cptr = p->copy();
-    ptr_.swap(cptr.ptr_);
-    return ptr_.get();
+  // inline data is never shared
+  if (!is_inline() && !ptr_->unique()) {
+    auto cptr = ptr_->copy();
+    swap(cptr);
   }
-  return p;
+  return ptr_;
 }
 
 } // namespace detail
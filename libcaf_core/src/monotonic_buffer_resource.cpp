@@ -0,0 +1,131 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/monotonic_buffer_resource.hpp"
+
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+namespace caf {
+
+namespace {
+
+// rounds `x` up to the next multiple of `align`, which is a power of two
+inline uintptr_t align_up(uintptr_t x, size_t align) {
+  return (x + align - 1) & ~static_cast<uintptr_t>(align - 1);
+}
+
+} // namespace <anonymous>
+
+constexpr size_t monotonic_buffer_resource::default_initial_size;
+
+monotonic_buffer_resource::monotonic_buffer_resource(size_t initial_size,
+                                                     memory_resource* upstream)
+    : upstream_(upstream),
+      initial_size_(std::max(initial_size, sizeof(block))),
+      next_size_(initial_size_),
+      reserved_(0),
+      blocks_(nullptr),
+      pos_(nullptr),
+      end_(nullptr) {
+  CAF_ASSERT(upstream != nullptr);
+}
+
+monotonic_buffer_resource::~monotonic_buffer_resource() {
+  release();
+}
+
+void monotonic_buffer_resource::reset() {
+  if (blocks_ == nullptr)
+    return;
+  block* largest = blocks_;
+  for (auto x = blocks_->next; x != nullptr; x = x->next)
+    if (x->size > largest->size)
+      largest = x;
+  auto x = blocks_;
+  while (x != nullptr) {
+    auto next = x->next;
+    if (x != largest)
+      upstream_->deallocate(x, x->size);
+    x = next;
+  }
+  largest->next = nullptr;
+  blocks_ = largest;
+  reserved_ = largest->size;
+  use(largest);
+}
+
+void monotonic_buffer_resource::release() {
+  auto x = blocks_;
+  while (x != nullptr) {
+    auto next = x->next;
+    upstream_->deallocate(x, x->size);
+    x = next;
+  }
+  blocks_ = nullptr;
+  pos_ = nullptr;
+  end_ = nullptr;
+  reserved_ = 0;
+  next_size_ = initial_size_;
+}
+
+void* monotonic_buffer_resource::do_allocate(size_t bytes, size_t align) {
+  CAF_ASSERT(align > 0 && (align & (align - 1)) == 0);
+  auto pos = align_up(reinterpret_cast<uintptr_t>(pos_), align);
+  if (pos_ == nullptr || pos + bytes > reinterpret_cast<uintptr_t>(end_)) {
+    grow(bytes, align);
+    pos = align_up(reinterpret_cast<uintptr_t>(pos_), align);
+  }
+  pos_ = reinterpret_cast<char*>(pos + bytes);
+  return reinterpret_cast<void*>(pos);
+}
+
+void monotonic_buffer_resource::do_deallocate(void*, size_t, size_t) {
+  // nop
+}
+
+bool monotonic_buffer_resource::do_is_equal(const memory_resource& other) const
+noexcept {
+  return this == &other;
+}
+
+void monotonic_buffer_resource::grow(size_t bytes, size_t align) {
+  if (bytes > std::numeric_limits<size_t>::max() / 2 - sizeof(block) - align)
+    CAF_RAISE_ERROR("monotonic_buffer_resource: requested size too large");
+  // worst case: the block starts right after the header and we need to skip
+  // `align - 1` bytes
+  auto required = sizeof(block) + align - 1 + bytes;
+  auto size = std::max(next_size_, required);
+  auto x = static_cast<block*>(upstream_->allocate(size));
+  x->next = blocks_;
+  x->size = size;
+  blocks_ = x;
+  reserved_ += size;
+  // grow geometrically to keep the number of blocks logarithmic
+  next_size_ = size * 2;
+  use(x);
+}
+
+void monotonic_buffer_resource::use(block* x) {
+  pos_ = reinterpret_cast<char*>(x + 1);
+  end_ = reinterpret_cast<char*>(x) + x->size;
+}
+
+} // namespace caf
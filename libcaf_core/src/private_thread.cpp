@@ -21,6 +21,8 @@
 
 #include "caf/scheduled_actor.hpp"
 
+#include "caf/detail/set_thread_name.hpp"
+
 namespace caf {
 namespace detail {
 
@@ -85,6 +87,7 @@ void private_thread::shutdown() {
 }
 
 void private_thread::exec(private_thread* this_ptr) {
+  set_thread_name("caf.detached");
   this_ptr->run();
   // make sure to not destroy the private thread object before the
   // detached actor is destroyed and this object is unreachable
@@ -19,10 +19,14 @@
 
 #include "caf/scheduled_actor.hpp"
 
+#include "caf/skip.hpp"
 #include "caf/config.hpp"
 #include "caf/to_string.hpp"
 #include "caf/actor_ostream.hpp"
 
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+#include "caf/detail/blocking_pool.hpp"
 #include "caf/detail/private_thread.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 #include "caf/detail/default_invoke_result_visitor.hpp"
@@ -101,7 +105,8 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
       error_handler_(default_error_handler),
       down_handler_(default_down_handler),
       exit_handler_(default_exit_handler),
-      private_thread_(nullptr)
+      private_thread_(nullptr),
+      partition_(cfg.partition)
 # ifndef CAF_NO_EXCEPTIONS
       , exception_handler_(default_exception_handler)
 # endif // CAF_NO_EXCEPTIONS
@@ -119,30 +124,51 @@ scheduled_actor::~scheduled_actor() {
 // -- overridden functions of abstract_actor -----------------------------------
 
 void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
+  if (enqueue_impl(std::move(ptr), eu))
+    wake_up(eu);
+}
+
+void scheduled_actor::enqueue_deferred(mailbox_element_ptr ptr,
+                                       execution_unit* eu,
+                                       std::vector<resumable*>& wakeups) {
+  if (!enqueue_impl(std::move(ptr), eu))
+    return;
+  // only actors of the default scheduler can join a bulk wakeup
+  if (getf(is_detached_flag) || getf(is_pooled_flag) || partition_ != nullptr) {
+    wake_up(eu);
+    return;
+  }
+  intrusive_ptr_add_ref(ctrl());
+  wakeups.push_back(this);
+}
+
+void scheduled_actor::enqueue_batch(std::vector<mailbox_element_ptr> xs,
+                                    execution_unit* eu) {
+  CAF_ASSERT(!getf(is_blocking_flag));
+  CAF_LOG_TRACE(CAF_ARG(xs.size()));
+  // the batch wakes us up at most once
+  if (!xs.empty() && enqueue_batch_to_mailbox(xs, eu))
+    wake_up(eu);
+}
+
+bool scheduled_actor::enqueue_impl(mailbox_element_ptr ptr,
+                                   execution_unit* eu) {
   CAF_ASSERT(ptr != nullptr);
   CAF_ASSERT(!getf(is_blocking_flag));
   CAF_LOG_TRACE(CAF_ARG(*ptr));
   CAF_LOG_SEND_EVENT(ptr);
   auto mid = ptr->mid;
   auto sender = ptr->sender;
-  switch (mailbox().enqueue(ptr.release())) {
-    case detail::enqueue_result::unblocked_reader: {
+  auto x = ptr.release();
+  metrics_enqueue(*x);
+  auto res = enqueue_to_mailbox(x, eu);
+  switch (res) {
+    case detail::enqueue_result::unblocked_reader:
       CAF_LOG_ACCEPT_EVENT();
-      // add a reference count to this actor and re-schedule it
-      intrusive_ptr_add_ref(ctrl());
-      if (getf(is_detached_flag)) {
-        CAF_ASSERT(private_thread_ != nullptr);
-        private_thread_->resume();
-      } else {
-        if (eu != nullptr)
-          eu->exec_later(this);
-        else
-          home_system().scheduler().enqueue(this);
-      }
-      break;
-    }
+      return true;
     case detail::enqueue_result::queue_closed: {
       CAF_LOG_REJECT_EVENT();
+      metrics_drop();
       if (mid.is_request()) {
         detail::sync_request_bouncer f{exit_reason()};
         f(sender, mid);
@@ -153,6 +179,23 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
       // enqueued to a running actors' mailbox; nothing to do
       CAF_LOG_ACCEPT_EVENT();
       break;
+    case detail::enqueue_result::queue_full:
+      // dropped by the overflow policy of a bounded mailbox
+      CAF_LOG_REJECT_EVENT();
+      metrics_drop();
+      break;
+  }
+  return false;
+}
+
+void scheduled_actor::wake_up(execution_unit* eu) {
+  // add a reference count to this actor and re-schedule it
+  intrusive_ptr_add_ref(ctrl());
+  if (getf(is_detached_flag)) {
+    CAF_ASSERT(private_thread_ != nullptr);
+    private_thread_->resume();
+  } else {
+    schedule(eu);
   }
 }
 
@@ -180,7 +223,7 @@ void scheduled_actor::launch(execution_unit* eu, bool lazy, bool hide) {
   // scheduler has a reference count to the actor as long as
   // it is waiting to get scheduled
   intrusive_ptr_add_ref(ctrl());
-  eu->exec_later(this);
+  schedule(eu);
 }
 
 bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
@@ -190,6 +233,7 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
   }
   awaited_responses_.clear();
   multiplexed_responses_.clear();
+  detail::timer_thread::abandon(timeout_);
   return local_actor::cleanup(std::move(fail_state), host);
 }
 
@@ -227,6 +271,7 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
           return resumable::awaiting_message;
       }
     } while (!ptr);
+    handled_msgs += gather_batch(ptr, max_throughput - handled_msgs);
     switch (reactivate(*ptr)) {
       case activation_result::terminated:
         return resume_result::done;
@@ -237,6 +282,8 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
         while (consume_from_cache()) {
           ++handled_msgs;
           bhvr_stack_.cleanup();
+          if (getf(has_arena_flag))
+            arena_checkpoint();
           if (finalize()) {
             CAF_LOG_DEBUG("actor finalized while processing cache");
             return resume_result::done;
@@ -276,18 +323,21 @@ void scheduled_actor::quit(error x) {
 uint32_t scheduled_actor::request_timeout(const duration& d) {
   if (!d.valid()) {
     unsetf(has_timeout_flag);
+    if (timeout_)
+      detail::timer_thread::disarm(*timeout_);
     return 0;
   }
   setf(has_timeout_flag);
   auto result = ++timeout_id_;
-  auto msg = make_message(timeout_msg{++timeout_id_});
+  auto tid = ++timeout_id_;
   CAF_LOG_TRACE("send new timeout_msg, " << CAF_ARG(timeout_id_));
   if (d.is_zero())
     // immediately enqueue timeout message if duration == 0s
-    enqueue(ctrl(), invalid_message_id, std::move(msg), context());
+    enqueue(ctrl(), invalid_message_id, make_message(timeout_msg{tid}),
+            context());
   else
-    system().scheduler().delayed_send(d, ctrl(), strong_actor_ptr(ctrl()),
-                                      message_id::make(), std::move(msg));
+    // re-uses the timer entry of the previous timeout if possible
+    system().scheduler().set_timeout(timeout_, ctrl(), d, tid);
   return result;
 }
 
@@ -316,6 +366,20 @@ void scheduled_actor::add_multiplexed_response_handler(message_id response_id,
   multiplexed_responses_.emplace(response_id, std::move(bhvr));
 }
 
+bool scheduled_actor::is_system_message_token(uint32_t x) {
+  // must cover all types that `categorize` handles
+  switch (x) {
+    case make_type_token<atom_value, atom_value, std::string>():
+    case make_type_token<timeout_msg>():
+    case make_type_token<exit_msg>():
+    case make_type_token<down_msg>():
+    case make_type_token<error>():
+      return true;
+    default:
+      return false;
+  }
+}
+
 scheduled_actor::message_category
 scheduled_actor::categorize(mailbox_element& x) {
   auto& content = x.content();
@@ -469,6 +533,36 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
   CAF_CRITICAL("invalid message type");
 }
 
+size_t scheduled_actor::gather_batch(mailbox_element_ptr& x,
+                                     size_t max_size) {
+  // requests need individual responses and awaited responses block all
+  // other messages anyways
+  if (bhvr_stack_.empty() || !awaited_responses_.empty()
+      || !x->mid.is_async())
+    return 0;
+  auto f = bhvr_stack_.back().batch_for(x->content());
+  if (f == nullptr)
+    return 0;
+  std::vector<mailbox_element_ptr> elements;
+  elements.emplace_back(std::move(x));
+  while (elements.size() < max_size) {
+    auto next = mailbox().peek();
+    if (next == nullptr || (conflation_ && conflation_->owns(next))
+        || !next->mid.is_async() || !f->accepts(next->content()))
+      break;
+    elements.emplace_back(next_message());
+  }
+  std::vector<type_erased_tuple*> xs;
+  xs.reserve(elements.size());
+  for (auto& element : elements)
+    xs.push_back(&element->content());
+  // the batch appears to originate from the sender of its first element
+  auto& first = elements.front();
+  x = make_mailbox_element(std::move(first->sender), first->mid,
+                           std::move(first->stages), f->make(xs));
+  return elements.size() - 1;
+}
+
 /// Tries to consume `x`.
 void scheduled_actor::consume(mailbox_element_ptr x) {
   switch (consume(*x)) {
@@ -481,22 +575,44 @@ void scheduled_actor::consume(mailbox_element_ptr x) {
 
 bool scheduled_actor::consume_from_cache() {
   CAF_LOG_TRACE("");
-  auto& cache = mailbox().cache();
-  auto i = cache.continuation();
-  auto e = cache.end();
-  while (i != e)
-    switch (consume(*i)) {
+  auto& index = cache_index();
+  if (index.empty())
+    return false;
+  // all other messages remain skipped while awaiting a response
+  if (!awaited_responses_.empty()) {
+    auto x = index.response(awaited_responses_.front().first);
+    if (x == nullptr || consume(*x) != im_success)
+      return false;
+    erase_from_cache(x);
+    return true;
+  }
+  // unless the default handler skips messages, it receives all messages
+  // that don't match the current behavior
+  auto skips_unmatched = skip_t::is_skip(default_handler_);
+  auto candidate = [&](detail::cache_index::key_type key) {
+    if (!skips_unmatched || key == detail::cache_index::response_key)
+      return true;
+    auto tk = static_cast<uint32_t>(key);
+    return is_system_message_token(tk)
+           || (!bhvr_stack_.empty() && bhvr_stack_.back().may_match(tk));
+  };
+  detail::cache_index::position pos = 0;
+  for (;;) {
+    auto x = index.next(pos, candidate);
+    if (x.second == nullptr)
+      return false;
+    pos = x.first;
+    switch (consume(*x.second)) {
       case im_success:
-        cache.erase(i);
+        erase_from_cache(x.second);
         return true;
       case im_skipped:
-        ++i;
         break;
       case im_dropped:
-        i = cache.erase(i);
+        erase_from_cache(x.second);
         break;
     }
-  return false;
+  }
 }
 
 bool scheduled_actor::activate(execution_unit* ctx) {
@@ -557,6 +673,8 @@ auto scheduled_actor::reactivate(mailbox_element& x) -> activation_result {
         return activation_result::dropped;
       case im_success:
         bhvr_stack_.cleanup();
+        if (getf(has_arena_flag))
+          arena_checkpoint();
         if (finalize()) {
           CAF_LOG_DEBUG("actor finalized");
           return activation_result::terminated;
@@ -604,4 +722,15 @@ bool scheduled_actor::finalize() {
   return true;
 }
 
+void scheduled_actor::schedule(execution_unit* eu) {
+  if (getf(is_pooled_flag))
+    home_system().blocking_pool().enqueue(this);
+  else if (eu != nullptr && eu->partition() == partition_)
+    eu->exec_later(this);
+  else if (partition_ != nullptr)
+    partition_->enqueue(this);
+  else
+    home_system().scheduler().enqueue(this);
+}
+
 } // namespace caf
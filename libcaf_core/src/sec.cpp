@@ -56,7 +56,9 @@ const char* sec_strings[] = {
   "no_proxy_registry",
   "runtime_error",
   "remote_linking_failed",
-  "bad_function_call"
+  "bad_function_call",
+  "mailbox_full",
+  "memory_budget_exceeded"
 };
 
 } // namespace <anonymous>
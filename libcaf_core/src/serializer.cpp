@@ -19,6 +19,7 @@
 
 #include "caf/serializer.hpp"
 
+#include "caf/byte_chunk.hpp"
 #include "caf/actor_system.hpp"
 
 namespace caf {
@@ -35,4 +36,11 @@ serializer::~serializer() {
   // nop
 }
 
+error serializer::apply_chunk(const byte_chunk& x) {
+  auto n = x.size();
+  return error::eval([&] { return begin_sequence(n); },
+                     [&] { return apply_raw(n, const_cast<char*>(x.data())); },
+                     [&] { return end_sequence(); });
+}
+
 } // namespace caf
@@ -0,0 +1,59 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/set_thread_affinity.hpp"
+
+#include "caf/config.hpp"
+
+#include "caf/detail/cpu_topology.hpp"
+
+#ifdef CAF_LINUX
+#  include <sched.h>
+#  include <pthread.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+bool set_thread_affinity(const std::vector<int>& cpus) {
+# ifdef CAF_LINUX
+  if (cpus.empty())
+    return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+      return false;
+    CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+# else
+  static_cast<void>(cpus);
+  return false;
+# endif
+}
+
+bool set_thread_affinity(const std::string& cpu_list) {
+  if (cpu_list.empty())
+    return true;
+  return set_thread_affinity(cpu_topology::parse_cpu_list(cpu_list));
+}
+
+} // namespace detail
+} // namespace caf
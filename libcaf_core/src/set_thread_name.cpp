@@ -0,0 +1,49 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/set_thread_name.hpp"
+
+#include "caf/config.hpp"
+
+#if defined(CAF_LINUX)
+#  include <sys/prctl.h>
+#elif defined(CAF_MACOS)
+#  include <pthread.h>
+#elif defined(CAF_BSD)
+#  include <pthread.h>
+#  include <pthread_np.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+void set_thread_name(const char* name) {
+# if defined(CAF_LINUX)
+  prctl(PR_SET_NAME, name, 0, 0, 0);
+# elif defined(CAF_MACOS)
+  pthread_setname_np(name);
+# elif defined(CAF_BSD)
+  pthread_set_name_np(pthread_self(), name);
+# else
+  static_cast<void>(name);
+# endif
+}
+
+} // namespace detail
+} // namespace caf
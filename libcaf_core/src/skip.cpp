@@ -32,4 +32,10 @@ skip_t::operator fun() const {
   return skip_fun_impl;
 }
 
+bool skip_t::is_skip(const fun& f) {
+  using fun_ptr = result<message> (*)(scheduled_actor*, message_view&);
+  auto ptr = f.target<fun_ptr>();
+  return ptr != nullptr && *ptr == skip_fun_impl;
+}
+
 } // namespace caf
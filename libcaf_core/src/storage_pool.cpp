@@ -0,0 +1,88 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/storage_pool.hpp"
+
+#include <new>
+#include <mutex>
+#include <algorithm>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+storage_pool::storage_pool(size_t block_size, size_t max_cached)
+    : block_size_(block_size),
+      max_cached_(max_cached) {
+#ifdef CAF_NO_MEM_MANAGEMENT
+  max_cached_ = 0;
+#endif
+  // reserve all memory up front to make sure `deallocate` never allocates
+  free_.reserve(max_cached_);
+}
+
+storage_pool::~storage_pool() {
+  for (auto x : free_)
+    ::operator delete(x);
+}
+
+void* storage_pool::allocate() {
+  { // lifetime scope of guard
+    std::unique_lock<shared_spinlock> guard{mtx_};
+    if (!free_.empty()) {
+      auto result = free_.back();
+      free_.pop_back();
+      return result;
+    }
+  }
+  return ::operator new(block_size_);
+}
+
+void storage_pool::allocate(size_t n, std::vector<void*>& xs) {
+  xs.reserve(xs.size() + n);
+  { // lifetime scope of guard
+    std::unique_lock<shared_spinlock> guard{mtx_};
+    auto k = std::min(n, free_.size());
+    xs.insert(xs.end(), free_.end() - static_cast<ptrdiff_t>(k), free_.end());
+    free_.resize(free_.size() - k);
+    n -= k;
+  }
+  for (size_t i = 0; i < n; ++i)
+    xs.push_back(::operator new(block_size_));
+}
+
+void storage_pool::deallocate(void* ptr) noexcept {
+  { // lifetime scope of guard
+    std::unique_lock<shared_spinlock> guard{mtx_};
+    if (free_.size() < max_cached_) {
+      free_.push_back(ptr);
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
+size_t storage_pool::cached() const {
+  std::unique_lock<shared_spinlock> guard{mtx_};
+  return free_.size();
+}
+
+} // namespace detail
+} // namespace caf
@@ -22,6 +22,7 @@
 #include <limits>
 
 #include "caf/resumable.hpp"
+#include "caf/system_messages.hpp"
 #include "caf/monitorable_actor.hpp"
 
 namespace caf {
@@ -63,33 +64,6 @@ private:
   message_handler mh_;
 };
 
-class dummy_timer : public monitorable_actor {
-public:
-  dummy_timer(actor_config& cfg, test_coordinator* parent)
-      : monitorable_actor(cfg),
-        parent_(parent) {
-    mh_.assign(
-      [&](const duration& d, strong_actor_ptr& from,
-          strong_actor_ptr& to, message_id mid, message& msg) {
-        auto tout = test_coordinator::hrc::now();
-        tout += d;
-        using delayed_msg = test_coordinator::delayed_msg;
-        parent_->delayed_messages.emplace(tout, delayed_msg{std::move(from),
-                                                            std::move(to), mid,
-                                                            std::move(msg)});
-      }
-    );
-  }
-
-  void enqueue(mailbox_element_ptr what, execution_unit*) override {
-    mh_(what->content());
-  }
-
-private:
-  test_coordinator* parent_;
-  message_handler mh_;
-};
-
 } // namespace <anonymous>
 
 test_coordinator::test_coordinator(actor_system& sys) : super(sys) {
@@ -99,8 +73,6 @@ void test_coordinator::start() {
   dummy_worker worker{this};
   actor_config cfg{&worker};
   auto& sys = system();
-  timer_ = make_actor<dummy_timer, strong_actor_ptr>(
-    sys.next_actor_id(), sys.node(), &sys, cfg, this);
   printer_ = make_actor<dummy_printer, strong_actor_ptr>(
     sys.next_actor_id(), sys.node(), &sys, cfg);
 }
@@ -113,6 +85,24 @@ void test_coordinator::enqueue(resumable* ptr) {
   jobs.push_back(ptr);
 }
 
+void test_coordinator::delayed_send_impl(const duration& rel_time,
+                                         strong_actor_ptr from,
+                                         strong_actor_ptr to, message_id mid,
+                                         message data) {
+  auto tout = hrc::now();
+  tout += rel_time;
+  delayed_messages.emplace(tout, delayed_msg{std::move(from), std::move(to),
+                                             mid, std::move(data)});
+}
+
+void test_coordinator::set_timeout(intrusive_ptr<detail::behavior_timeout>&,
+                                   actor_control_block* self,
+                                   const duration& rel_time, uint32_t tid) {
+  strong_actor_ptr ptr{self};
+  delayed_send_impl(rel_time, ptr, ptr, message_id::make(),
+                    make_message(timeout_msg{tid}));
+}
+
 bool test_coordinator::run_once() {
   if (jobs.empty())
     return false;
@@ -0,0 +1,266 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/timer_thread.hpp"
+
+#include "caf/logger.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/system_messages.hpp"
+#include "caf/actor_system_config.hpp"
+
+#include "caf/detail/set_thread_name.hpp"
+#include "caf/detail/set_thread_affinity.hpp"
+
+namespace caf {
+namespace detail {
+
+clock_entry::clock_entry() : tick(0), next_pending(nullptr) {
+  // nop
+}
+
+clock_entry::~clock_entry() {
+  // nop
+}
+
+behavior_timeout::behavior_timeout(actor_control_block* ptr)
+    : owner(ptr),
+      due(0),
+      id(0),
+      queued(false),
+      abandoned(false),
+      max_due(0) {
+  // nop
+}
+
+behavior_timeout::~behavior_timeout() {
+  // nop
+}
+
+void behavior_timeout::expire(timing_wheel& wheel) {
+  // the clock thread holds a reference to this entry and to the owner as long
+  // as `queued == true`, like a delayed message holds its receiver
+  if (abandoned.load()) {
+    release();
+    return;
+  }
+  auto now = wheel.now();
+  auto t = due.load();
+  if (t > now) {
+    // the owner re-armed the timeout, keep our references
+    wheel.schedule(this, t);
+    return;
+  }
+  // allow the owner to push this entry again before reading `id` and `due`,
+  // since the owner writes `due` and `id` before checking `queued`
+  queued.store(false);
+  auto tid = id.load();
+  t = due.load();
+  if (t > now) {
+    if (!queued.exchange(true)) {
+      wheel.schedule(this, t);
+      return;
+    }
+    // the owner pushed this entry again with new references
+    release();
+    return;
+  }
+  if (tid == 0) {
+    release();
+    return;
+  }
+  // adopt our reference to the owner, since `deref` may destroy this entry
+  strong_actor_ptr ptr{owner, false};
+  deref();
+  ptr->enqueue(ptr, message_id::make(), make_message(timeout_msg{tid}),
+               nullptr);
+}
+
+void behavior_timeout::dispose() {
+  release();
+}
+
+void behavior_timeout::release() {
+  auto ptr = owner;
+  deref();
+  intrusive_ptr_release(ptr);
+}
+
+timer_thread::delayed_msg::delayed_msg(uint64_t t, strong_actor_ptr x,
+                                       strong_actor_ptr y, message_id z,
+                                       message w)
+    : from(std::move(x)),
+      to(std::move(y)),
+      mid(z),
+      msg(std::move(w)) {
+  tick = t;
+}
+
+void timer_thread::delayed_msg::expire(timing_wheel&) {
+  to->enqueue(std::move(from), mid, std::move(msg), nullptr);
+  delete this;
+}
+
+void timer_thread::delayed_msg::dispose() {
+  delete this;
+}
+
+timer_thread::timer_thread()
+    : epoch_(clock_type::now()),
+      pending_(nullptr),
+      stopped_(false) {
+  // nop
+}
+
+timer_thread::~timer_thread() {
+  stop();
+}
+
+void timer_thread::start(actor_system& sys) {
+  CAF_ASSERT(!thread_.joinable());
+  thread_ = std::thread{[this, &sys] {
+    set_thread_name("caf.timer");
+    set_thread_affinity(sys.config().scheduler_utility_cpus);
+    run(sys);
+  }};
+}
+
+void timer_thread::stop() {
+  if (thread_.joinable()) {
+    { // lifetime scope of guard
+      std::unique_lock<std::mutex> guard{mtx_};
+      stopped_ = true;
+      cv_.notify_one();
+    }
+    thread_.join();
+  }
+  fetch_pending();
+  wheel_.clear([](timing_wheel_entry* x) {
+    static_cast<clock_entry*>(x)->dispose();
+  });
+}
+
+void timer_thread::schedule(const duration& rel_time, strong_actor_ptr from,
+                            strong_actor_ptr to, message_id mid,
+                            message msg) {
+  auto t = clock_type::now();
+  t += rel_time;
+  push(new delayed_msg(to_tick(t, true), std::move(from), std::move(to), mid,
+                       std::move(msg)));
+}
+
+void timer_thread::arm(intrusive_ptr<behavior_timeout>& x,
+                       actor_control_block* owner, const duration& rel_time,
+                       uint32_t tid) {
+  auto t = clock_type::now();
+  t += rel_time;
+  auto tick = to_tick(t, true);
+  // the clock thread might still hold the entry at any deadline up to
+  // `max_due`, i.e., we can only re-use the entry for later deadlines
+  if (!x || tick < x->max_due) {
+    abandon(x);
+    x = make_counted<behavior_timeout>(owner);
+  }
+  x->max_due = tick;
+  x->due.store(tick);
+  x->id.store(tid);
+  if (!x->queued.exchange(true)) {
+    x->ref();
+    intrusive_ptr_add_ref(owner);
+    x->tick = tick;
+    push(x.get());
+  }
+}
+
+void timer_thread::disarm(behavior_timeout& x) {
+  x.id.store(0);
+}
+
+void timer_thread::abandon(intrusive_ptr<behavior_timeout>& x) {
+  if (!x)
+    return;
+  x->id.store(0);
+  x->abandoned.store(true);
+  x.reset();
+}
+
+void timer_thread::push(clock_entry* x) {
+  auto head = pending_.load();
+  do {
+    x->next_pending = head;
+  } while (!pending_.compare_exchange_weak(head, x));
+  // only the first timeout on an empty stack needs to wake up the clock
+  // thread, since it always checks the stack before going to sleep
+  if (head == nullptr) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    cv_.notify_one();
+  }
+}
+
+void timer_thread::run(actor_system& sys) {
+  CAF_SET_LOGGER_SYS(&sys);
+  CAF_LOG_TRACE("");
+  auto deliver = [&](timing_wheel_entry* x) {
+    static_cast<clock_entry*>(x)->expire(wheel_);
+  };
+  std::unique_lock<std::mutex> guard{mtx_};
+  while (!stopped_) {
+    guard.unlock();
+    fetch_pending();
+    wheel_.advance(to_tick(clock_type::now(), false), deliver);
+    auto next = wheel_.next_expiry();
+    guard.lock();
+    if (stopped_ || pending_.load() != nullptr)
+      continue;
+    if (next == timing_wheel::never)
+      cv_.wait(guard);
+    else if (next > wheel_.now())
+      cv_.wait_until(guard, epoch_ + resolution{next});
+  }
+}
+
+void timer_thread::fetch_pending() {
+  // restore insertion order by reversing the stack
+  clock_entry* xs = nullptr;
+  auto x = pending_.exchange(nullptr);
+  while (x != nullptr) {
+    auto next = x->next_pending;
+    x->next_pending = xs;
+    xs = x;
+    x = next;
+  }
+  while (xs != nullptr) {
+    auto next = xs->next_pending;
+    wheel_.schedule(xs, xs->tick);
+    xs = next;
+  }
+}
+
+uint64_t timer_thread::to_tick(clock_type::time_point x, bool round_up) const {
+  if (x <= epoch_)
+    return 0;
+  auto d = std::chrono::duration_cast<clock_type::duration>(x - epoch_);
+  auto res = std::chrono::duration_cast<resolution>(d);
+  if (round_up && res < d)
+    res += resolution{1};
+  return static_cast<uint64_t>(res.count());
+}
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,155 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/timing_wheel.hpp"
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+timing_wheel_entry::timing_wheel_entry()
+    : prev_(nullptr),
+      next_(nullptr),
+      list_(nullptr),
+      deadline_(0) {
+  // nop
+}
+
+timing_wheel_entry::~timing_wheel_entry() {
+  // nop
+}
+
+constexpr size_t timing_wheel::slot_bits;
+constexpr size_t timing_wheel::num_slots;
+constexpr size_t timing_wheel::num_levels;
+constexpr uint64_t timing_wheel::never;
+
+namespace {
+
+// returns the bits of `x` above level `level`
+inline uint64_t upper_bits(uint64_t x, size_t level) {
+  auto shift = timing_wheel::slot_bits * (level + 1);
+  return shift < 64 ? x >> shift : 0;
+}
+
+// returns the slot index of `x` at level `level`
+inline size_t slot_index(uint64_t x, size_t level) {
+  return static_cast<size_t>(x >> (timing_wheel::slot_bits * level))
+         & (timing_wheel::num_slots - 1);
+}
+
+} // namespace <anonymous>
+
+timing_wheel::timing_wheel(uint64_t now) : now_(now), size_(0) {
+  for (auto& x : level_sizes_)
+    x = 0;
+  due_ = list{nullptr, nullptr, num_levels};
+  overflow_ = list{nullptr, nullptr, num_levels};
+  for (size_t level = 0; level < num_levels; ++level)
+    for (auto& slot : slots_[level])
+      slot = list{nullptr, nullptr, level};
+}
+
+void timing_wheel::schedule(timing_wheel_entry* x, uint64_t deadline) {
+  CAF_ASSERT(!x->scheduled());
+  x->deadline_ = deadline;
+  if (deadline <= now_) {
+    push_back(due_, x);
+    return;
+  }
+  // pick the finest level that has the current tick and the deadline in the
+  // same rotation, i.e., the slot becomes current before `deadline`
+  for (size_t level = 0; level < num_levels; ++level) {
+    if (upper_bits(deadline, level) == upper_bits(now_, level)) {
+      push_back(slots_[level][slot_index(deadline, level)], x);
+      return;
+    }
+  }
+  push_back(overflow_, x);
+}
+
+void timing_wheel::cancel(timing_wheel_entry* x) {
+  CAF_ASSERT(x->scheduled());
+  auto& xs = *x->list_;
+  if (x->prev_ != nullptr)
+    x->prev_->next_ = x->next_;
+  else
+    xs.head = x->next_;
+  if (x->next_ != nullptr)
+    x->next_->prev_ = x->prev_;
+  else
+    xs.tail = x->prev_;
+  --size_;
+  --level_sizes_[xs.level];
+  x->prev_ = nullptr;
+  x->next_ = nullptr;
+  x->list_ = nullptr;
+}
+
+uint64_t timing_wheel::next_expiry() const {
+  if (size_ == 0)
+    return never;
+  if (due_.head != nullptr)
+    return now_;
+  if (level_sizes_[0] > 0) {
+    auto last = now_ | (num_slots - 1);
+    for (auto t = now_ + 1; t <= last; ++t)
+      if (slots_[0][t & (num_slots - 1)].head != nullptr)
+        return t;
+  }
+  // all remaining entries wait in coarser levels, which cascade no earlier
+  // than at the start of the next rotation of level 0
+  return (now_ | (num_slots - 1)) + 1;
+}
+
+void timing_wheel::push_back(list& xs, timing_wheel_entry* x) {
+  x->list_ = &xs;
+  x->next_ = nullptr;
+  x->prev_ = xs.tail;
+  if (xs.tail != nullptr)
+    xs.tail->next_ = x;
+  else
+    xs.head = x;
+  xs.tail = x;
+  ++size_;
+  ++level_sizes_[xs.level];
+}
+
+void timing_wheel::cascade() {
+  // find the coarsest level that starts a new rotation with this tick
+  size_t top = 0;
+  while (top + 1 < num_levels && slot_index(now_, top) == 0)
+    ++top;
+  if (top + 1 == num_levels && slot_index(now_, top) == 0)
+    reinsert(overflow_);
+  // coarse levels first, because they move entries to finer levels
+  for (auto level = top; level > 0; --level)
+    reinsert(slots_[level][slot_index(now_, level)]);
+}
+
+void timing_wheel::reinsert(list& xs) {
+  auto f = [&](timing_wheel_entry* x) {
+    schedule(x, x->deadline_);
+  };
+  expire(xs, f);
+}
+
+} // namespace detail
+} // namespace caf
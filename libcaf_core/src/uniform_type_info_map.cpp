@@ -37,6 +37,7 @@
 #include "caf/message.hpp"
 #include "caf/duration.hpp"
 #include "caf/timestamp.hpp"
+#include "caf/byte_chunk.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/actor_factory.hpp"
@@ -59,6 +60,7 @@ const char* numbered_type_names[] = {
   "@addrvec",
   "@atom",
   "@charbuf",
+  "@chunk",
   "@down",
   "@duration",
   "@timestamp",
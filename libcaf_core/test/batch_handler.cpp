@@ -0,0 +1,202 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE batch_handler
+#include "caf/test/unit_test.hpp"
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <condition_variable>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+using std::string;
+using std::vector;
+
+namespace {
+
+using hold_atom = atom_constant<atom("hold")>;
+
+// keeps an actor busy until the test releases it
+struct gate {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool entered = false;
+  bool released = false;
+
+  void enter_and_wait() {
+    std::unique_lock<std::mutex> guard{mtx};
+    entered = true;
+    cv.notify_all();
+    cv.wait(guard, [&] { return released; });
+  }
+
+  void await_entered() {
+    std::unique_lock<std::mutex> guard{mtx};
+    cv.wait(guard, [&] { return entered; });
+  }
+
+  void release() {
+    std::unique_lock<std::mutex> guard{mtx};
+    released = true;
+    cv.notify_all();
+  }
+};
+
+// forwards each batch as vector and each string as-is to the observer
+behavior collector(event_based_actor* self, std::shared_ptr<gate> g,
+                   actor observer) {
+  return {
+    [=](hold_atom) {
+      g->enter_and_wait();
+    },
+    [=](batch<int>& xs) {
+      self->send(observer, std::move(xs.values()));
+    },
+    [=](int x) {
+      return x * 2;
+    },
+    [=](const string& x) {
+      self->send(observer, x);
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+  std::unique_ptr<actor_system> system;
+  std::unique_ptr<scoped_actor> self;
+  std::shared_ptr<gate> g;
+
+  fixture() : g(std::make_shared<gate>()) {
+    // nop
+  }
+
+  void start(size_t max_throughput = std::numeric_limits<size_t>::max()) {
+    cfg.scheduler_max_throughput = max_throughput;
+    system.reset(new actor_system(cfg));
+    self.reset(new scoped_actor(*system, true));
+  }
+
+  // spawns a collector and blocks it in its first message
+  actor spawn_held() {
+    auto x = system->spawn(collector, g, actor{*self});
+    (*self)->send(x, hold_atom::value);
+    g->await_entered();
+    return x;
+  }
+
+  // returns all batches the collector forwards within 100ms, whereas
+  // strings appear as empty batches
+  vector<vector<int>> collected() {
+    vector<vector<int>> result;
+    bool done = false;
+    while (!done)
+      (*self)->receive(
+        [&](vector<int>& xs) {
+          result.emplace_back(std::move(xs));
+        },
+        [&](const string&) {
+          result.emplace_back();
+        },
+        after(std::chrono::milliseconds(100)) >> [&] {
+          done = true;
+        }
+      );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(batch_handler_tests, fixture)
+
+CAF_TEST(consecutive_messages_form_one_batch) {
+  start();
+  auto x = spawn_held();
+  for (int i = 0; i < 10; ++i)
+    (*self)->send(x, i);
+  g->release();
+  vector<vector<int>> expected{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  // single messages still arrive as batch
+  (*self)->send(x, 42);
+  expected = {{42}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(other_messages_split_batches) {
+  start();
+  auto x = spawn_held();
+  (*self)->send(x, 1);
+  (*self)->send(x, 2);
+  (*self)->send(x, "split");
+  (*self)->send(x, 3);
+  g->release();
+  vector<vector<int>> expected{{1, 2}, {}, {3}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(requests_bypass_batching) {
+  start();
+  auto x = spawn_held();
+  (*self)->send(x, 1);
+  scoped_actor client{*system};
+  client->send(x, 2);
+  auto rh = client->request(x, infinite, 3);
+  (*self)->send(x, 4);
+  g->release();
+  rh.receive(
+    [](int y) {
+      CAF_CHECK_EQUAL(y, 6);
+    },
+    [&](error& err) {
+      CAF_FAIL("unexpected error: " << system->render(err));
+    }
+  );
+  vector<vector<int>> expected{{1, 2}, {4}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(batches_respect_max_throughput) {
+  start(4);
+  auto x = spawn_held();
+  for (int i = 0; i < 10; ++i)
+    (*self)->send(x, i);
+  g->release();
+  auto batches = collected();
+  vector<int> all;
+  for (auto& xs : batches) {
+    CAF_CHECK_LESS_EQUAL(xs.size(), 4u);
+    all.insert(all.end(), xs.begin(), xs.end());
+  }
+  CAF_CHECK_EQUAL(all, vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
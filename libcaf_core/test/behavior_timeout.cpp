@@ -0,0 +1,164 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE behavior_timeout
+#include "caf/test/unit_test.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/timer_thread.hpp"
+
+using namespace caf;
+
+using std::chrono::milliseconds;
+
+namespace {
+
+using ping_atom = atom_constant<atom("ping")>;
+using timeout_atom = atom_constant<atom("timeout")>;
+
+// reports each timeout to `observer` and keeps re-arming on every message
+behavior idle_watcher(event_based_actor* self, actor observer) {
+  return {
+    [](ping_atom) {
+      // nop
+    },
+    after(milliseconds(50)) >> [=] {
+      self->send(observer, timeout_atom::value);
+    }
+  };
+}
+
+// starts with a long timeout and switches to a short one on `ok_atom`
+behavior shortener(event_based_actor* self, actor observer) {
+  return {
+    [=](ok_atom) {
+      self->become(
+        [](ping_atom) {
+          // nop
+        },
+        after(milliseconds(10)) >> [=] {
+          self->send(observer, timeout_atom::value);
+          self->quit();
+        }
+      );
+    },
+    after(std::chrono::seconds(3600)) >> [=] {
+      self->send(observer, timeout_atom::value);
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system system;
+  scoped_actor self;
+
+  fixture() : system(cfg), self(system, true) {
+    // nop
+  }
+
+  // returns the number of timeouts received within `rel_time`
+  size_t count_timeouts(milliseconds rel_time) {
+    size_t result = 0;
+    auto t = std::chrono::steady_clock::now() + rel_time;
+    for (;;) {
+      auto now = std::chrono::steady_clock::now();
+      if (now >= t)
+        return result;
+      self->receive(
+        [&](timeout_atom) {
+          ++result;
+        },
+        after(std::chrono::duration_cast<milliseconds>(t - now)) >> [] {
+          // nop
+        }
+      );
+    }
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(behavior_timeout_tests, fixture)
+
+CAF_TEST(rearm_without_stale_timeouts) {
+  auto x = system.spawn(idle_watcher, actor{self});
+  // keeps the actor busy for ~200ms without giving the timeout a chance
+  for (int i = 0; i < 20; ++i) {
+    self->send(x, ping_atom::value);
+    std::this_thread::sleep_for(milliseconds(10));
+  }
+  CAF_CHECK_EQUAL(count_timeouts(milliseconds(10)), 0u);
+  // an idle actor triggers its timeout periodically
+  auto n = count_timeouts(milliseconds(180));
+  CAF_CHECK(n >= 1 && n <= 4);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(shorter_timeout_after_become) {
+  auto x = system.spawn(shortener, actor{self});
+  self->send(x, ok_atom::value);
+  CAF_CHECK_EQUAL(count_timeouts(milliseconds(500)), 1u);
+}
+
+CAF_TEST(disarmed_timeout) {
+  auto x = system.spawn([=](event_based_actor* ptr) -> behavior {
+    return {
+      [=](ok_atom) {
+        ptr->become([](ping_atom) {
+          // nop
+        });
+      },
+      after(milliseconds(20)) >> [=] {
+        ptr->send(self, timeout_atom::value);
+      }
+    };
+  });
+  self->send(x, ok_atom::value);
+  CAF_CHECK_EQUAL(count_timeouts(milliseconds(100)), 0u);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(entry_reuse) {
+  detail::timer_thread clock;
+  intrusive_ptr<detail::behavior_timeout> x;
+  auto owner = actor_cast<strong_actor_ptr>(self);
+  clock.arm(x, owner.get(), duration{milliseconds(100)}, 1);
+  CAF_REQUIRE(x != nullptr);
+  auto first = x.get();
+  // later deadlines re-use the entry
+  clock.arm(x, owner.get(), duration{milliseconds(200)}, 2);
+  CAF_CHECK_EQUAL(x.get(), first);
+  CAF_CHECK_EQUAL(x->id.load(), 2u);
+  // earlier deadlines require a new entry
+  clock.arm(x, owner.get(), duration{milliseconds(10)}, 3);
+  CAF_CHECK_NOT_EQUAL(x.get(), first);
+  CAF_CHECK_EQUAL(x->id.load(), 3u);
+  detail::timer_thread::abandon(x);
+  CAF_CHECK(x == nullptr);
+  clock.stop();
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,178 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE blocking_pool
+#include "caf/test/unit_test.hpp"
+
+#include <set>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <condition_variable>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/blocking_pool.hpp"
+
+using namespace caf;
+
+namespace {
+
+// blocks each caller until `count` threads arrived
+struct barrier {
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t count;
+  std::set<std::thread::id> threads;
+
+  explicit barrier(size_t n) : count(n) {
+    // nop
+  }
+
+  void arrive_and_wait() {
+    std::unique_lock<std::mutex> guard{mtx};
+    threads.insert(std::this_thread::get_id());
+    if (--count == 0) {
+      cv.notify_all();
+      return;
+    }
+    cv.wait(guard, [&] { return count == 0; });
+  }
+};
+
+behavior blocker(event_based_actor* self, std::shared_ptr<barrier> b) {
+  return {
+    [=](ok_atom) {
+      b->arrive_and_wait();
+      self->quit();
+      return ok_atom::value;
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+
+  fixture() {
+    cfg.blocking_pool_idle_timeout_ms = 10;
+  }
+
+  // waits up to one second for the pool to terminate all of its threads
+  static bool await_shrink(detail::blocking_pool& pool) {
+    for (int i = 0; i < 100; ++i) {
+      if (pool.num_threads() == 0)
+        return true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(blocking_pool_tests, fixture)
+
+CAF_TEST(pool_grows_while_all_threads_block) {
+  static constexpr size_t num_actors = 8;
+  cfg.blocking_pool_max_threads = num_actors;
+  actor_system system{cfg};
+  auto& pool = system.blocking_pool();
+  CAF_CHECK_EQUAL(pool.num_threads(), 0u);
+  scoped_actor self{system};
+  // each actor blocks until all actors run concurrently
+  auto b = std::make_shared<barrier>(num_actors);
+  for (size_t i = 0; i < num_actors; ++i)
+    self->send(system.spawn<pooled>(blocker, b), ok_atom::value);
+  size_t received = 0;
+  self->receive_for(received, num_actors) (
+    [](ok_atom) {
+      // nop
+    }
+  );
+  CAF_CHECK_EQUAL(b->threads.size(), num_actors);
+  CAF_CHECK(b->threads.count(std::this_thread::get_id()) == 0);
+  CAF_CHECK(await_shrink(pool));
+}
+
+CAF_TEST(pool_respects_max_threads) {
+  static constexpr int num_actors = 20;
+  static constexpr int num_msgs = 50;
+  cfg.blocking_pool_max_threads = 2;
+  actor_system system{cfg};
+  auto& pool = system.blocking_pool();
+  scoped_actor self{system};
+  auto f = [](event_based_actor* self, int remaining, actor listener) {
+    return behavior{
+      [=](int) mutable {
+        if (--remaining == 0) {
+          self->send(listener, ok_atom::value);
+          self->quit();
+        }
+      }
+    };
+  };
+  std::vector<actor> testees;
+  for (int i = 0; i < num_actors; ++i)
+    testees.push_back(system.spawn<pooled>(f, num_msgs, actor{self}));
+  for (int i = 0; i < num_msgs; ++i)
+    for (auto& testee : testees)
+      self->send(testee, i);
+  int received = 0;
+  self->receive_for(received, num_actors) (
+    [&](ok_atom) {
+      CAF_CHECK_LESS_EQUAL(pool.num_threads(), 2u);
+    }
+  );
+  CAF_CHECK_EQUAL(received, num_actors);
+  CAF_CHECK(await_shrink(pool));
+}
+
+CAF_TEST(pooled_actors_interact_with_scheduled_actors) {
+  actor_system system{cfg};
+  scoped_actor self{system};
+  auto echo = system.spawn([]() -> behavior {
+    return {
+      [](int x) {
+        return x;
+      }
+    };
+  });
+  auto client = system.spawn<pooled>([=](event_based_actor* self) -> behavior {
+    return {
+      [=](int x) {
+        return self->delegate(echo, x + 1);
+      }
+    };
+  });
+  self->request(client, infinite, 41).receive(
+    [](int x) {
+      CAF_CHECK_EQUAL(x, 42);
+    },
+    [&](error& err) {
+      CAF_FAIL("unexpected error: " << system.render(err));
+    }
+  );
+  self->send_exit(echo, exit_reason::user_shutdown);
+  self->send_exit(client, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,237 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE bounded_mailbox
+#include "caf/test/unit_test.hpp"
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/single_reader_queue.hpp"
+
+using namespace caf;
+
+using std::vector;
+
+namespace {
+
+using hold_atom = atom_constant<atom("hold")>;
+
+struct elem {
+  elem* next;
+  elem* prev;
+  int value;
+
+  explicit elem(int x = 0) : next(nullptr), prev(nullptr), value(x) {
+    // nop
+  }
+};
+
+using queue_type = detail::single_reader_queue<elem>;
+
+int pop(queue_type& q) {
+  std::unique_ptr<elem> x{q.try_pop()};
+  return x ? x->value : -1;
+}
+
+// keeps an actor busy until the test releases it
+struct gate {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool entered = false;
+  bool released = false;
+
+  void enter_and_wait() {
+    std::unique_lock<std::mutex> guard{mtx};
+    entered = true;
+    cv.notify_all();
+    cv.wait(guard, [&] { return released; });
+  }
+
+  void await_entered() {
+    std::unique_lock<std::mutex> guard{mtx};
+    cv.wait(guard, [&] { return entered; });
+  }
+
+  void release() {
+    std::unique_lock<std::mutex> guard{mtx};
+    released = true;
+    cv.notify_all();
+  }
+};
+
+behavior collector(event_based_actor* self, std::shared_ptr<gate> g,
+                   actor observer) {
+  return {
+    [=](hold_atom) {
+      g->enter_and_wait();
+    },
+    [=](int x) {
+      self->send(observer, x);
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system system;
+  scoped_actor self;
+  std::shared_ptr<gate> g;
+
+  fixture() : system(cfg), self(system, true), g(std::make_shared<gate>()) {
+    // nop
+  }
+
+  // spawns a collector with capacity 3 and blocks it in its first message
+  actor spawn_held(overflow_policy policy) {
+    auto x = system.spawn_bounded(3, policy, collector, g, actor{self});
+    self->send(x, hold_atom::value);
+    g->await_entered();
+    return x;
+  }
+
+  // returns all integers the collector forwards within 100ms
+  vector<int> collected() {
+    vector<int> result;
+    bool done = false;
+    while (!done)
+      self->receive(
+        [&](int x) {
+          result.push_back(x);
+        },
+        after(std::chrono::milliseconds(100)) >> [&] {
+          done = true;
+        }
+      );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST(unbounded_queue) {
+  queue_type q;
+  CAF_CHECK_EQUAL(q.capacity(), 0u);
+  for (int i = 0; i < 10; ++i)
+    CAF_CHECK(q.enqueue(new elem(i)) != detail::enqueue_result::queue_full);
+  CAF_CHECK_EQUAL(q.size(), 0u);
+  for (int i = 0; i < 10; ++i)
+    CAF_CHECK_EQUAL(pop(q), i);
+}
+
+CAF_TEST(bounded_queue) {
+  queue_type q;
+  q.capacity(3);
+  for (int i = 0; i < 3; ++i)
+    CAF_CHECK(q.enqueue(new elem(i)) != detail::enqueue_result::queue_full);
+  CAF_CHECK_EQUAL(q.size(), 3u);
+  std::unique_ptr<elem> x{new elem(3)};
+  CAF_CHECK(q.enqueue(x.get()) == detail::enqueue_result::queue_full);
+  // drop the oldest element to make room for x
+  CAF_CHECK(q.displace_oldest(x.release()) == detail::enqueue_result::success);
+  CAF_CHECK_EQUAL(q.size(), 3u);
+  CAF_CHECK_EQUAL(pop(q), 1);
+  CAF_CHECK_EQUAL(q.size(), 2u);
+  // the reader already fetched all remaining elements
+  x.reset(new elem(4));
+  CAF_CHECK(q.displace_oldest(x.get()) == detail::enqueue_result::queue_full);
+  CAF_CHECK(q.force_enqueue(new elem(5)) == detail::enqueue_result::success);
+  CAF_CHECK(q.enqueue(x.get()) == detail::enqueue_result::queue_full);
+  CAF_CHECK_EQUAL(q.size(), 3u);
+  CAF_CHECK_EQUAL(pop(q), 2);
+  CAF_CHECK_EQUAL(pop(q), 3);
+  CAF_CHECK_EQUAL(pop(q), 5);
+  CAF_CHECK_EQUAL(q.size(), 0u);
+  CAF_CHECK(q.enqueue(x.release()) != detail::enqueue_result::queue_full);
+  CAF_CHECK_EQUAL(pop(q), 4);
+}
+
+CAF_TEST_FIXTURE_SCOPE(bounded_mailbox_tests, fixture)
+
+CAF_TEST(drop_newest) {
+  auto x = spawn_held(overflow_policy::drop_newest);
+  for (int i = 1; i <= 5; ++i)
+    self->send(x, i);
+  g->release();
+  CAF_CHECK_EQUAL(collected(), vector<int>({1, 2, 3}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(drop_oldest) {
+  auto x = spawn_held(overflow_policy::drop_oldest);
+  for (int i = 1; i <= 5; ++i)
+    self->send(x, i);
+  g->release();
+  CAF_CHECK_EQUAL(collected(), vector<int>({3, 4, 5}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(reject) {
+  auto x = spawn_held(overflow_policy::reject);
+  for (int i = 1; i <= 3; ++i)
+    self->send(x, i);
+  self->request(x, infinite, 4).receive(
+    [&](int) {
+      CAF_FAIL("bounded mailbox accepted too many messages");
+    },
+    [&](error& err) {
+      CAF_CHECK_EQUAL(err, sec::mailbox_full);
+    }
+  );
+  g->release();
+  CAF_CHECK_EQUAL(collected(), vector<int>({1, 2, 3}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(block) {
+  auto x = spawn_held(overflow_policy::block);
+  // anonymous messages from outside of the scheduler wait for the receiver
+  std::thread sender{[x] {
+    for (int i = 1; i <= 5; ++i)
+      anon_send(x, i);
+  }};
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  g->release();
+  sender.join();
+  CAF_CHECK_EQUAL(collected(), vector<int>({1, 2, 3, 4, 5}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(exit_messages_bypass_capacity) {
+  auto x = spawn_held(overflow_policy::drop_newest);
+  self->monitor(x);
+  for (int i = 1; i <= 3; ++i)
+    self->send(x, i);
+  anon_send_exit(x, exit_reason::user_shutdown);
+  g->release();
+  self->receive(
+    [&](const down_msg& dm) {
+      CAF_CHECK_EQUAL(dm.reason, exit_reason::user_shutdown);
+    }
+  );
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,163 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE byte_chunk
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+using buffer = std::vector<char>;
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system system{cfg};
+  scoped_execution_unit context{&system};
+
+  byte_chunk make_chunk(const std::string& str) {
+    return byte_chunk::copy(str.data(), str.size());
+  }
+
+  template <class T>
+  buffer serialize(T& x) {
+    buffer buf;
+    binary_serializer bs{&context, buf};
+    auto err = bs(x);
+    CAF_REQUIRE(!err);
+    return buf;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(byte_chunk_tests, fixture)
+
+CAF_TEST(default_construction) {
+  byte_chunk x;
+  CAF_CHECK(x.empty());
+  CAF_CHECK_EQUAL(x.size(), 0u);
+  CAF_CHECK(x.get_storage() == nullptr);
+  CAF_CHECK(x.begin() == x.end());
+}
+
+CAF_TEST(adopting_buffers) {
+  buffer buf{'a', 'b', 'c'};
+  auto ptr = buf.data();
+  byte_chunk x{std::move(buf)};
+  CAF_CHECK_EQUAL(x.size(), 3u);
+  CAF_CHECK(x.data() == ptr);
+  CAF_CHECK_EQUAL(x.to_vector(), buffer({'a', 'b', 'c'}));
+}
+
+CAF_TEST(slicing) {
+  auto x = make_chunk("hello world");
+  auto y = x.slice(6);
+  CAF_CHECK(y.shares_storage_with(x));
+  CAF_CHECK(y.data() == x.data() + 6);
+  CAF_CHECK_EQUAL(y, make_chunk("world"));
+  CAF_CHECK_EQUAL(x.slice(0, 5), make_chunk("hello"));
+  CAF_CHECK_EQUAL(x.slice(6, 100), make_chunk("world"));
+  CAF_CHECK(x.slice(11).empty());
+  CAF_CHECK(x.slice(100, 5).empty());
+  CAF_CHECK_EQUAL(y.slice(1, 3), make_chunk("orl"));
+}
+
+CAF_TEST(copies_share_storage) {
+  auto x = make_chunk("shared");
+  auto y = x;
+  CAF_CHECK(y.shares_storage_with(x));
+  CAF_CHECK(y.data() == x.data());
+  CAF_CHECK(!x.get_storage()->unique());
+  y.reset();
+  CAF_CHECK(y.empty());
+  CAF_CHECK(x.get_storage()->unique());
+  auto msg1 = make_message(x);
+  auto msg2 = msg1;
+  CAF_REQUIRE(msg2.match_elements<byte_chunk>());
+  CAF_CHECK(msg2.get_as<byte_chunk>(0).data() == x.data());
+  // copy-on-write copies the chunk object, but never its content
+  msg2.get_mutable_as<byte_chunk>(0) = msg2.get_as<byte_chunk>(0).slice(1);
+  CAF_CHECK(msg1.get_as<byte_chunk>(0).data() == x.data());
+  CAF_CHECK(msg2.get_as<byte_chunk>(0).data() == x.data() + 1);
+}
+
+CAF_TEST(comparison) {
+  CAF_CHECK_EQUAL(make_chunk("abc"), make_chunk("abc"));
+  CAF_CHECK_NOT_EQUAL(make_chunk("abc"), make_chunk("abd"));
+  CAF_CHECK_LESS(make_chunk("ab"), make_chunk("abc"));
+  CAF_CHECK_LESS(make_chunk("abc"), make_chunk("b"));
+  CAF_CHECK_EQUAL(byte_chunk{}, make_chunk(""));
+}
+
+CAF_TEST(serialization) {
+  auto x = make_chunk("lorem ipsum");
+  auto vec = x.to_vector();
+  // chunks use the same binary format as std::vector<char>
+  auto buf = serialize(x);
+  CAF_CHECK_EQUAL(buf, serialize(vec));
+  byte_chunk y;
+  binary_deserializer bd{&context, buf};
+  CAF_REQUIRE(!bd(y));
+  CAF_CHECK_EQUAL(x, y);
+  CAF_CHECK(!y.shares_storage_with(x));
+  // chunks serialize as part of a message
+  auto msg = make_message(x, std::string{"dolor"});
+  auto msg_buf = serialize(msg);
+  message msg_copy;
+  binary_deserializer msg_bd{&context, msg_buf};
+  CAF_REQUIRE(!msg_bd(msg_copy));
+  CAF_REQUIRE((msg_copy.match_elements<byte_chunk, std::string>()));
+  CAF_CHECK_EQUAL(msg_copy.get_as<byte_chunk>(0), x);
+  CAF_CHECK_EQUAL(to_string(msg_copy), to_string(msg));
+}
+
+CAF_TEST(chunk_writer) {
+  auto small = make_chunk("abc");
+  auto large = make_chunk("lorem ipsum dolor sit amet");
+  std::vector<std::pair<size_t, byte_chunk>> deferred;
+  buffer buf;
+  binary_serializer bs{&context, buf};
+  auto cw = make_callback([&](const byte_chunk& x) -> error {
+    deferred.emplace_back(buf.size(), x);
+    return none;
+  });
+  bs.set_chunk_writer(&cw, 10);
+  CAF_REQUIRE(!bs(small, large, small));
+  // only the large chunk bypasses the buffer
+  CAF_REQUIRE_EQUAL(deferred.size(), 1u);
+  CAF_CHECK(deferred.front().second.shares_storage_with(large));
+  // merging the deferred chunk back into the buffer at the recorded position
+  // yields the regular serialization format
+  buf.insert(buf.begin() + static_cast<ptrdiff_t>(deferred.front().first),
+             large.begin(), large.end());
+  buffer expected;
+  binary_serializer expected_bs{&context, expected};
+  CAF_REQUIRE(!expected_bs(small, large, small));
+  CAF_CHECK_EQUAL(buf, expected);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,219 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE cache_index
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/cache_index.hpp"
+
+using namespace caf;
+
+using std::string;
+using std::vector;
+
+namespace {
+
+using go_atom = atom_constant<atom("go")>;
+
+mailbox_element_ptr make_elem(message_id mid, int x) {
+  return make_mailbox_element(nullptr, mid, {}, x);
+}
+
+mailbox_element_ptr make_elem(message_id mid, string x) {
+  return make_mailbox_element(nullptr, mid, {}, std::move(x));
+}
+
+// stashes strings until receiving `go_atom` and forwards everything to `buddy`
+behavior stasher(event_based_actor* self, actor buddy) {
+  self->set_default_handler(skip);
+  return {
+    [=](int x) {
+      self->send(buddy, x);
+    },
+    [=](go_atom) {
+      self->become(
+        [=](const string& x) {
+          self->send(buddy, x);
+        }
+      );
+    }
+  };
+}
+
+behavior adder() {
+  return {
+    [](int x, int y) {
+      return x + y;
+    }
+  };
+}
+
+// stashes all integers while awaiting a response and forwards their sum
+behavior awaiter(event_based_actor* self, actor buddy, actor server) {
+  self->request(server, infinite, 1, 2).await(
+    [=](int x) {
+      self->send(buddy, x);
+    }
+  );
+  auto sum = std::make_shared<int>(0);
+  return {
+    [=](int x) {
+      *sum += x;
+    },
+    [=](go_atom) {
+      self->send(buddy, *sum);
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system system;
+  scoped_actor self;
+
+  fixture() : system(cfg), self(system) {
+    // nop
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST(index_order) {
+  detail::cache_index index;
+  auto a = make_elem(message_id::make(), 1);
+  auto b = make_elem(message_id::make(), "b");
+  auto c = make_elem(message_id::make(), 3);
+  auto d = make_elem(message_id::make(message_priority::high), 4);
+  index.add(a.get());
+  index.add(b.get());
+  index.add(c.get());
+  index.add(d.get(), true);
+  auto int_token = make_type_token<int>();
+  auto ints = [&](detail::cache_index::key_type key) {
+    return key == int_token;
+  };
+  vector<mailbox_element*> xs;
+  auto x = index.next(0, ints);
+  while (x.second != nullptr) {
+    xs.push_back(x.second);
+    x = index.next(x.first, ints);
+  }
+  CAF_CHECK(xs == vector<mailbox_element*>({d.get(), a.get(), c.get()}));
+  index.erase(d.get());
+  index.erase(a.get());
+  CAF_CHECK_EQUAL(index.next(0, ints).second, c.get());
+  index.erase(c.get());
+  CAF_CHECK_EQUAL(index.next(0, ints).second, nullptr);
+  CAF_CHECK(!index.empty());
+  index.clear();
+  CAF_CHECK(index.empty());
+}
+
+CAF_TEST(index_responses) {
+  detail::cache_index index;
+  auto mid = message_id::make().with_high_priority();
+  auto req = message_id::from_integer_value(42);
+  auto a = make_elem(req.response_id(), 1);
+  auto b = make_elem(message_id::make(), 2);
+  index.add(a.get());
+  index.add(b.get());
+  CAF_CHECK_EQUAL(index.response(req.response_id()), a.get());
+  CAF_CHECK_EQUAL(index.response(mid.response_id()), nullptr);
+  auto responses = [](detail::cache_index::key_type key) {
+    return key == detail::cache_index::response_key;
+  };
+  CAF_CHECK_EQUAL(index.next(0, responses).second, a.get());
+  index.erase(a.get());
+  CAF_CHECK_EQUAL(index.response(req.response_id()), nullptr);
+}
+
+CAF_TEST_FIXTURE_SCOPE(cache_index_tests, fixture)
+
+CAF_TEST(stashed_messages) {
+  auto x = system.spawn(stasher, actor{self});
+  self->send(x, "a");
+  self->send(x, 1);
+  self->send(x, "b");
+  self->send(x, 2);
+  self->send(x, go_atom::value);
+  vector<int> ints;
+  vector<string> strs;
+  size_t i = 0;
+  self->receive_for(i, size_t{4})(
+    [&](int y) {
+      ints.push_back(y);
+    },
+    [&](const string& y) {
+      strs.push_back(y);
+    }
+  );
+  CAF_CHECK_EQUAL(ints, vector<int>({1, 2}));
+  CAF_CHECK_EQUAL(strs, vector<string>({"a", "b"}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(awaited_response) {
+  auto server = system.spawn(adder);
+  auto x = system.spawn(awaiter, actor{self}, server);
+  for (int i = 1; i <= 1000; ++i)
+    self->send(x, i);
+  self->send(x, go_atom::value);
+  vector<int> results;
+  size_t i = 0;
+  self->receive_for(i, size_t{2})(
+    [&](int y) {
+      results.push_back(y);
+    }
+  );
+  CAF_CHECK_EQUAL(results, vector<int>({3, 500500}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+  anon_send_exit(server, exit_reason::user_shutdown);
+}
+
+CAF_TEST(blocking_response) {
+  auto server = system.spawn(adder);
+  for (int i = 0; i < 1000; ++i)
+    self->send(self, i);
+  self->request(server, infinite, 1, 2).receive(
+    [](int y) {
+      CAF_CHECK_EQUAL(y, 3);
+    },
+    [](error& err) {
+      CAF_FAIL("unexpected error: " << to_string(err));
+    }
+  );
+  int expected = 0;
+  size_t i = 0;
+  self->receive_for(i, size_t{1000})(
+    [&](int y) {
+      CAF_CHECK_EQUAL(y, expected++);
+    }
+  );
+  CAF_CHECK_EQUAL(expected, 1000);
+  anon_send_exit(server, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,224 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE conflating_mailbox
+#include "caf/test/unit_test.hpp"
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <condition_variable>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+using std::string;
+using std::vector;
+
+namespace {
+
+using hold_atom = atom_constant<atom("hold")>;
+
+using stop_atom = atom_constant<atom("stop")>;
+
+using update = std::pair<int, int>;
+
+// keeps an actor busy until the test releases it
+struct gate {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool entered = false;
+  bool released = false;
+
+  void enter_and_wait() {
+    std::unique_lock<std::mutex> guard{mtx};
+    entered = true;
+    cv.notify_all();
+    cv.wait(guard, [&] { return released; });
+  }
+
+  void await_entered() {
+    std::unique_lock<std::mutex> guard{mtx};
+    cv.wait(guard, [&] { return entered; });
+  }
+
+  void release() {
+    std::unique_lock<std::mutex> guard{mtx};
+    released = true;
+    cv.notify_all();
+  }
+
+  void reset() {
+    std::unique_lock<std::mutex> guard{mtx};
+    entered = false;
+    released = false;
+  }
+};
+
+// conflates `(int key, int value)` messages by their key
+optional<uint64_t> by_first_int(const type_erased_tuple& x) {
+  if (x.size() == 2 && x.type_token() == make_type_token<int, int>())
+    return static_cast<uint64_t>(x.get_as<int>(0));
+  return none;
+}
+
+behavior collector(event_based_actor* self, std::shared_ptr<gate> g,
+                   actor observer) {
+  return {
+    [=](hold_atom) {
+      g->enter_and_wait();
+    },
+    [=](stop_atom) {
+      g->enter_and_wait();
+      self->quit();
+    },
+    [=](int key, int value) {
+      self->send(observer, key, value);
+    },
+    [=](const string& str) {
+      self->send(observer, str);
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system system;
+  scoped_actor self;
+  std::shared_ptr<gate> g;
+
+  fixture() : system(cfg), self(system, true), g(std::make_shared<gate>()) {
+    // nop
+  }
+
+  // spawns a conflating collector and blocks it in its first message
+  actor spawn_held(size_t slots) {
+    auto x = system.spawn_conflating(slots, by_first_int, collector, g,
+                                     actor{self});
+    self->send(x, hold_atom::value);
+    g->await_entered();
+    return x;
+  }
+
+  // returns all updates the collector forwards within 100ms
+  vector<update> collected() {
+    vector<update> result;
+    bool done = false;
+    while (!done)
+      self->receive(
+        [&](int key, int value) {
+          result.emplace_back(key, value);
+        },
+        [&](const string&) {
+          result.emplace_back(-1, -1);
+        },
+        after(std::chrono::milliseconds(100)) >> [&] {
+          done = true;
+        }
+      );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(conflating_mailbox_tests, fixture)
+
+CAF_TEST(newest_value_wins) {
+  auto x = spawn_held(16);
+  for (int i = 0; i < 5; ++i)
+    for (int key = 1; key <= 3; ++key)
+      self->send(x, key, i);
+  g->release();
+  // keys keep the position of their first message
+  vector<update> expected{{1, 4}, {2, 4}, {3, 4}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  // the slots become available again after processing
+  g->reset();
+  self->send(x, hold_atom::value);
+  g->await_entered();
+  self->send(x, 2, 10);
+  self->send(x, 2, 11);
+  g->release();
+  expected = {{2, 11}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(messages_without_key_bypass_conflation) {
+  auto x = spawn_held(16);
+  self->send(x, 1, 1);
+  self->send(x, "a");
+  self->send(x, "b");
+  self->send(x, 1, 2);
+  g->release();
+  vector<update> expected{{1, 2}, {-1, -1}, {-1, -1}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(requests_bypass_conflation) {
+  auto x = spawn_held(16);
+  scoped_actor client{system};
+  self->send(x, 1, 1);
+  auto rh = client->request(x, infinite, 1, 2);
+  self->send(x, 1, 3);
+  g->release();
+  rh.receive(
+    [] {
+      // nop
+    },
+    [&](error& err) {
+      CAF_FAIL("unexpected error: " << system.render(err));
+    }
+  );
+  vector<update> expected{{1, 3}, {1, 2}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(full_table_falls_back_to_plain_enqueue) {
+  auto x = spawn_held(2);
+  for (int i = 0; i < 2; ++i)
+    for (int key = 1; key <= 3; ++key)
+      self->send(x, key, i);
+  g->release();
+  vector<update> expected{{1, 1}, {2, 1}, {3, 0}, {3, 1}};
+  CAF_CHECK_EQUAL(collected(), expected);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(pending_messages_get_disposed_on_exit) {
+  auto x = system.spawn_conflating(16, by_first_int, collector, g,
+                                   actor{self});
+  self->send(x, stop_atom::value);
+  g->await_entered();
+  for (int i = 0; i < 100; ++i)
+    self->send(x, i % 4, i);
+  g->release();
+  self->wait_for(x);
+  CAF_CHECK_EQUAL(collected().size(), 0u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
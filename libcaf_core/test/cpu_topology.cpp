@@ -0,0 +1,199 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE cpu_topology
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/policy/work_stealing.hpp"
+
+#include "caf/scheduler/coordinator.hpp"
+
+#ifndef CAF_WINDOWS
+#include <stdlib.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef CAF_LINUX
+#include <sched.h>
+#include <sys/prctl.h>
+#endif
+
+using namespace caf;
+
+using detail::cpu_topology;
+
+namespace {
+
+using ivec = std::vector<int>;
+
+#ifndef CAF_WINDOWS
+
+// creates a fake `/sys/devices/system` with two nodes, each having two
+// caches shared by two CPUs, i.e., 8 CPUs in total
+struct fake_sysfs {
+  fake_sysfs() {
+    char tmpl[] = "/tmp/caf-cpu-topology-XXXXXX";
+    root = mkdtemp(tmpl);
+    mkdirs("cpu");
+    write("cpu/online", "0-7");
+    mkdirs("node");
+    write("node/online", "0-1");
+    mkdirs("node/node0");
+    write("node/node0/cpulist", "0-1,4-5");
+    mkdirs("node/node1");
+    write("node/node1/cpulist", "2-3,6-7");
+    for (int i = 0; i < 8; ++i) {
+      auto dir = "cpu/cpu" + std::to_string(i);
+      mkdirs(dir);
+      mkdirs(dir + "/cache");
+      mkdirs(dir + "/cache/index0");
+      write(dir + "/cache/index0/level", "1");
+      write(dir + "/cache/index0/shared_cpu_list", std::to_string(i));
+      mkdirs(dir + "/cache/index1");
+      write(dir + "/cache/index1/level", "3");
+      write(dir + "/cache/index1/shared_cpu_list", i % 2 == 0
+                                                   ? std::to_string(i) + ","
+                                                     + std::to_string(i + 1)
+                                                   : std::to_string(i - 1)
+                                                     + "-"
+                                                     + std::to_string(i));
+    }
+  }
+
+  ~fake_sysfs() {
+    auto cmd = "rm -rf " + root;
+    static_cast<void>(system(cmd.c_str()));
+  }
+
+  void mkdirs(const std::string& path) {
+    mkdir((root + "/" + path).c_str(), 0700);
+  }
+
+  void write(const std::string& path, const std::string& line) {
+    std::ofstream out{root + "/" + path};
+    out << line << '\n';
+  }
+
+  std::string root;
+};
+
+#endif // CAF_WINDOWS
+
+} // namespace <anonymous>
+
+CAF_TEST(parse_cpu_list) {
+  CAF_CHECK_EQUAL(cpu_topology::parse_cpu_list(""), ivec{});
+  CAF_CHECK_EQUAL(cpu_topology::parse_cpu_list("0"), ivec{0});
+  CAF_CHECK_EQUAL(cpu_topology::parse_cpu_list("0-3"), (ivec{0, 1, 2, 3}));
+  CAF_CHECK_EQUAL(cpu_topology::parse_cpu_list("0-1,4,10-11"),
+                  (ivec{0, 1, 4, 10, 11}));
+  CAF_CHECK_EQUAL(cpu_topology::parse_cpu_list("2,x"), ivec{2});
+  CAF_CHECK_EQUAL(cpu_topology::parse_cpu_list("2-"), ivec{});
+}
+
+CAF_TEST(distance) {
+  cpu_topology::cpu x{0, 0, 0};
+  cpu_topology::cpu y{1, 0, 0};
+  cpu_topology::cpu z{2, 2, 0};
+  cpu_topology::cpu w{3, 3, 1};
+  CAF_CHECK_EQUAL(cpu_topology::distance(x, y), cpu_topology::shared_cache);
+  CAF_CHECK_EQUAL(cpu_topology::distance(x, z), cpu_topology::same_node);
+  CAF_CHECK_EQUAL(cpu_topology::distance(x, w), cpu_topology::remote_node);
+}
+
+CAF_TEST(missing_sysfs) {
+  CAF_CHECK(cpu_topology::read("/nonexisting/caf/sysfs").empty());
+}
+
+#ifndef CAF_WINDOWS
+
+CAF_TEST(read_sysfs) {
+  fake_sysfs fs;
+  auto t = cpu_topology::read(fs.root);
+  ivec ids;
+  ivec caches;
+  ivec nodes;
+  for (auto& x : t.cpus()) {
+    ids.push_back(x.id);
+    caches.push_back(x.cache);
+    nodes.push_back(x.node);
+  }
+  // CPUs are sorted by node first, then by cache
+  CAF_CHECK_EQUAL(ids, (ivec{0, 1, 4, 5, 2, 3, 6, 7}));
+  CAF_CHECK_EQUAL(caches, (ivec{0, 0, 4, 4, 2, 2, 6, 6}));
+  CAF_CHECK_EQUAL(nodes, (ivec{0, 0, 0, 0, 1, 1, 1, 1}));
+}
+
+#endif // CAF_WINDOWS
+
+CAF_TEST(topology_aware_stealing) {
+  actor_system_config cfg;
+  cfg.scheduler_max_threads = 4;
+  cfg.work_stealing_victim_selection = atom("topology");
+  actor_system sys{cfg};
+  using coordinator = scheduler::coordinator<policy::work_stealing>;
+  auto sched = dynamic_cast<coordinator*>(&sys.scheduler());
+  CAF_REQUIRE(sched != nullptr);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 100; ++i)
+    sys.spawn([&] { ++count; });
+  sys.await_all_actors_done();
+  CAF_CHECK_EQUAL(count.load(), 100);
+  auto steals = policy::work_stealing::steal_statistics(sched);
+  CAF_MESSAGE("steals by locality: " << deep_to_string(steals));
+}
+
+#ifdef CAF_LINUX
+
+CAF_TEST(worker_cpus_and_thread_names) {
+  actor_system_config cfg;
+  cfg.scheduler_max_threads = 2;
+  cfg.scheduler_worker_cpus = "0";
+  actor_system sys{cfg};
+  std::string name;
+  int num_cpus = 0;
+  bool on_cpu0 = false;
+  sys.spawn([&] {
+    char buf[16] = {};
+    prctl(PR_GET_NAME, buf, 0, 0, 0);
+    name = buf;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+      num_cpus = CPU_COUNT(&set);
+      on_cpu0 = CPU_ISSET(0, &set);
+    }
+  });
+  sys.await_all_actors_done();
+  CAF_CHECK_EQUAL(name.compare(0, 11, "caf.worker."), 0);
+  CAF_CHECK_EQUAL(num_cpus, 1);
+  CAF_CHECK(on_cpu0);
+}
+
+#endif // CAF_LINUX
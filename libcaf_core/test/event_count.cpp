@@ -0,0 +1,88 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE event_count
+#include "caf/test/unit_test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "caf/detail/event_count.hpp"
+
+using caf::detail::event_count;
+
+namespace {
+
+// blocks on `ec` until `x` becomes positive, then decrements `x`
+void consume(event_count& ec, std::atomic<int>& x) {
+  for (;;) {
+    auto val = x.load();
+    while (val > 0)
+      if (x.compare_exchange_weak(val, val - 1))
+        return;
+    auto key = ec.prepare_wait();
+    if (x.load() > 0) {
+      ec.cancel_wait();
+      continue;
+    }
+    ec.wait(key);
+  }
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(no_waiters) {
+  event_count ec;
+  CAF_CHECK_EQUAL(ec.waiters(), 0u);
+  ec.notify_one();
+  ec.notify_all();
+  auto key = ec.prepare_wait();
+  CAF_CHECK_EQUAL(ec.waiters(), 1u);
+  ec.cancel_wait();
+  CAF_CHECK_EQUAL(ec.waiters(), 0u);
+  // a notification between prepare_wait and wait must not get lost
+  key = ec.prepare_wait();
+  ec.notify_one();
+  ec.wait(key);
+  CAF_CHECK_EQUAL(ec.waiters(), 0u);
+}
+
+CAF_TEST(producer_consumer) {
+  static constexpr int num_consumers = 4;
+  static constexpr int num_items = 10000;
+  event_count ec;
+  std::atomic<int> items{0};
+  std::vector<std::thread> consumers;
+  for (int i = 0; i < num_consumers; ++i)
+    consumers.emplace_back([&] {
+      for (int j = 0; j < num_items / num_consumers; ++j)
+        consume(ec, items);
+    });
+  for (int i = 0; i < num_items; ++i) {
+    ++items;
+    ec.notify_one();
+  }
+  for (auto& t : consumers)
+    t.join();
+  CAF_CHECK_EQUAL(items.load(), 0);
+  CAF_CHECK_EQUAL(ec.waiters(), 0u);
+}
@@ -0,0 +1,193 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE mailbox_lanes
+#include "caf/test/unit_test.hpp"
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <condition_variable>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/single_reader_queue.hpp"
+
+using namespace caf;
+
+using std::vector;
+
+namespace {
+
+using hold_atom = atom_constant<atom("hold")>;
+
+size_t s_elements = 0;
+
+struct elem {
+  elem* next;
+  elem* prev;
+  int value;
+
+  explicit elem(int x = 0) : next(nullptr), prev(nullptr), value(x) {
+    ++s_elements;
+  }
+
+  ~elem() {
+    --s_elements;
+  }
+};
+
+using queue_type = detail::single_reader_queue<elem, std::default_delete<elem>,
+                                               2>;
+
+int pop(queue_type& q) {
+  std::unique_ptr<elem> x{q.try_pop()};
+  return x ? x->value : -1;
+}
+
+vector<int> drain(queue_type& q) {
+  vector<int> result;
+  for (auto x = pop(q); x != -1; x = pop(q))
+    result.push_back(x);
+  return result;
+}
+
+// keeps an actor busy until the test releases it
+struct gate {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool entered = false;
+  bool released = false;
+
+  void enter_and_wait() {
+    std::unique_lock<std::mutex> guard{mtx};
+    entered = true;
+    cv.notify_all();
+    cv.wait(guard, [&] { return released; });
+  }
+
+  void await_entered() {
+    std::unique_lock<std::mutex> guard{mtx};
+    cv.wait(guard, [&] { return entered; });
+  }
+
+  void release() {
+    std::unique_lock<std::mutex> guard{mtx};
+    released = true;
+    cv.notify_all();
+  }
+};
+
+// reports how many normal messages it processed before an `ok_atom`
+behavior counter(event_based_actor* self, std::shared_ptr<gate> g,
+                 actor observer) {
+  auto count = std::make_shared<int>(0);
+  return {
+    [=](hold_atom) {
+      g->enter_and_wait();
+    },
+    [=](int) {
+      ++*count;
+    },
+    [=](ok_atom) {
+      self->send(observer, *count);
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(strict_priority) {
+  queue_type q;
+  for (int i = 0; i < 100000; ++i)
+    q.enqueue(new elem(i));
+  q.enqueue(new elem(-2), 1);
+  CAF_CHECK_EQUAL(pop(q), -2);
+  CAF_CHECK_EQUAL(pop(q), 0);
+  q.enqueue(new elem(-3), 1);
+  CAF_CHECK_EQUAL(pop(q), -3);
+  CAF_CHECK_EQUAL(pop(q), 1);
+  CAF_CHECK_EQUAL(q.count(), 99998u);
+}
+
+CAF_TEST(max_streak) {
+  queue_type q;
+  q.max_streak(2);
+  q.enqueue(new elem(1));
+  q.enqueue(new elem(2));
+  for (int i = 10; i < 15; ++i)
+    q.enqueue(new elem(i), 1);
+  CAF_CHECK_EQUAL(drain(q), vector<int>({10, 11, 1, 12, 13, 2, 14}));
+}
+
+CAF_TEST(blocking_with_lanes) {
+  queue_type q;
+  CAF_CHECK(q.try_block());
+  auto res = q.enqueue(new elem(1), 1);
+  CAF_CHECK(res == detail::enqueue_result::unblocked_reader);
+  CAF_CHECK(!q.blocked());
+  CAF_CHECK(q.can_fetch_more());
+  // an element in another lane prevents the reader from blocking
+  CAF_CHECK(!q.try_block());
+  CAF_CHECK_EQUAL(pop(q), 1);
+  CAF_CHECK(q.try_block());
+  CAF_CHECK(q.try_unblock());
+}
+
+CAF_TEST(closing_with_lanes) {
+  { // lifetime scope of q
+    queue_type q;
+    q.enqueue(new elem(1));
+    q.enqueue(new elem(2), 1);
+    q.enqueue(new elem(3), 1);
+    CAF_CHECK_EQUAL(pop(q), 2);
+    q.close();
+    auto res = q.enqueue(new elem(4), 1);
+    CAF_CHECK(res == detail::enqueue_result::queue_closed);
+  }
+  CAF_CHECK_EQUAL(s_elements, 0u);
+}
+
+CAF_TEST(high_priority_bypasses_backlog) {
+  actor_system_config cfg;
+  actor_system system{cfg};
+  scoped_actor self{system};
+  auto g = std::make_shared<gate>();
+  auto x = system.spawn<priority_aware>(counter, g, actor{self});
+  self->send(x, hold_atom::value);
+  g->await_entered();
+  for (int i = 0; i < 100000; ++i)
+    self->send(x, i);
+  self->send<message_priority::high>(x, ok_atom::value);
+  self->send(x, ok_atom::value);
+  g->release();
+  self->receive(
+    [](int count) {
+      CAF_CHECK_EQUAL(count, 0);
+    }
+  );
+  self->receive(
+    [](int count) {
+      CAF_CHECK_EQUAL(count, 100000);
+    }
+  );
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
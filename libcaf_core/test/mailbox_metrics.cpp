@@ -0,0 +1,180 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE mailbox_metrics
+#include "caf/test/unit_test.hpp"
+
+#include <mutex>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+using std::chrono::microseconds;
+
+namespace {
+
+using hold_atom = atom_constant<atom("hold")>;
+
+// keeps an actor busy until the test releases it
+struct gate {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool entered = false;
+  bool released = false;
+
+  void enter_and_wait() {
+    std::unique_lock<std::mutex> guard{mtx};
+    entered = true;
+    cv.notify_all();
+    cv.wait(guard, [&] { return released; });
+  }
+
+  void await_entered() {
+    std::unique_lock<std::mutex> guard{mtx};
+    cv.wait(guard, [&] { return entered; });
+  }
+
+  void release() {
+    std::unique_lock<std::mutex> guard{mtx};
+    released = true;
+    cv.notify_all();
+  }
+};
+
+behavior testee(event_based_actor*, std::shared_ptr<gate> g) {
+  return {
+    [=](hold_atom) {
+      g->enter_and_wait();
+    },
+    [=](int) {
+      // nop
+    },
+    [=](ok_atom) {
+      return ok_atom::value;
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(latency_buckets) {
+  auto bucket = [](int64_t us) {
+    return mailbox_metrics::bucket(microseconds(us));
+  };
+  CAF_CHECK_EQUAL(bucket(0), 0u);
+  CAF_CHECK_EQUAL(bucket(1), 1u);
+  CAF_CHECK_EQUAL(bucket(2), 2u);
+  CAF_CHECK_EQUAL(bucket(3), 2u);
+  CAF_CHECK_EQUAL(bucket(4), 3u);
+  CAF_CHECK_EQUAL(bucket(1000), 10u);
+  CAF_CHECK_EQUAL(bucket(int64_t{1} << 40), mailbox_stats::num_buckets - 1);
+  CAF_CHECK_EQUAL(mailbox_stats::upper_bound(0), 1u);
+  CAF_CHECK_EQUAL(mailbox_stats::upper_bound(10), 1024u);
+}
+
+CAF_TEST(depth_and_high_water_mark) {
+  auto x = make_counted<mailbox_metrics>(42);
+  for (int i = 0; i < 5; ++i)
+    x->enqueued();
+  x->dropped();
+  auto now = mailbox_metrics::clock_type::now();
+  x->dequeued(now);
+  x->dequeued(now);
+  x->enqueued();
+  auto stats = x->snapshot();
+  CAF_CHECK_EQUAL(stats.id, 42u);
+  CAF_CHECK_EQUAL(stats.depth, 3u);
+  CAF_CHECK_EQUAL(stats.high_water_mark, 5u);
+  CAF_CHECK_EQUAL(stats.dequeued, 2u);
+  // dequeued messages waited a few microseconds at most
+  CAF_CHECK_EQUAL(stats.latency[mailbox_stats::num_buckets - 1], 0u);
+}
+
+CAF_TEST(percentiles) {
+  mailbox_stats stats;
+  stats.latency.fill(0);
+  stats.dequeued = 0;
+  CAF_CHECK_EQUAL(stats.percentile(0.5), 0u);
+  stats.latency[1] = 90; // [1us, 2us)
+  stats.latency[5] = 9;  // [16us, 32us)
+  stats.latency[8] = 1;  // [128us, 256us)
+  stats.dequeued = 100;
+  CAF_CHECK_EQUAL(stats.percentile(0.5), 2u);
+  CAF_CHECK_EQUAL(stats.percentile(0.9), 2u);
+  CAF_CHECK_EQUAL(stats.percentile(0.99), 32u);
+  CAF_CHECK_EQUAL(stats.percentile(1.), 256u);
+}
+
+CAF_TEST(actor_metrics) {
+  actor_system_config cfg;
+  actor_system system{cfg};
+  scoped_actor self{system};
+  auto g = std::make_shared<gate>();
+  auto x = system.spawn(testee, g);
+  self->send(x, hold_atom::value);
+  g->await_entered();
+  for (int i = 0; i < 10; ++i)
+    self->send(x, i);
+#ifdef CAF_ENABLE_MAILBOX_METRICS
+  auto stats = system.mailbox_snapshot(x.id());
+  CAF_REQUIRE(stats);
+  CAF_CHECK_EQUAL(stats->depth, 10u);
+  CAF_CHECK_EQUAL(stats->dequeued, 1u);
+  g->release();
+  self->request(x, infinite, ok_atom::value).receive(
+    [](ok_atom) {
+      // nop
+    },
+    [](error& err) {
+      CAF_FAIL("unexpected error: " << to_string(err));
+    }
+  );
+  stats = system.mailbox_snapshot(x.id());
+  CAF_REQUIRE(stats);
+  CAF_CHECK_EQUAL(stats->depth, 0u);
+  // the request may arrive before the actor drained its mailbox
+  CAF_CHECK(stats->high_water_mark >= 10u);
+  CAF_CHECK_EQUAL(stats->dequeued, 12u);
+  auto all = system.mailbox_snapshot();
+  auto has_x = [&](const mailbox_stats& y) { return y.id == x.id(); };
+  CAF_CHECK(std::any_of(all.begin(), all.end(), has_x));
+  // terminated actors disappear from the registry
+  self->monitor(x);
+  anon_send_exit(x, exit_reason::user_shutdown);
+  self->receive(
+    [](const down_msg&) {
+      // nop
+    }
+  );
+  CAF_CHECK(!system.mailbox_snapshot(x.id()));
+#else
+  // without metrics, the actor system has no snapshots to offer
+  CAF_CHECK(!system.mailbox_snapshot(x.id()));
+  CAF_CHECK(system.mailbox_snapshot().empty());
+  g->release();
+  anon_send_exit(x, exit_reason::user_shutdown);
+#endif
+}
@@ -0,0 +1,228 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE memory_accounting
+#include "caf/test/unit_test.hpp"
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+using std::vector;
+
+namespace {
+
+using hold_atom = atom_constant<atom("hold")>;
+
+// keeps an actor busy until the test releases it
+struct gate {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool entered = false;
+  bool released = false;
+
+  void enter_and_wait() {
+    std::unique_lock<std::mutex> guard{mtx};
+    entered = true;
+    cv.notify_all();
+    cv.wait(guard, [&] { return released; });
+  }
+
+  void await_entered() {
+    std::unique_lock<std::mutex> guard{mtx};
+    cv.wait(guard, [&] { return entered; });
+  }
+
+  void release() {
+    std::unique_lock<std::mutex> guard{mtx};
+    released = true;
+    cv.notify_all();
+  }
+};
+
+struct collector_state {
+  vector<int> xs;
+};
+
+behavior collector(stateful_actor<collector_state>* self,
+                   std::shared_ptr<gate> g) {
+  return {
+    [=](hold_atom) {
+      g->enter_and_wait();
+    },
+    [=](int x) {
+      self->state.xs.push_back(x);
+    },
+    [=](get_atom) {
+      return self->state.xs;
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+  std::unique_ptr<actor_system> system;
+  std::unique_ptr<scoped_actor> self;
+
+  void start(size_t budget, atom_value policy) {
+    // each held collector occupies a worker
+    cfg.scheduler_max_threads = 4;
+    cfg.mailbox_memory_accounting = true;
+    cfg.mailbox_memory_budget = budget;
+    cfg.mailbox_budget_policy = policy;
+    system.reset(new actor_system(cfg));
+    self.reset(new scoped_actor(*system, true));
+  }
+
+  // spawns a collector and blocks it in its first message
+  actor spawn_held(std::shared_ptr<gate> g) {
+    auto x = system->spawn(collector, g);
+    (*self)->send(x, hold_atom::value);
+    g->await_entered();
+    return x;
+  }
+
+  // sends integers to `x` until the system exceeds its budget and returns
+  // the number of sent messages
+  size_t fill(const actor& x) {
+    size_t result = 0;
+    while (system->memory_in_use() <= system->config().mailbox_memory_budget) {
+      (*self)->send(x, 1);
+      ++result;
+    }
+    return result;
+  }
+
+  // waits until the system no longer exceeds its budget and returns all
+  // integers `x` received
+  vector<int> collected(const actor& x) {
+    auto budget = system->config().mailbox_memory_budget;
+    while (budget > 0 && system->memory_in_use() > budget)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    vector<int> result;
+    (*self)->request(x, infinite, get_atom::value).receive(
+      [&](vector<int>& xs) {
+        result = std::move(xs);
+      },
+      [&](error& err) {
+        CAF_FAIL("unexpected error: " << system->render(err));
+      }
+    );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST(disabled) {
+  actor_system_config cfg;
+  actor_system system{cfg};
+  auto x = system.spawn(collector, std::make_shared<gate>());
+  anon_send(x, 42);
+  CAF_CHECK(system.memory_top(10).empty());
+  CAF_CHECK(!system.memory_snapshot(x.id()));
+  CAF_CHECK_EQUAL(system.memory_in_use(), 0u);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE(memory_accounting_tests, fixture)
+
+CAF_TEST(top_n) {
+  start(0, atom("reject"));
+  vector<std::shared_ptr<gate>> gates;
+  vector<actor> xs;
+  for (int i = 0; i < 3; ++i) {
+    gates.emplace_back(std::make_shared<gate>());
+    xs.emplace_back(spawn_held(gates.back()));
+  }
+  // pending messages: xs[0] -> 1, xs[1] -> 10, xs[2] -> 5
+  int counts[] = {1, 10, 5};
+  for (size_t i = 0; i < xs.size(); ++i)
+    for (int j = 0; j < counts[i]; ++j)
+      (*self)->send(xs[i], j);
+  auto top = system->memory_top(2);
+  CAF_REQUIRE_EQUAL(top.size(), 2u);
+  CAF_CHECK_EQUAL(top[0].id, xs[1].id());
+  CAF_CHECK_EQUAL(top[1].id, xs[2].id());
+  CAF_CHECK(top[0].mailbox > top[1].mailbox);
+  CAF_CHECK_EQUAL(top[0].state, sizeof(collector_state));
+  // charges go away once the actors processed their messages
+  for (size_t i = 0; i < xs.size(); ++i) {
+    gates[i]->release();
+    CAF_CHECK_EQUAL(collected(xs[i]).size(), static_cast<size_t>(counts[i]));
+    auto stats = system->memory_snapshot(xs[i].id());
+    CAF_REQUIRE(stats);
+    CAF_CHECK_EQUAL(stats->mailbox, 0u);
+    anon_send_exit(xs[i], exit_reason::user_shutdown);
+  }
+}
+
+CAF_TEST(budget_reject) {
+  start(64 * 1024, atom("reject"));
+  auto g = std::make_shared<gate>();
+  auto x = spawn_held(g);
+  auto n = fill(x);
+  (*self)->request(x, infinite, 2).receive(
+    [&] {
+      CAF_FAIL("actor system exceeded its memory budget");
+    },
+    [&](error& err) {
+      CAF_CHECK_EQUAL(err, sec::memory_budget_exceeded);
+    }
+  );
+  g->release();
+  CAF_CHECK_EQUAL(collected(x).size(), n);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(budget_drop_newest) {
+  start(64 * 1024, atom("drop-new"));
+  auto g = std::make_shared<gate>();
+  auto x = spawn_held(g);
+  auto n = fill(x);
+  for (int i = 0; i < 10; ++i)
+    (*self)->send(x, 2);
+  g->release();
+  CAF_CHECK_EQUAL(collected(x), vector<int>(n, 1));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(budget_drop_oldest) {
+  start(64 * 1024, atom("drop-old"));
+  auto g = std::make_shared<gate>();
+  auto x = spawn_held(g);
+  auto n = fill(x);
+  for (int i = 0; i < 10; ++i)
+    (*self)->send(x, 2);
+  g->release();
+  auto xs = collected(x);
+  CAF_REQUIRE_EQUAL(xs.size(), n);
+  CAF_CHECK_EQUAL(vector<int>(xs.end() - 10, xs.end()), vector<int>(10, 2));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -258,3 +258,48 @@ CAF_TEST(arrays_to_string) {
   CAF_CHECK_EQUAL(to_string(msg2), "(((1, 10), (2, 20), (3, 30), (4, 40)))");
   CAF_CHECK_EQUAL(msg_as_string(s3{}), "((1, 2, 3, 4))");
 }
+
+CAF_TEST(small_messages_are_stored_inline) {
+  auto m1 = make_message(get_atom::value, 42);
+  CAF_CHECK(m1.cvals().is_inline());
+  CAF_CHECK(!m1.shared());
+  // copies of inline messages are independent
+  auto m2 = m1;
+  CAF_CHECK(m2.cvals().is_inline());
+  CAF_CHECK(!m1.shared() && !m2.shared());
+  m2.get_mutable_as<int>(1) = 23;
+  CAF_CHECK_EQUAL(m1.get_as<int>(1), 42);
+  CAF_CHECK_EQUAL(m2.get_as<int>(1), 23);
+  // moving an inline message leaves the source empty
+  auto m3 = std::move(m2);
+  CAF_CHECK(m2.empty());
+  CAF_CHECK_EQUAL(to_string(m3), "('get', 23)");
+  m3.swap(m1);
+  CAF_CHECK_EQUAL(m3.get_as<int>(1), 42);
+  CAF_CHECK_EQUAL(m1.get_as<int>(1), 23);
+  // messages built on top of inline messages
+  CAF_CHECK_EQUAL(to_string(m1 + m3), "('get', 23, 'get', 42)");
+  CAF_CHECK_EQUAL(to_string(m3.drop(1)), "(42)");
+}
+
+CAF_TEST(large_messages_share_content) {
+  auto m1 = make_message(string{"hello"});
+  CAF_CHECK(!m1.cvals().is_inline());
+  auto m2 = m1;
+  CAF_CHECK(m1.shared() && m2.shared());
+  m2.get_mutable_as<string>(0) = "world";
+  CAF_CHECK_EQUAL(m1.get_as<string>(0), "hello");
+  CAF_CHECK_EQUAL(m2.get_as<string>(0), "world");
+  auto m3 = make_message(1., 2., 3., 4., 5., 6., 7., 8.);
+  CAF_CHECK(!m3.cvals().is_inline());
+}
+
+CAF_TEST(releasing_inline_messages) {
+  auto m1 = make_message(1, 2);
+  auto ptr = m1.vals().release();
+  CAF_CHECK(m1.empty());
+  message m2;
+  m2.reset(ptr, false);
+  CAF_CHECK(!m2.cvals().is_inline());
+  CAF_CHECK_EQUAL(to_string(m2), "(1, 2)");
+}
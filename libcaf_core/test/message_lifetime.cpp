@@ -23,6 +23,7 @@
 #include "caf/test/unit_test.hpp"
 
 #include <atomic>
+#include <string>
 #include <iostream>
 
 #include "caf/all.hpp"
@@ -103,21 +104,33 @@ struct fixture {
 CAF_TEST_FIXTURE_SCOPE(message_lifetime_tests, fixture)
 
 CAF_TEST(message_lifetime_in_scoped_actor) {
-  auto msg = make_message(1, 2, 3);
+  // strings are not trivially copyable, i.e., messages share their content
+  auto msg = make_message(1, 2, std::string{"3"});
   scoped_actor self{system};
   self->send(self, msg);
   self->receive(
-    [&](int a, int b, int c) {
+    [&](int a, int b, const std::string& c) {
       CAF_CHECK_EQUAL(a, 1);
       CAF_CHECK_EQUAL(b, 2);
-      CAF_CHECK_EQUAL(c, 3);
+      CAF_CHECK_EQUAL(c, "3");
       CAF_CHECK_EQUAL(msg.cvals()->get_reference_count(), 2u);
     }
   );
   CAF_CHECK_EQUAL(msg.cvals()->get_reference_count(), 1u);
-  msg = make_message(42);
+  msg = make_message(std::string{"42"});
   self->send(self, msg);
   CAF_CHECK_EQUAL(msg.cvals()->get_reference_count(), 2u);
+  self->receive(
+    [&](std::string& value) {
+      CAF_CHECK_NOT_EQUAL(&value, msg.at(0));
+      value = "10";
+    }
+  );
+  CAF_CHECK_EQUAL(msg.get_as<std::string>(0), "42");
+  // small messages store their content inline and never share it
+  msg = make_message(42);
+  self->send(self, msg);
+  CAF_CHECK_EQUAL(msg.cvals()->get_reference_count(), 1u);
   self->receive(
     [&](int& value) {
       CAF_CHECK_NOT_EQUAL(&value, msg.at(0));
@@ -0,0 +1,144 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE monotonic_buffer_resource
+#include "caf/test/unit_test.hpp"
+
+#include <map>
+#include <vector>
+#include <cstdint>
+
+#include "caf/monotonic_buffer_resource.hpp"
+
+using namespace caf;
+
+namespace {
+
+// forwards to the default resource and counts pending blocks
+class counting_resource : public memory_resource {
+public:
+  size_t blocks = 0;
+  size_t bytes = 0;
+
+protected:
+  void* do_allocate(size_t n, size_t align) override {
+    ++blocks;
+    bytes += n;
+    return new_delete_resource()->allocate(n, align);
+  }
+
+  void do_deallocate(void* ptr, size_t n, size_t align) override {
+    --blocks;
+    bytes -= n;
+    new_delete_resource()->deallocate(ptr, n, align);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+bool aligned(void* ptr, size_t align) {
+  return reinterpret_cast<uintptr_t>(ptr) % align == 0;
+}
+
+struct fixture {
+  counting_resource upstream;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(monotonic_buffer_resource_tests, fixture)
+
+CAF_TEST(alignment) {
+  monotonic_buffer_resource res{64, &upstream};
+  CAF_CHECK_EQUAL(upstream.blocks, 0u);
+  CAF_CHECK(aligned(res.allocate(1, 1), 1));
+  CAF_CHECK(aligned(res.allocate(3, 4), 4));
+  CAF_CHECK(aligned(res.allocate(1, 1), 1));
+  CAF_CHECK(aligned(res.allocate(8, 8), 8));
+  CAF_CHECK(aligned(res.allocate(1, 1), 1));
+  CAF_CHECK(aligned(res.allocate(16, 64), 64));
+  CAF_CHECK_EQUAL(res.reserved(), upstream.bytes);
+}
+
+CAF_TEST(growth) {
+  monotonic_buffer_resource res{64, &upstream};
+  for (int i = 0; i < 100; ++i)
+    res.allocate(32);
+  // blocks grow geometrically
+  CAF_CHECK(upstream.blocks < 10);
+  CAF_CHECK_EQUAL(res.reserved(), upstream.bytes);
+  // requests beyond the next block size get a block of their own
+  res.allocate(100000);
+  CAF_CHECK(res.reserved() > 100000);
+  CAF_CHECK_EQUAL(res.reserved(), upstream.bytes);
+}
+
+CAF_TEST(reset_and_release) {
+  monotonic_buffer_resource res{64, &upstream};
+  for (int i = 0; i < 100; ++i)
+    res.allocate(32);
+  CAF_CHECK(upstream.blocks > 1);
+  // resets keep the largest block for the next round
+  res.reset();
+  CAF_CHECK_EQUAL(upstream.blocks, 1u);
+  CAF_CHECK_EQUAL(res.reserved(), upstream.bytes);
+  auto reserved = res.reserved();
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 10; ++i)
+      res.allocate(32);
+    res.reset();
+    CAF_CHECK_EQUAL(upstream.blocks, 1u);
+    CAF_CHECK_EQUAL(res.reserved(), reserved);
+  }
+  res.release();
+  CAF_CHECK_EQUAL(upstream.blocks, 0u);
+  CAF_CHECK_EQUAL(res.reserved(), 0u);
+  res.allocate(32);
+  CAF_CHECK_EQUAL(upstream.blocks, 1u);
+}
+
+CAF_TEST(allocator) {
+  using int_vector = std::vector<int, caf::polymorphic_allocator<int>>;
+  monotonic_buffer_resource res{64, &upstream};
+  int_vector xs{&res};
+  for (int i = 0; i < 100; ++i)
+    xs.push_back(i);
+  CAF_CHECK(xs.get_allocator().resource() == &res);
+  CAF_CHECK_EQUAL(res.reserved(), upstream.bytes);
+  CAF_CHECK(upstream.blocks > 0);
+  // copies do not depend on the lifetime of the arena
+  int_vector ys{xs};
+  CAF_CHECK(ys.get_allocator().resource() == new_delete_resource());
+  CAF_CHECK(xs == ys);
+  // node-based containers work as well
+  using int_map = std::map<int, int, std::less<int>,
+                           caf::polymorphic_allocator<std::pair<const int,
+                                                                int>>>;
+  int_map zs{&res};
+  for (int i = 0; i < 100; ++i)
+    zs.emplace(i, i);
+  CAF_CHECK_EQUAL(zs.size(), 100u);
+  CAF_CHECK_EQUAL(res.reserved(), upstream.bytes);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,118 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE mpmc_ring
+#include "caf/test/unit_test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/mpmc_ring.hpp"
+
+using namespace caf;
+
+using ring_type = detail::mpmc_ring<int>;
+
+namespace {
+
+behavior counter(event_based_actor* self, int remaining, actor listener) {
+  return {
+    [=](int) mutable {
+      if (--remaining == 0) {
+        self->send(listener, ok_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(fifo_order_and_bounds) {
+  ring_type ring{3};
+  CAF_CHECK_EQUAL(ring.capacity(), 4u);
+  CAF_CHECK_EQUAL(ring.pop(), nullptr);
+  int xs[] = {1, 2, 3, 4, 5};
+  for (int i = 0; i < 4; ++i)
+    CAF_CHECK(ring.push(&xs[i]));
+  CAF_CHECK(!ring.push(&xs[4]));
+  CAF_CHECK_EQUAL(*ring.pop(), 1);
+  CAF_CHECK(ring.push(&xs[4]));
+  for (int i = 2; i <= 5; ++i)
+    CAF_CHECK_EQUAL(*ring.pop(), i);
+  CAF_CHECK_EQUAL(ring.pop(), nullptr);
+}
+
+CAF_TEST(concurrent_producers_and_consumers) {
+  static constexpr int num_threads = 4;
+  static constexpr int num_items = 10000;
+  ring_type ring{64};
+  std::vector<int> items(num_threads * num_items, 1);
+  std::atomic<int> sum{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j < num_items; ++j)
+        while (!ring.push(&items[i * num_items + j]))
+          std::this_thread::yield();
+    });
+    threads.emplace_back([&] {
+      for (int j = 0; j < num_items; ++j) {
+        int* x;
+        while ((x = ring.pop()) == nullptr)
+          std::this_thread::yield();
+        sum += *x;
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  CAF_CHECK_EQUAL(sum.load(), num_threads * num_items);
+  CAF_CHECK_EQUAL(ring.pop(), nullptr);
+}
+
+CAF_TEST(lock_free_work_sharing_policy) {
+  static constexpr int num_actors = 100;
+  static constexpr int num_msgs = 100;
+  actor_system_config cfg;
+  cfg.scheduler_policy = atom("lf-share");
+  cfg.scheduler_max_threads = 4;
+  // force jobs into the overflow queue
+  cfg.work_sharing_queue_capacity = 8;
+  actor_system system{cfg};
+  scoped_actor self{system};
+  std::vector<actor> testees;
+  for (int i = 0; i < num_actors; ++i)
+    testees.push_back(system.spawn(counter, num_msgs, actor{self}));
+  for (int i = 0; i < num_msgs; ++i)
+    for (auto& testee : testees)
+      self->send(testee, i);
+  int received = 0;
+  self->receive_for(received, num_actors) (
+    [](ok_atom) {
+      // nop
+    }
+  );
+  CAF_CHECK_EQUAL(received, num_actors);
+}
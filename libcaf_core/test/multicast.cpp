@@ -0,0 +1,117 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE multicast
+#include "caf/test/unit_test.hpp"
+
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+using std::string;
+using std::vector;
+
+namespace {
+
+using ping_atom = atom_constant<atom("ping")>;
+
+// replies with the address of the received payload
+behavior receiver(event_based_actor* self, actor observer) {
+  return {
+    [=](const string& x) {
+      self->send(observer, reinterpret_cast<uint64_t>(&x));
+    },
+    [=](ping_atom) {
+      self->send(observer, uint64_t{0});
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+
+  // multicasts a string to `n` receivers and returns all reported addresses
+  std::multiset<uint64_t> multicast_to(size_t n, size_t num_detached) {
+    actor_system system{cfg};
+    scoped_actor self{system};
+    vector<actor> dests;
+    for (size_t i = 0; i < n; ++i)
+      dests.push_back(i < num_detached
+                      ? system.spawn<detached>(receiver, actor{self})
+                      : system.spawn(receiver, actor{self}));
+    // invalid handles are silently ignored
+    dests.push_back(actor{});
+    self->multicast(dests, make_message(string{"hello world"}));
+    std::multiset<uint64_t> result;
+    size_t i = 0;
+    self->receive_for(i, n)(
+      [&](uint64_t x) {
+        result.insert(x);
+      }
+    );
+    for (auto& dest : dests)
+      if (dest)
+        self->send_exit(dest, exit_reason::user_shutdown);
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(multicast_tests, fixture)
+
+CAF_TEST(receivers_share_the_payload) {
+  auto xs = multicast_to(100, 0);
+  CAF_CHECK_EQUAL(xs.size(), 100u);
+  CAF_CHECK_EQUAL(xs.count(*xs.begin()), 100u);
+}
+
+CAF_TEST(detached_receivers_share_the_payload) {
+  auto xs = multicast_to(20, 5);
+  CAF_CHECK_EQUAL(xs.size(), 20u);
+  CAF_CHECK_EQUAL(xs.count(*xs.begin()), 20u);
+}
+
+CAF_TEST(work_sharing_receivers_share_the_payload) {
+  cfg.scheduler_policy = atom("sharing");
+  auto xs = multicast_to(50, 0);
+  CAF_CHECK_EQUAL(xs.size(), 50u);
+  CAF_CHECK_EQUAL(xs.count(*xs.begin()), 50u);
+}
+
+CAF_TEST(multicast_to_nobody) {
+  actor_system system{cfg};
+  scoped_actor self{system};
+  self->multicast(vector<actor>{}, make_message(ping_atom::value));
+  auto dest = system.spawn(receiver, actor{self});
+  self->multicast(vector<actor>{dest}, make_message(ping_atom::value));
+  self->receive([](uint64_t x) {
+    CAF_CHECK_EQUAL(x, 0u);
+  });
+  self->send_exit(dest, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,125 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE scheduler_partition
+#include "caf/test/unit_test.hpp"
+
+#include <thread>
+
+#include "caf/all.hpp"
+
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+using namespace caf;
+
+namespace {
+
+using partition_atom = atom_constant<atom("partition")>;
+
+behavior reporter(event_based_actor* self) {
+  return {
+    [=](partition_atom) {
+      auto ptr = self->context()->partition();
+      return ptr != nullptr ? ptr->partition_name() : atom("default");
+    }
+  };
+}
+
+behavior forwarder(event_based_actor* self) {
+  auto child = self->spawn(reporter);
+  return {
+    [=](partition_atom x) {
+      return self->delegate(child, x);
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+
+  fixture() {
+    cfg.add_scheduler_partition(atom("latency"), 1)
+       .add_scheduler_partition(atom("bulk"), 2, atom("sharing"), 10);
+  }
+
+  atom_value partition_of(scoped_actor& self, const actor& whom) {
+    auto result = atom("");
+    self->request(whom, infinite, partition_atom::value).receive(
+      [&](atom_value x) {
+        result = x;
+      },
+      [&](error& err) {
+        CAF_FAIL("unexpected error: " << self->system().render(err));
+      }
+    );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(scheduler_partition_tests, fixture)
+
+CAF_TEST(partition_lookup) {
+  actor_system system{cfg};
+  auto latency = system.scheduler_partition(atom("latency"));
+  auto bulk = system.scheduler_partition(atom("bulk"));
+  CAF_REQUIRE(latency != nullptr);
+  CAF_REQUIRE(bulk != nullptr);
+  CAF_CHECK(latency != bulk);
+  CAF_CHECK(latency->is_partition());
+  CAF_CHECK(!system.scheduler().is_partition());
+  CAF_CHECK_EQUAL(latency->num_workers(), 1u);
+  CAF_CHECK_EQUAL(bulk->num_workers(), 2u);
+  CAF_CHECK_EQUAL(bulk->max_throughput(), 10u);
+  CAF_CHECK(system.scheduler_partition(atom("unknown")) == nullptr);
+}
+
+CAF_TEST(actors_run_in_their_partition) {
+  actor_system system{cfg};
+  scoped_actor self{system};
+  auto x = system.spawn_in_partition(atom("latency"), reporter);
+  auto y = system.spawn_in_partition(atom("bulk"), reporter);
+  auto z = system.spawn(reporter);
+  // repeat to cover wakeups from scoped actors and from other partitions
+  for (int i = 0; i < 10; ++i) {
+    CAF_CHECK_EQUAL(partition_of(self, x), atom("latency"));
+    CAF_CHECK_EQUAL(partition_of(self, y), atom("bulk"));
+    CAF_CHECK_EQUAL(partition_of(self, z), atom("default"));
+  }
+  // unknown partitions fall back to the default scheduler
+  auto w = system.spawn_in_partition(atom("unknown"), reporter);
+  CAF_CHECK_EQUAL(partition_of(self, w), atom("default"));
+  self->send_exit(x, exit_reason::user_shutdown);
+  self->send_exit(y, exit_reason::user_shutdown);
+  self->send_exit(z, exit_reason::user_shutdown);
+  self->send_exit(w, exit_reason::user_shutdown);
+}
+
+CAF_TEST(children_default_to_the_default_scheduler) {
+  actor_system system{cfg};
+  scoped_actor self{system};
+  auto x = system.spawn_in_partition(atom("latency"), forwarder);
+  CAF_CHECK_EQUAL(partition_of(self, x), atom("default"));
+  self->send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
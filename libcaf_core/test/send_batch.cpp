@@ -0,0 +1,252 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE send_batch
+#include "caf/test/unit_test.hpp"
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <condition_variable>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/single_reader_queue.hpp"
+
+using namespace caf;
+
+using std::vector;
+
+namespace {
+
+using hold_atom = atom_constant<atom("hold")>;
+
+struct elem {
+  elem* next;
+  elem* prev;
+  int value;
+
+  explicit elem(int x = 0) : next(nullptr), prev(nullptr), value(x) {
+    // nop
+  }
+};
+
+using queue_type = detail::single_reader_queue<elem>;
+
+// links `[from, to)` from newest to oldest and returns first and last
+std::pair<elem*, elem*> make_chain(int from, int to) {
+  elem* first = nullptr;
+  elem* last = nullptr;
+  for (int i = from; i < to; ++i) {
+    auto x = new elem(i);
+    x->next = first;
+    first = x;
+    if (last == nullptr)
+      last = x;
+  }
+  return {first, last};
+}
+
+vector<int> drain(queue_type& q) {
+  vector<int> result;
+  for (std::unique_ptr<elem> x{q.try_pop()}; x; x.reset(q.try_pop()))
+    result.push_back(x->value);
+  return result;
+}
+
+vector<message> make_batch(int from, int to) {
+  vector<message> result;
+  for (int i = from; i < to; ++i)
+    result.push_back(make_message(i));
+  return result;
+}
+
+// keeps an actor busy until the test releases it
+struct gate {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool entered = false;
+  bool released = false;
+
+  void enter_and_wait() {
+    std::unique_lock<std::mutex> guard{mtx};
+    entered = true;
+    cv.notify_all();
+    cv.wait(guard, [&] { return released; });
+  }
+
+  void await_entered() {
+    std::unique_lock<std::mutex> guard{mtx};
+    cv.wait(guard, [&] { return entered; });
+  }
+
+  void release() {
+    std::unique_lock<std::mutex> guard{mtx};
+    released = true;
+    cv.notify_all();
+  }
+};
+
+behavior collector(event_based_actor* self, std::shared_ptr<gate> g,
+                   actor observer) {
+  return {
+    [=](hold_atom) {
+      g->enter_and_wait();
+    },
+    [=](int x) {
+      self->send(observer, x);
+    }
+  };
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system system;
+  scoped_actor self;
+
+  fixture() : system(cfg), self(system, true) {
+    // nop
+  }
+
+  // returns all integers the collector forwards within 100ms
+  vector<int> collected() {
+    vector<int> result;
+    bool done = false;
+    while (!done)
+      self->receive(
+        [&](int x) {
+          result.push_back(x);
+        },
+        after(std::chrono::milliseconds(100)) >> [&] {
+          done = true;
+        }
+      );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST(batches_preserve_order) {
+  queue_type q;
+  CAF_REQUIRE(q.enqueue(new elem(0)) != detail::enqueue_result::queue_full);
+  auto chain = make_chain(1, 5);
+  CAF_CHECK_EQUAL(q.enqueue_batch(chain.first, chain.second, 4),
+                  detail::enqueue_result::success);
+  CAF_REQUIRE(q.enqueue(new elem(5)) != detail::enqueue_result::queue_full);
+  CAF_CHECK_EQUAL(drain(q), vector<int>({0, 1, 2, 3, 4, 5}));
+}
+
+CAF_TEST(batches_unblock_reader_once) {
+  queue_type q;
+  CAF_REQUIRE(q.try_block());
+  auto chain = make_chain(0, 3);
+  CAF_CHECK_EQUAL(q.enqueue_batch(chain.first, chain.second, 3),
+                  detail::enqueue_result::unblocked_reader);
+  chain = make_chain(3, 6);
+  CAF_CHECK_EQUAL(q.enqueue_batch(chain.first, chain.second, 3),
+                  detail::enqueue_result::success);
+  CAF_CHECK_EQUAL(drain(q), vector<int>({0, 1, 2, 3, 4, 5}));
+}
+
+CAF_TEST(bounded_queues_reject_oversized_batches) {
+  queue_type q;
+  q.capacity(4);
+  auto chain = make_chain(0, 3);
+  CAF_CHECK_EQUAL(q.enqueue_batch(chain.first, chain.second, 3),
+                  detail::enqueue_result::success);
+  chain = make_chain(3, 5);
+  CAF_CHECK_EQUAL(q.enqueue_batch(chain.first, chain.second, 2),
+                  detail::enqueue_result::queue_full);
+  CAF_CHECK_EQUAL(q.size(), 3u);
+  // the caller keeps ownership of rejected batches
+  for (auto i = chain.first; i != nullptr;) {
+    std::unique_ptr<elem> x{i};
+    i = i->next;
+  }
+  CAF_CHECK_EQUAL(drain(q), vector<int>({0, 1, 2}));
+}
+
+CAF_TEST(closed_queues_return_batches) {
+  queue_type q;
+  q.close();
+  auto chain = make_chain(0, 2);
+  CAF_CHECK_EQUAL(q.enqueue_batch(chain.first, chain.second, 2),
+                  detail::enqueue_result::queue_closed);
+  std::unique_ptr<elem> x{chain.first};
+  std::unique_ptr<elem> y{chain.second};
+}
+
+CAF_TEST_FIXTURE_SCOPE(send_batch_tests, fixture)
+
+CAF_TEST(send_batch_to_event_based_actor) {
+  auto g = std::make_shared<gate>();
+  auto x = system.spawn(collector, g, actor{self});
+  self->send(x, hold_atom::value);
+  g->await_entered();
+  self->send_batch(x, make_batch(0, 1000));
+  self->send(x, 1000);
+  g->release();
+  vector<int> expected;
+  for (int i = 0; i <= 1000; ++i)
+    expected.push_back(i);
+  CAF_CHECK_EQUAL(collected(), expected);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(anon_send_batch_to_blocking_actor) {
+  scoped_actor other{system};
+  anon_send_batch(actor{other}, make_batch(0, 10));
+  vector<int> result;
+  size_t i = 0;
+  other->receive_for(i, size_t{10})(
+    [&](int x) {
+      result.push_back(x);
+    }
+  );
+  CAF_CHECK_EQUAL(result, vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+CAF_TEST(bounded_mailboxes_apply_overflow_policy) {
+  auto g = std::make_shared<gate>();
+  auto x = system.spawn_bounded(3, overflow_policy::drop_newest, collector, g,
+                                actor{self});
+  self->send(x, hold_atom::value);
+  g->await_entered();
+  self->send_batch(x, make_batch(0, 5));
+  g->release();
+  CAF_CHECK_EQUAL(collected(), vector<int>({0, 1, 2}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(high_priority_batches_use_their_own_lane) {
+  auto g = std::make_shared<gate>();
+  auto x = system.spawn<priority_aware>(collector, g, actor{self});
+  self->send(x, hold_atom::value);
+  g->await_entered();
+  self->send_batch(x, make_batch(0, 3));
+  self->send_batch<message_priority::high>(x, make_batch(3, 6));
+  g->release();
+  CAF_CHECK_EQUAL(collected(), vector<int>({3, 4, 5, 0, 1, 2}));
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,125 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE slab_allocator
+#include "caf/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/memory.hpp"
+
+using namespace caf;
+
+using detail::memory;
+using detail::slab_stats;
+
+namespace {
+
+constexpr size_t obj_size = 500;
+
+const slab_stats& class_of(const std::vector<slab_stats>& xs, size_t size) {
+  for (auto& x : xs)
+    if (x.size >= size)
+      return x;
+  CAF_FAIL("no size class for " << size);
+  return xs.back();
+}
+
+uint64_t total_allocations() {
+  uint64_t result = 0;
+  for (auto& x : memory::stats())
+    result += x.allocations;
+  return result;
+}
+
+std::vector<void*> allocate_n(size_t n) {
+  std::vector<void*> result;
+  for (size_t i = 0; i < n; ++i)
+    result.push_back(memory::allocate(obj_size));
+  return result;
+}
+
+void deallocate_all(const std::vector<void*>& xs) {
+  for (auto x : xs)
+    memory::deallocate(x, obj_size);
+}
+
+} // namespace <anonymous>
+
+#ifndef CAF_NO_MEM_MANAGEMENT
+
+CAF_TEST(size_classes) {
+  auto xs = memory::stats();
+  CAF_REQUIRE(!xs.empty());
+  CAF_CHECK_EQUAL(xs.back().size, memory::max_slab_size);
+  CAF_CHECK_EQUAL(class_of(xs, 1).size, 16u);
+  CAF_CHECK_EQUAL(class_of(xs, 100).size, 112u);
+  CAF_CHECK_EQUAL(class_of(xs, 129).size, 160u);
+  CAF_CHECK_EQUAL(class_of(xs, obj_size).size, 512u);
+}
+
+CAF_TEST(counters) {
+  auto before = class_of(memory::stats(), obj_size);
+  deallocate_all(allocate_n(10));
+  auto after = class_of(memory::stats(), obj_size);
+  CAF_CHECK_EQUAL(after.allocations - before.allocations, 10u);
+  CAF_CHECK_EQUAL(after.deallocations - before.deallocations, 10u);
+}
+
+CAF_TEST(local_reuse) {
+  auto x = memory::allocate(obj_size);
+  memory::deallocate(x, obj_size);
+  auto y = memory::allocate(obj_size);
+  CAF_CHECK_EQUAL(x, y);
+  memory::deallocate(y, obj_size);
+}
+
+CAF_TEST(cross_thread_reuse) {
+  constexpr size_t n = 1000;
+  std::vector<void*> xs;
+  // producer and consumer run on different threads
+  std::thread{[&] { xs = allocate_n(n); }}.join();
+  std::thread{[&] { deallocate_all(xs); }}.join();
+  auto reserved = class_of(memory::stats(), obj_size).reserved;
+  // a new producer picks up the storage released by the consumer
+  std::thread{[&] { xs = allocate_n(n); }}.join();
+  CAF_CHECK_EQUAL(class_of(memory::stats(), obj_size).reserved, reserved);
+  deallocate_all(xs);
+}
+
+CAF_TEST(mailbox_elements) {
+  auto before = total_allocations();
+  auto x = make_mailbox_element(nullptr, message_id::make(), {},
+                                make_message(1, 2, 3));
+  x.reset();
+  CAF_CHECK_GREATER_EQUAL(total_allocations() - before, 1u);
+}
+
+#endif // CAF_NO_MEM_MANAGEMENT
+
+CAF_TEST(oversized_objects) {
+  auto x = memory::allocate(memory::max_slab_size + 1);
+  CAF_CHECK(x != nullptr);
+  memory::deallocate(x, memory::max_slab_size + 1);
+}
@@ -0,0 +1,131 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE spawn_n
+#include "caf/test/unit_test.hpp"
+
+#include <set>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+using get_atom = atom_constant<atom("get")>;
+
+class worker : public event_based_actor {
+public:
+  worker(actor_config& cfg, int x) : event_based_actor(cfg), x_(x) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return {
+      [=](get_atom) {
+        return make_message(id(), x_);
+      }
+    };
+  }
+
+private:
+  int x_;
+};
+
+using pool_type = actor_storage<worker>;
+
+// waits up to one second for the pool to cache at least `n` blocks
+bool await_cached(size_t n) {
+  for (int i = 0; i < 100; ++i) {
+    if (pool_type::pool().cached() >= n)
+      return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system system;
+
+  fixture() : system(cfg) {
+    // nop
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(spawn_n_tests, fixture)
+
+CAF_TEST(spawn_n_initializes_all_actors) {
+  auto xs = system.spawn_n<worker>(50, 42);
+  CAF_REQUIRE_EQUAL(xs.size(), 50u);
+  std::set<actor_id> ids;
+  { // lifetime scope of self
+    scoped_actor self{system};
+    for (auto& x : xs)
+      self->request(x, infinite, get_atom::value).receive(
+        [&](actor_id id, int value) {
+          CAF_CHECK_EQUAL(id, x.id());
+          CAF_CHECK_EQUAL(value, 42);
+          ids.insert(id);
+        },
+        [&](error& err) {
+          CAF_FAIL("unexpected error: " << system.render(err));
+        }
+      );
+  }
+  CAF_CHECK_EQUAL(ids.size(), 50u);
+  // spawn_n reserves consecutive IDs
+  CAF_CHECK_EQUAL(*ids.rbegin() - *ids.begin(), 49u);
+  for (auto& x : xs)
+    anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(spawn_n_with_zero_actors) {
+  CAF_CHECK(system.spawn_n<worker>(0, 1).empty());
+}
+
+#ifndef CAF_NO_MEM_MANAGEMENT
+
+CAF_TEST(storage_gets_recycled) {
+  auto xs = system.spawn_n<worker>(20, 1);
+  for (auto& x : xs)
+    anon_send_exit(x, exit_reason::user_shutdown);
+  xs.clear();
+  system.await_all_actors_done();
+  CAF_REQUIRE(await_cached(20));
+  auto before = pool_type::pool().cached();
+  auto ys = system.spawn_n<worker>(10, 2);
+  CAF_CHECK_EQUAL(pool_type::pool().cached(), before - 10);
+  auto y = system.spawn<worker>(3);
+  CAF_CHECK_EQUAL(pool_type::pool().cached(), before - 11);
+  for (auto& x : ys)
+    anon_send_exit(x, exit_reason::user_shutdown);
+  anon_send_exit(y, exit_reason::user_shutdown);
+}
+
+#endif // CAF_NO_MEM_MANAGEMENT
+
+CAF_TEST_FIXTURE_SCOPE_END()
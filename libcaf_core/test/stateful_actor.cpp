@@ -22,6 +22,8 @@
 #define CAF_SUITE stateful_actor
 #include "caf/test/unit_test.hpp"
 
+#include <numeric>
+
 #include "caf/all.hpp"
 
 #define ERROR_HANDLER                                                          \
@@ -87,6 +89,46 @@ public:
   }
 };
 
+// stores its values in the arena of its actor
+struct arena_state {
+  using allocator_type = polymorphic_allocator<int>;
+
+  std::vector<int, allocator_type> xs;
+  local_actor* self;
+
+  arena_state(local_actor* ptr, const allocator_type& alloc)
+      : xs(alloc),
+        self(ptr) {
+    // nop
+  }
+};
+
+behavior arena_collector(stateful_actor<arena_state>* self) {
+  return {
+    [=](add_atom, int x) {
+      self->state.xs.push_back(x);
+    },
+    [=](get_atom) {
+      auto& xs = self->state.xs;
+      auto in_arena = xs.get_allocator().resource() == &self->arena();
+      return make_message(in_arena, vector<int>(xs.begin(), xs.end()));
+    }
+  };
+}
+
+// sums up 1..n using scratch memory from the arena and responds with the
+// bytes the arena holds
+behavior scratch_summer(stateful_actor<counter>* self) {
+  self->reset_arena_after_message(true);
+  return [=](int n) {
+    vector<int, polymorphic_allocator<int>> xs{self->arena_allocator<int>()};
+    for (int i = 1; i <= n; ++i)
+      xs.push_back(i);
+    self->state.value = std::accumulate(xs.begin(), xs.end(), 0);
+    return self->arena().reserved();
+  };
+}
+
 struct fixture {
   actor_system_config cfg;
   actor_system system;
@@ -169,4 +211,38 @@ CAF_TEST(string_name) {
   test_name<state>("testee2");
 }
 
+CAF_TEST(state_in_arena) {
+  scoped_actor self{system};
+  auto aut = system.spawn(arena_collector);
+  for (auto x : {7, 4, 9})
+    self->send(aut, add_atom::value, x);
+  self->request(aut, infinite, get_atom::value).receive(
+    [](bool in_arena, const vector<int>& xs) {
+      CAF_CHECK(in_arena);
+      CAF_CHECK_EQUAL(xs, vector<int>({7, 4, 9}));
+    },
+    ERROR_HANDLER
+  );
+  anon_send_exit(aut, exit_reason::user_shutdown);
+}
+
+CAF_TEST(arena_reset_after_message) {
+  scoped_actor self{system};
+  auto aut = system.spawn(scratch_summer);
+  vector<size_t> reserved;
+  for (int i = 0; i < 5; ++i)
+    self->request(aut, infinite, 1000).receive(
+      [&](size_t x) {
+        reserved.push_back(x);
+      },
+      ERROR_HANDLER
+    );
+  // the arena keeps its largest block after each message and eventually
+  // serves all scratch memory from it
+  CAF_REQUIRE_EQUAL(reserved.size(), 5u);
+  CAF_CHECK(reserved[0] >= 1000 * sizeof(int));
+  CAF_CHECK_EQUAL(reserved[3], reserved[4]);
+  anon_send_exit(aut, exit_reason::user_shutdown);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,188 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE timing_wheel
+#include "caf/test/unit_test.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/timing_wheel.hpp"
+
+using namespace caf;
+
+using detail::timing_wheel;
+using detail::timing_wheel_entry;
+
+namespace {
+
+struct entry : timing_wheel_entry {
+  int id = 0;
+  uint64_t fired_at = timing_wheel::never;
+};
+
+struct fixture {
+  timing_wheel wheel;
+  std::vector<int> fired;
+
+  void advance(uint64_t t) {
+    wheel.advance(t, [&](timing_wheel_entry* ptr) {
+      auto x = static_cast<entry*>(ptr);
+      x->fired_at = t;
+      fired.push_back(x->id);
+    });
+  }
+};
+
+using steady = std::chrono::steady_clock;
+
+using fire_atom = atom_constant<atom("fire")>;
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(timing_wheel_tests, fixture)
+
+CAF_TEST(entries_expire_at_their_deadline) {
+  // cover all levels as well as the overflow list
+  std::vector<uint64_t> deadlines{1, 2, 255, 256, 257, 1000, 65535, 65536,
+                                  70000, 1u << 24, (1u << 24) + 1,
+                                  uint64_t{1} << 32, (uint64_t{1} << 32) + 3,
+                                  uint64_t{1} << 40};
+  std::vector<entry> xs(deadlines.size());
+  for (size_t i = 0; i < xs.size(); ++i) {
+    xs[i].id = static_cast<int>(i);
+    wheel.schedule(&xs[i], deadlines[i]);
+  }
+  CAF_CHECK_EQUAL(wheel.size(), xs.size());
+  // advance exactly to each deadline and check that only one entry expires
+  for (size_t i = 0; i < xs.size(); ++i) {
+    advance(deadlines[i] - 1);
+    CAF_CHECK_EQUAL(fired.size(), i);
+    CAF_CHECK(wheel.next_expiry() <= deadlines[i]);
+    advance(deadlines[i]);
+    CAF_REQUIRE_EQUAL(fired.size(), i + 1);
+    CAF_CHECK_EQUAL(fired.back(), static_cast<int>(i));
+    CAF_CHECK(!xs[i].scheduled());
+  }
+  CAF_CHECK(wheel.empty());
+  CAF_CHECK_EQUAL(wheel.next_expiry(), timing_wheel::never);
+}
+
+CAF_TEST(equal_deadlines_expire_in_insertion_order) {
+  std::vector<entry> xs(10);
+  // schedule half of the entries from a later tick, which puts them on a
+  // finer level than the first half
+  for (size_t i = 0; i < xs.size(); ++i) {
+    xs[i].id = static_cast<int>(i);
+    if (i == xs.size() / 2)
+      advance(300);
+    wheel.schedule(&xs[i], 1000);
+  }
+  advance(999);
+  CAF_CHECK(fired.empty());
+  CAF_CHECK_EQUAL(wheel.next_expiry(), 1000u);
+  advance(5000);
+  CAF_CHECK_EQUAL(fired, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+CAF_TEST(past_deadlines_expire_on_next_advance) {
+  entry x;
+  advance(100);
+  wheel.schedule(&x, 50);
+  CAF_CHECK_EQUAL(wheel.next_expiry(), 100u);
+  advance(100);
+  CAF_CHECK_EQUAL(x.fired_at, 100u);
+}
+
+CAF_TEST(canceled_entries_never_expire) {
+  std::vector<entry> xs(3);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    xs[i].id = static_cast<int>(i);
+    wheel.schedule(&xs[i], 10 + i);
+  }
+  wheel.cancel(&xs[1]);
+  CAF_CHECK(!xs[1].scheduled());
+  CAF_CHECK_EQUAL(wheel.size(), 2u);
+  advance(100);
+  CAF_CHECK_EQUAL(fired, std::vector<int>({0, 2}));
+}
+
+CAF_TEST(random_deadlines_and_steps) {
+  std::minstd_rand rng{42};
+  std::uniform_int_distribution<uint64_t> deadline{0, 1u << 20};
+  std::uniform_int_distribution<uint64_t> step{0, 5000};
+  std::vector<entry> xs(10000);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    xs[i].id = static_cast<int>(i);
+    wheel.schedule(&xs[i], deadline(rng));
+  }
+  // cancel every 10th entry
+  for (size_t i = 0; i < xs.size(); i += 10)
+    wheel.cancel(&xs[i]);
+  std::vector<uint64_t> steps;
+  uint64_t t = 0;
+  while (!wheel.empty()) {
+    t += step(rng);
+    steps.push_back(t);
+    advance(t);
+  }
+  CAF_CHECK_EQUAL(fired.size(), xs.size() - xs.size() / 10);
+  // each entry expires in the first step reaching its deadline
+  size_t errors = 0;
+  uint64_t last_deadline = 0;
+  for (auto id : fired) {
+    auto& x = xs[static_cast<size_t>(id)];
+    auto i = std::lower_bound(steps.begin(), steps.end(), x.deadline());
+    if (i == steps.end() || *i != x.fired_at || x.deadline() < last_deadline)
+      ++errors;
+    last_deadline = x.deadline();
+  }
+  CAF_CHECK_EQUAL(errors, 0u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(delayed_messages_arrive_in_order_and_never_early) {
+  actor_system_config cfg;
+  actor_system system{cfg};
+  scoped_actor self{system};
+  auto t0 = steady::now();
+  // schedule in reverse order of delivery
+  for (int i = 10; i > 0; --i)
+    self->delayed_send(self, std::chrono::milliseconds(i * 5), fire_atom::value,
+                       i);
+  // equal deadlines preserve the order of sending
+  for (int i = 11; i <= 20; ++i)
+    self->delayed_send(self, std::chrono::milliseconds(60), fire_atom::value,
+                       i);
+  int expected = 1;
+  self->receive_for(expected, 21) (
+    [&](fire_atom, int x) {
+      CAF_CHECK_EQUAL(x, expected);
+      auto delay = x <= 10 ? x * 5 : 60;
+      CAF_CHECK(steady::now() - t0 >= std::chrono::milliseconds(delay));
+    }
+  );
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE work_stealing
+#include "caf/test/unit_test.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/double_ended_queue.hpp"
+
+#include "caf/policy/lock_free_work_stealing.hpp"
+
+using namespace caf;
+
+namespace {
+
+using ping_atom = atom_constant<atom("ping")>;
+
+// passes a ping back and forth with its buddy until `done` becomes true
+behavior player(event_based_actor* self, std::atomic<bool>* done,
+                std::atomic<size_t>* rounds) {
+  return {
+    [=](ping_atom, const actor& buddy) {
+      ++*rounds;
+      if (*done) {
+        self->send_exit(buddy, exit_reason::user_shutdown);
+        self->quit();
+        return;
+      }
+      self->send(buddy, ping_atom::value, actor_cast<actor>(self));
+    }
+  };
+}
+
+struct fixture {
+  std::atomic<bool> done{false};
+  std::atomic<size_t> rounds{0};
+
+  // starts an endless ping-pong between two actors, then spawns an actor that
+  // ends it, which only works if the worker eventually runs other jobs
+  void play_until_done(actor_system_config& cfg) {
+    actor_system sys{cfg};
+    auto a = sys.spawn(player, &done, &rounds);
+    auto b = sys.spawn(player, &done, &rounds);
+    anon_send(a, ping_atom::value, b);
+    sys.spawn([=] {
+      done = true;
+    });
+    sys.await_all_actors_done();
+    CAF_CHECK(done);
+    CAF_MESSAGE("rounds: " << rounds);
+  }
+};
+
+// fills `q` with the elements of `xs` and then steals half of them
+template <class Queue>
+std::vector<int> steal_half_of(Queue& q, std::vector<int>& xs) {
+  for (auto& x : xs)
+    q.append(reinterpret_cast<resumable*>(&x));
+  std::vector<resumable*> stolen;
+  std::vector<int> result;
+  CAF_CHECK_EQUAL(q.take_tail_half(stolen), (xs.size() + 1) / 2);
+  for (auto ptr : stolen)
+    result.push_back(*reinterpret_cast<int*>(ptr));
+  return result;
+}
+
+// spawns `n` actors that increment `count` from within an actor
+void spawn_burst(actor_system& sys, int n, std::atomic<int>* count) {
+  sys.spawn([=](event_based_actor* self) {
+    for (int i = 0; i < n; ++i)
+      self->spawn([=] { ++*count; });
+  });
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(take_tail_half) {
+  using ivec = std::vector<int>;
+  ivec xs{1, 2, 3, 4, 5};
+  detail::double_ended_queue<resumable> q1;
+  CAF_CHECK_EQUAL(steal_half_of(q1, xs), (ivec{3, 4, 5}));
+  CAF_CHECK_EQUAL(*reinterpret_cast<int*>(q1.take_head()), 1);
+  CAF_CHECK_EQUAL(*reinterpret_cast<int*>(q1.take_tail()), 2);
+  CAF_CHECK(q1.empty());
+  // jobs in the inbox of the lock-free queue
+  policy::lock_free_work_stealing::queue_type q2;
+  CAF_CHECK_EQUAL(steal_half_of(q2, xs), (ivec{3, 4, 5}));
+  // jobs in the deque of the lock-free queue
+  q2.claim();
+  CAF_CHECK_EQUAL(*reinterpret_cast<int*>(q2.take_head()), 1);
+  for (auto& x : xs)
+    q2.prepend(reinterpret_cast<resumable*>(&x));
+  std::vector<resumable*> stolen;
+  CAF_CHECK_EQUAL(q2.take_tail_half(stolen), 3u);
+  CAF_CHECK_EQUAL(*reinterpret_cast<int*>(stolen.front()), 2);
+}
+
+CAF_TEST(steal_half) {
+  static constexpr int num_actors = 1000;
+  for (auto policy : {atom("stealing"), atom("lf-steal")}) {
+    actor_system_config cfg;
+    cfg.scheduler_policy = policy;
+    cfg.scheduler_max_threads = 4;
+    cfg.work_stealing_steal_half = true;
+    std::atomic<int> count{0};
+    { // lifetime scope of sys
+      actor_system sys{cfg};
+      spawn_burst(sys, num_actors, &count);
+    }
+    CAF_CHECK_EQUAL(count.load(), num_actors);
+  }
+}
+
+CAF_TEST_FIXTURE_SCOPE(work_stealing_tests, fixture)
+
+CAF_TEST(run_next_respects_limit) {
+  for (auto policy : {atom("stealing"), atom("lf-steal")}) {
+    actor_system_config cfg;
+    cfg.scheduler_policy = policy;
+    cfg.scheduler_max_threads = 1;
+    cfg.work_stealing_run_next_limit = 4;
+    done = false;
+    play_until_done(cfg);
+  }
+}
+
+CAF_TEST(run_next_with_multiple_workers) {
+  actor_system_config cfg;
+  cfg.scheduler_max_threads = 4;
+  play_until_done(cfg);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,154 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE work_stealing_deque
+#include "caf/test/unit_test.hpp"
+
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/work_stealing_deque.hpp"
+
+using namespace caf;
+
+using queue_type = detail::work_stealing_deque<int>;
+
+namespace {
+
+struct config : actor_system_config {
+  config() {
+    scheduler_policy = atom("lf-steal");
+    scheduler_max_threads = 4;
+  }
+};
+
+behavior counter(event_based_actor* self, int remaining, actor listener) {
+  return {
+    [=](int) mutable {
+      if (--remaining == 0) {
+        self->send(listener, ok_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(owner_lifo_thief_fifo) {
+  int xs[] = {1, 2, 3, 4};
+  queue_type q;
+  CAF_CHECK(q.empty());
+  CAF_CHECK_EQUAL(q.take(), nullptr);
+  CAF_CHECK_EQUAL(q.steal(), nullptr);
+  for (auto& x : xs)
+    q.push(&x);
+  CAF_CHECK_EQUAL(q.size(), 4u);
+  CAF_CHECK_EQUAL(q.steal(), &xs[0]);
+  CAF_CHECK_EQUAL(q.take(), &xs[3]);
+  CAF_CHECK_EQUAL(q.steal(), &xs[1]);
+  CAF_CHECK_EQUAL(q.take(), &xs[2]);
+  CAF_CHECK(q.empty());
+  CAF_CHECK_EQUAL(q.take(), nullptr);
+  CAF_CHECK_EQUAL(q.steal(), nullptr);
+}
+
+CAF_TEST(growing) {
+  std::vector<int> xs(100);
+  queue_type q{4};
+  CAF_CHECK_EQUAL(q.capacity(), 4u);
+  for (auto& x : xs)
+    q.push(&x);
+  CAF_CHECK_EQUAL(q.size(), xs.size());
+  CAF_CHECK_EQUAL(q.capacity(), 128u);
+  for (auto i = xs.rbegin(); i != xs.rend(); ++i)
+    CAF_CHECK_EQUAL(q.take(), &*i);
+  CAF_CHECK(q.empty());
+}
+
+CAF_TEST(concurrent_stealing) {
+  static constexpr size_t num_jobs = 100000;
+  static constexpr size_t num_thieves = 3;
+  std::vector<int> xs(num_jobs);
+  std::vector<std::atomic<int>> taken(num_jobs);
+  for (auto& x : taken)
+    x = 0;
+  queue_type q{16};
+  std::atomic<size_t> consumed{0};
+  auto consume = [&](int* ptr) {
+    ++taken[static_cast<size_t>(ptr - xs.data())];
+    ++consumed;
+  };
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < num_thieves; ++i)
+    thieves.emplace_back([&] {
+      while (consumed < num_jobs) {
+        auto ptr = q.steal();
+        if (ptr != nullptr)
+          consume(ptr);
+        else
+          std::this_thread::yield();
+      }
+    });
+  for (size_t i = 0; i < num_jobs; ++i) {
+    q.push(&xs[i]);
+    if (i % 3 == 0) {
+      auto ptr = q.take();
+      if (ptr != nullptr)
+        consume(ptr);
+    }
+  }
+  for (auto ptr = q.take(); ptr != nullptr; ptr = q.take())
+    consume(ptr);
+  for (auto& t : thieves)
+    t.join();
+  CAF_CHECK_EQUAL(consumed.load(), num_jobs);
+  auto consumed_once = std::count_if(taken.begin(), taken.end(),
+                                     [](const std::atomic<int>& x) {
+                                       return x == 1;
+                                     });
+  CAF_CHECK_EQUAL(static_cast<size_t>(consumed_once), num_jobs);
+}
+
+CAF_TEST(lock_free_work_stealing_policy) {
+  static constexpr int num_actors = 100;
+  static constexpr int num_msgs = 100;
+  config cfg;
+  actor_system system{cfg};
+  scoped_actor self{system};
+  std::vector<actor> testees;
+  for (int i = 0; i < num_actors; ++i)
+    testees.push_back(system.spawn(counter, num_msgs, actor{self}));
+  for (int i = 0; i < num_msgs; ++i)
+    for (auto& testee : testees)
+      self->send(testee, i);
+  int received = 0;
+  self->receive_for(received, num_actors) (
+    [](ok_atom) {
+      // nop
+    }
+  );
+  CAF_CHECK_EQUAL(received, num_actors);
+}
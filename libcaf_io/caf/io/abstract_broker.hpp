@@ -150,6 +150,10 @@ public:
   /// Writes `data` into the buffer for given connection.
   void write(connection_handle hdl, size_t bs, const void* buf);
 
+  /// Appends `x` to the output of given connection. Backends with
+  /// scatter/gather I/O send the chunk without copying its content.
+  void write(connection_handle hdl, const byte_chunk& x);
+
   /// Sends the content of the buffer for given connection.
   void flush(connection_handle hdl);
 
@@ -109,6 +109,9 @@ public:
   /// the payload for a BASP message.
   using payload_writer = callback<serializer&>;
 
+  /// Describes a function object that sends byte chunks without copying them.
+  using chunk_writer = callback<const byte_chunk&>;
+
   /// Describes a callback function object for `remove_published_actor`.
   using removed_published_actor = callback<const strong_actor_ptr&, uint16_t>;
 
@@ -134,6 +137,8 @@ public:
 
   /// Sends a BASP message and implicitly flushes the output buffer of `r`.
   /// This function will update `hdr.payload_len` if a payload was written.
+  /// Byte chunks in the payload with at least `middleman_zero_copy_threshold`
+  /// bytes bypass the output buffer and go out without copying them.
   void write(execution_unit* ctx, const routing_table::route& r,
              header& hdr, payload_writer* writer = nullptr);
 
@@ -180,9 +185,10 @@ public:
     return published_actors_;
   }
 
-  /// Writes a header followed by its payload to `storage`.
+  /// Writes a header followed by its payload to `storage`. Passes byte
+  /// chunks to `cw` instead of copying them if `cw != nullptr`.
   void write(execution_unit* ctx, buffer_type& buf, header& hdr,
-             payload_writer* pw = nullptr);
+             payload_writer* pw = nullptr, chunk_writer* cw = nullptr);
 
   /// Writes the server handshake containing the information of the
   /// actor published at `port` to `buf`. If `port == none` or
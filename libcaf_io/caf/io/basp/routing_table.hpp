@@ -73,6 +73,10 @@ public:
   /// Flush output buffer for `r`.
   void flush(const route& r);
 
+  /// Appends `x` to the output of `r` without copying it
+  /// if the network backend supports scatter/gather I/O.
+  void write(const route& r, const byte_chunk& x);
+
   /// Adds a new direct route to the table.
   /// @pre `hdl != invalid_connection_handle && nid != none`
   void add_direct(const connection_handle& hdl, const node_id& nid);
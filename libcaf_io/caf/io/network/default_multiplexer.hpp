@@ -28,6 +28,7 @@
 
 #include "caf/config.hpp"
 #include "caf/extend.hpp"
+#include "caf/byte_chunk.hpp"
 #include "caf/ref_counted.hpp"
 
 #include "caf/io/fwd.hpp"
@@ -388,6 +389,10 @@ public:
   /// interface to `std::vector`.
   using buffer_type = std::vector<char>;
 
+  /// Chunks that go out between the bytes of the write buffer, each stored
+  /// along with the buffer offset it precedes.
+  using chunk_list = std::vector<std::pair<size_t, byte_chunk>>;
+
   stream(default_multiplexer& backend_ref, native_socket sockfd);
 
   /// Starts reading data from the socket, forwarding incoming data to `mgr`.
@@ -407,6 +412,11 @@ public:
   /// @warning Not thread safe.
   void write(const void* buf, size_t num_bytes);
 
+  /// Appends `x` to the output without copying its content. The chunk goes
+  /// out after all bytes currently stored in the write buffer.
+  /// @warning Not thread safe.
+  void write(const byte_chunk& x);
+
   /// Returns the write buffer of this stream.
   /// @warning Must not be modified outside the IO multiplexers event loop
   ///          once the stream has been started.
@@ -440,6 +450,15 @@ private:
 
   void prepare_next_write();
 
+  // writes the pending bytes of `wr_buf_` and `wr_chunks_` in one system call
+  bool write_chunks(size_t& result);
+
+  // returns the number of bytes in `wr_buf_` and `wr_chunks_`
+  size_t wr_size() const;
+
+  // returns the number of bytes in `wr_offline_buf_` and `wr_offline_chunks_`
+  size_t wr_offline_size() const;
+
   // state for reading
   manager_ptr reader_;
   size_t read_threshold_;
@@ -455,6 +474,8 @@ private:
   size_t written_;
   buffer_type wr_buf_;
   buffer_type wr_offline_buf_;
+  chunk_list wr_chunks_;
+  chunk_list wr_offline_chunks_;
 };
 
 /// An acceptor is responsible for accepting incoming connections.
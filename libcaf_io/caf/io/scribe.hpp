@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "caf/message.hpp"
+#include "caf/byte_chunk.hpp"
 
 #include "caf/io/broker_servant.hpp"
 #include "caf/io/receive_policy.hpp"
@@ -55,6 +56,11 @@ public:
   /// Returns the current input buffer.
   virtual std::vector<char>& rd_buf() = 0;
 
+  /// Appends `x` to the output buffer. The default implementation copies
+  /// `x` into `wr_buf()`. Backends with scatter/gather I/O override this
+  /// member function to send the chunk without copying it.
+  virtual void write(const byte_chunk& x);
+
   /// Flushes the output buffer, i.e., sends the
   /// content of the buffer via the network.
   virtual void flush() = 0;
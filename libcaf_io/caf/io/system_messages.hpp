@@ -51,7 +51,9 @@ typename Inspector::result_type inspect(Inspector& f, new_connection_msg& x) {
 struct new_data_msg {
   /// Handle to the related connection.
   connection_handle handle;
-  /// Buffer containing the received data.
+  /// Buffer containing the received data. Brokers can move the buffer into
+  /// a `byte_chunk` for passing the data on without copying it, in which
+  /// case the scribe allocates a new buffer for the next read.
   std::vector<char> buf;
 };
 
@@ -103,6 +103,15 @@ void abstract_broker::write(connection_handle hdl, size_t bs, const void* buf) {
   out.insert(out.end(), first, last);
 }
 
+void abstract_broker::write(connection_handle hdl, const byte_chunk& x) {
+  auto ptr = by_id(hdl);
+  if (!ptr) {
+    CAF_LOG_ERROR("tried to write to an unknown connection_handle");
+    return;
+  }
+  ptr->write(x);
+}
+
 void abstract_broker::flush(connection_handle hdl) {
   auto x = by_id(hdl);
   if (x)
@@ -41,6 +41,7 @@
 # include <cerrno>
 # include <netdb.h>
 # include <fcntl.h>
+# include <sys/uio.h>
 # include <sys/types.h>
 # include <arpa/inet.h>
 # include <sys/socket.h>
@@ -758,6 +759,9 @@ connection_handle default_multiplexer::add_tcp_scribe(abstract_broker* self,
     std::vector<char>& rd_buf() override {
       return stream_.rd_buf();
     }
+    void write(const byte_chunk& x) override {
+      stream_.write(x);
+    }
     void stop_reading() override {
       CAF_LOG_TRACE("");
       stream_.stop_reading();
@@ -1103,10 +1107,23 @@ void stream::write(const void* buf, size_t num_bytes) {
   wr_offline_buf_.insert(wr_offline_buf_.end(), first, last);
 }
 
+void stream::write(const byte_chunk& x) {
+  CAF_LOG_TRACE(CAF_ARG(x.size()));
+# ifdef CAF_WINDOWS
+  // no scatter/gather output available, fall back to copying
+  write(x.data(), x.size());
+# else
+  if (!x.empty())
+    wr_offline_chunks_.emplace_back(wr_offline_buf_.size(), x);
+# endif
+}
+
 void stream::flush(const manager_ptr& mgr) {
   CAF_ASSERT(mgr != nullptr);
-  CAF_LOG_TRACE(CAF_ARG(wr_offline_buf_.size()));
-  if (!wr_offline_buf_.empty() && !writing_) {
+  CAF_LOG_TRACE(CAF_ARG(wr_offline_buf_.size())
+                << CAF_ARG(wr_offline_chunks_.size()));
+  if ((!wr_offline_buf_.empty() || !wr_offline_chunks_.empty())
+      && !writing_) {
     backend().add(operation::write, fd(), this);
     writer_ = mgr;
     writing_ = true;
@@ -1160,18 +1177,21 @@ void stream::handle_event(operation op) {
     }
     case operation::write: {
       size_t wb; // written bytes
-      if (!write_some(wb, fd(),
-                       wr_buf_.data() + written_,
-                       wr_buf_.size() - written_)) {
+      auto success = wr_chunks_.empty()
+                     ? write_some(wb, fd(), wr_buf_.data() + written_,
+                                  wr_buf_.size() - written_)
+                     : write_chunks(wb);
+      if (!success) {
         writer_->io_failure(&backend(), operation::write);
         backend().del(operation::write, fd(), this);
       } else if (wb > 0) {
         written_ += wb;
-        CAF_ASSERT(written_ <= wr_buf_.size());
-        auto remaining = wr_buf_.size() - written_;
+        auto total = wr_size();
+        CAF_ASSERT(written_ <= total);
+        auto remaining = total - written_;
         if (ack_writes_)
           writer_->data_transferred(&backend(), wb,
-                                    remaining + wr_offline_buf_.size());
+                                    remaining + wr_offline_size());
         // prepare next send (or stop sending)
         if (remaining == 0)
           prepare_next_write();
@@ -1217,14 +1237,76 @@ void stream::prepare_next_write() {
   CAF_LOG_TRACE(CAF_ARG(wr_buf_.size()) << CAF_ARG(wr_offline_buf_.size()));
   written_ = 0;
   wr_buf_.clear();
-  if (wr_offline_buf_.empty()) {
+  wr_chunks_.clear();
+  if (wr_offline_buf_.empty() && wr_offline_chunks_.empty()) {
     writing_ = false;
     backend().del(operation::write, fd(), this);
   } else {
     wr_buf_.swap(wr_offline_buf_);
+    wr_chunks_.swap(wr_offline_chunks_);
   }
 }
 
+bool stream::write_chunks(size_t& result) {
+# ifdef CAF_WINDOWS
+  // stream::write(const byte_chunk&) never adds chunks on Windows
+  return write_some(result, fd(), wr_buf_.data() + written_,
+                    wr_buf_.size() - written_);
+# else
+  // collect up to `max_iov` segments, skipping everything before `written_`
+  static constexpr size_t max_iov = 64;
+  iovec iov[max_iov];
+  size_t n = 0;
+  size_t pos = 0;    // logical position in the output
+  size_t offset = 0; // position in `wr_buf_`
+  auto add = [&](const char* data, size_t len) {
+    if (pos + len > written_) {
+      auto skip = written_ > pos ? written_ - pos : 0;
+      iov[n].iov_base = const_cast<char*>(data + skip);
+      iov[n].iov_len = len - skip;
+      ++n;
+    }
+    pos += len;
+  };
+  for (auto i = wr_chunks_.begin(); i != wr_chunks_.end() && n < max_iov; ++i) {
+    auto first = std::min(i->first, wr_buf_.size());
+    if (first > offset) {
+      add(wr_buf_.data() + offset, first - offset);
+      offset = first;
+    }
+    if (n < max_iov)
+      add(i->second.data(), i->second.size());
+  }
+  if (n < max_iov && offset < wr_buf_.size())
+    add(wr_buf_.data() + offset, wr_buf_.size() - offset);
+  CAF_LOG_TRACE(CAF_ARG(written_) << CAF_ARG(n));
+  msghdr hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.msg_iov = iov;
+  hdr.msg_iovlen = static_cast<decltype(hdr.msg_iovlen)>(n);
+  auto sres = ::sendmsg(fd(), &hdr, no_sigpipe_flag);
+  CAF_LOG_DEBUG(CAF_ARG(fd()) << CAF_ARG(sres));
+  if (is_error(sres, true))
+    return false;
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  return true;
+# endif
+}
+
+size_t stream::wr_size() const {
+  auto result = wr_buf_.size();
+  for (auto& x : wr_chunks_)
+    result += x.second.size();
+  return result;
+}
+
+size_t stream::wr_offline_size() const {
+  auto result = wr_offline_buf_.size();
+  for (auto& x : wr_offline_chunks_)
+    result += x.second.size();
+  return result;
+}
+
 acceptor::acceptor(default_multiplexer& backend_ref, native_socket sockfd)
     : event_handler(backend_ref, sockfd),
       sock_(invalid_native_socket) {
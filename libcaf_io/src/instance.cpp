@@ -285,7 +285,11 @@ void instance::write(execution_unit* ctx, const routing_table::route& r,
                      header& hdr, payload_writer* writer) {
   CAF_LOG_TRACE(CAF_ARG(hdr));
   CAF_ASSERT(hdr.payload_len == 0 || writer != nullptr);
-  write(ctx, r.wr_buf, hdr, writer);
+  auto cw = make_callback([&](const byte_chunk& x) -> error {
+    tbl_.write(r, x);
+    return none;
+  });
+  write(ctx, r.wr_buf, hdr, writer, &cw);
   tbl_.flush(r);
 }
 
@@ -361,14 +365,13 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
   header hdr{message_type::dispatch_message, 0, 0, mid.integer_value(),
              sender ? sender->node() : this_node(), receiver->node(),
              sender ? sender->id() : invalid_actor_id, receiver->id()};
-  write(ctx, path->wr_buf, hdr, &writer);
-  flush(*path);
+  write(ctx, *path, hdr, &writer);
   notify<hook::message_sent>(sender, path->next_hop, receiver, mid, msg);
   return true;
 }
 
 void instance::write(execution_unit* ctx, buffer_type& buf,
-                     header& hdr, payload_writer* pw) {
+                     header& hdr, payload_writer* pw, chunk_writer* cw) {
   CAF_LOG_TRACE(CAF_ARG(hdr));
   error err;
   if (pw != nullptr) {
@@ -377,8 +380,17 @@ void instance::write(execution_unit* ctx, buffer_type& buf,
     char placeholder[basp::header_size];
     buf.insert(buf.end(), std::begin(placeholder), std::end(placeholder));
     binary_serializer bs{ctx, buf};
+    // chunks passed to `cw` are part of the payload but not of `buf`
+    size_t deferred = 0;
+    auto counting_cw = make_callback([&](const byte_chunk& x) -> error {
+      deferred += x.size();
+      return (*cw)(x);
+    });
+    auto threshold = system().config().middleman_zero_copy_threshold;
+    if (cw != nullptr && threshold > 0)
+      bs.set_chunk_writer(&counting_cw, threshold);
     (*pw)(bs);
-    auto plen = buf.size() - pos - basp::header_size;
+    auto plen = buf.size() - pos - basp::header_size + deferred;
     CAF_ASSERT(plen <= std::numeric_limits<uint32_t>::max());
     hdr.payload_len = static_cast<uint32_t>(plen);
     stream_serializer<charbuf> out{ctx, buf.data() + pos, basp::header_size};
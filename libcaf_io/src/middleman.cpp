@@ -51,6 +51,8 @@
 #include "caf/detail/ripemd_160.hpp"
 #include "caf/detail/safe_equal.hpp"
 #include "caf/detail/get_root_uuid.hpp"
+#include "caf/detail/set_thread_name.hpp"
+#include "caf/detail/set_thread_affinity.hpp"
 #include "caf/actor_registry.hpp"
 #include "caf/detail/get_mac_addresses.hpp"
 
@@ -262,6 +264,8 @@ void middleman::start() {
     backend().thread_id(std::this_thread::get_id());
   } else {
     thread_ = std::thread{[this] {
+      detail::set_thread_name("caf.multiplexer");
+      detail::set_thread_affinity(system().config().middleman_multiplexer_cpus);
       CAF_SET_LOGGER_SYS(&system());
       CAF_LOG_TRACE("");
       backend().run();
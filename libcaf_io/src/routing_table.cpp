@@ -56,6 +56,10 @@ void routing_table::flush(const route& r) {
   parent_->flush(r.hdl);
 }
 
+void routing_table::write(const route& r, const byte_chunk& x) {
+  parent_->write(r.hdl, x);
+}
+
 node_id routing_table::lookup_direct(const connection_handle& hdl) const {
   return get_opt(direct_by_hdl_, hdl, none);
 }
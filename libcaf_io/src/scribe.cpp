@@ -33,6 +33,11 @@ scribe::~scribe() {
   CAF_LOG_TRACE("");
 }
 
+void scribe::write(const byte_chunk& x) {
+  auto& buf = wr_buf();
+  buf.insert(buf.end(), x.begin(), x.end());
+}
+
 message scribe::detach_message() {
   return make_message(connection_closed_msg{hdl()});
 }
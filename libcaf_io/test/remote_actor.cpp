@@ -134,6 +134,24 @@ behavior linking_actor(event_based_actor* self, const actor& buddy) {
   };
 }
 
+behavior make_chunk_mirror_behavior() {
+  return {
+    [](const byte_chunk& x) {
+      return x.slice(x.size() / 2);
+    },
+    [](const byte_chunk& x, const std::string& str, const byte_chunk& y) {
+      return make_message(y, str, x);
+    }
+  };
+}
+
+byte_chunk make_chunk(size_t size) {
+  std::vector<char> buf(size);
+  for (size_t i = 0; i < size; ++i)
+    buf[i] = static_cast<char>(i % 251);
+  return byte_chunk{std::move(buf)};
+}
+
 } // namespace <anonymous>
 
 CAF_TEST_FIXTURE_SCOPE(dynamic_remote_actor_tests, fixture)
@@ -173,6 +191,37 @@ CAF_TEST(custom_message_type) {
   client_side.spawn(make_sort_requester_behavior, sorter);
 }
 
+CAF_TEST(byte_chunks) {
+  // server side
+  auto mirror = server_side.spawn(make_chunk_mirror_behavior);
+  CAF_EXP_THROW(port, server_side_mm.publish(mirror, 0, local_host));
+  // client side
+  CAF_EXP_THROW(remote_mirror, client_side_mm.remote_actor(local_host, port));
+  scoped_actor self{client_side};
+  auto large = make_chunk(256 * 1024);
+  self->request(remote_mirror, infinite, large).receive(
+    [&](const byte_chunk& x) {
+      CAF_CHECK_EQUAL(x, large.slice(large.size() / 2));
+    },
+    [&](error& err) {
+      CAF_FAIL("unexpected error: " << client_side.render(err));
+    }
+  );
+  // large chunks surrounded by regular data
+  auto small = byte_chunk::copy("small", 5);
+  self->request(remote_mirror, infinite, small, "mixed", large).receive(
+    [&](const byte_chunk& x, const std::string& str, const byte_chunk& y) {
+      CAF_CHECK_EQUAL(x, large);
+      CAF_CHECK_EQUAL(str, "mixed");
+      CAF_CHECK_EQUAL(y, small);
+    },
+    [&](error& err) {
+      CAF_FAIL("unexpected error: " << client_side.render(err));
+    }
+  );
+  anon_send_exit(mirror, exit_reason::user_shutdown);
+}
+
 CAF_TEST(remote_link) {
   // server side
   CAF_EXP_THROW(port, server_side_mm.publish(server_side.spawn(fragile_mirror),